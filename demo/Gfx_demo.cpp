@@ -25,12 +25,15 @@ struct Imgui_info {
 
 //----------------------------------------------------------------------------------------------------------------------
 
-struct Matrix_info {
-    mat4 model;
+struct Camera_info {
     mat4 view;
     mat4 projection;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Object_info {
     mat4 mv;
-    mat4 mvp;
     mat4 normal;
 };
 
@@ -80,8 +83,7 @@ Gfx_demo::~Gfx_demo()
 void Gfx_demo::connect(Platform_lib::Window* window)
 {
     init_swap_chain_(window);
-    init_cmd_buffer_();
-    init_fence_();
+    init_frame_context_();
     init_imgui_();
     init_imgui_resources_();
 }
@@ -90,18 +92,12 @@ void Gfx_demo::connect(Platform_lib::Window* window)
 
 void Gfx_demo::render()
 {
-    if (!fence_->signaled())
-        fence_->wait_signal();
-
-    fence_->reset();
-    cmd_buffer_->reset();
+    frame_context_->begin_frame();
 
     record_light_render_pass_();
     record_present_render_pass_();
 
-    cmd_buffer_->end();
-
-    device_->submit(cmd_buffer_.get(), fence_.get());
+    frame_context_->end_frame();
     swap_chain_->present();
 }
 
@@ -278,39 +274,6 @@ void Gfx_demo::init_light_resources_()
         throw runtime_error("fail to create gfx demo");
     }
 
-    try {
-        Buffer_desc buffer_desc;
-
-        buffer_desc.size = align_pow2(sizeof(Matrix_info), 256) * 7;
-
-        buffers_["matrix_info"] = device_->create(buffer_desc);
-    }
-    catch (exception& e) {
-        throw runtime_error("fail to create gfx demo");
-    }
-
-    try {
-        Buffer_desc buffer_desc;
-
-        buffer_desc.size = sizeof(Light_info);
-
-        buffers_["light_info"] = device_->create(buffer_desc);
-    }
-    catch (exception& e) {
-        throw runtime_error("fail to create gfx demo");
-    }
-
-    try {
-        Buffer_desc buffer_desc;
-
-        buffer_desc.size = align_pow2(sizeof(Material_info), 256) * 7;
-
-        buffers_["material_info"] = device_->create(buffer_desc);
-    }
-    catch (exception& e) {
-        throw runtime_error("fail to create gfx demo");
-    }
-
     try {
         Image_desc image_desc;
 
@@ -378,6 +341,7 @@ void Gfx_demo::init_light_resources_()
         pipeline_desc.fragment_shader = shaders[1].get();
         pipeline_desc.output_merger.color_formats[0] = Format::rgba8_unorm;
         pipeline_desc.output_merger.depth_stencil_format = Format::d24_unorm_s8_uint;
+        pipeline_desc.push_constant_size = sizeof(Object_info);
 
         pipelines_["lamp"] = device_->create(pipeline_desc);
 
@@ -418,6 +382,7 @@ void Gfx_demo::init_light_resources_()
         pipeline_desc.fragment_shader = shaders[1].get();
         pipeline_desc.output_merger.color_formats[0] = Format::rgba8_unorm;
         pipeline_desc.output_merger.depth_stencil_format = Format::d24_unorm_s8_uint;
+        pipeline_desc.push_constant_size = sizeof(Object_info);
 
         pipelines_["flat"] = device_->create(pipeline_desc);
 
@@ -458,6 +423,7 @@ void Gfx_demo::init_light_resources_()
         pipeline_desc.fragment_shader = shaders[1].get();
         pipeline_desc.output_merger.color_formats[0] = Format::rgba8_unorm;
         pipeline_desc.output_merger.depth_stencil_format = Format::d24_unorm_s8_uint;
+        pipeline_desc.push_constant_size = sizeof(Object_info);
 
         pipelines_["gouraud"] = device_->create(pipeline_desc);
 
@@ -498,6 +464,7 @@ void Gfx_demo::init_light_resources_()
         pipeline_desc.fragment_shader = shaders[1].get();
         pipeline_desc.output_merger.color_formats[0] = Format::rgba8_unorm;
         pipeline_desc.output_merger.depth_stencil_format = Format::d24_unorm_s8_uint;
+        pipeline_desc.push_constant_size = sizeof(Object_info);
 
         pipelines_["phong"] = device_->create(pipeline_desc);
     }
@@ -510,7 +477,9 @@ void Gfx_demo::init_light_resources_()
 
 void Gfx_demo::record_light_render_pass_()
 {
-    auto light_info = reinterpret_cast<Light_info*>(buffers_["light_info"]->map());
+    // uniforms change every frame, so they are written to transient memory of the current frame.
+    auto light_allocation = frame_context_->allocate(sizeof(Light_info));
+    auto light_info = static_cast<Light_info*>(light_allocation.data);
 
     light_info->translation = {cfgs_.light.translation, 1.0};
     light_info->ambient = {cfgs_.light.ambient, 1.0};
@@ -523,133 +492,121 @@ void Gfx_demo::record_light_render_pass_()
                                   cfgs_.camera.aspect,
                                   cfgs_.camera.near, cfgs_.camera.far);
 
-    buffers_["light_info"]->unmap();
+    auto camera_allocation = frame_context_->allocate(sizeof(Camera_info));
+    auto camera_info = static_cast<Camera_info*>(camera_allocation.data);
+
+    camera_info->view = view;
+    camera_info->projection = projection;
+
+    // object infos are pushed at each draw, so they don't need to be stored in a buffer.
+    auto to_object_info = [&](const mat4& model) {
+        Object_info object_info;
+
+        object_info.mv = view * model;
+        object_info.normal = inverse(transpose(object_info.mv));
+
+        return object_info;
+    };
+
+    // update lamp object info.
+    auto lamp_model = translate(mat4 {1.0}, cfgs_.light.translation);
 
-    auto matrix_info_contents = static_cast<uint8_t*>(buffers_["matrix_info"]->map());
+    lamp_model = scale(lamp_model, {0.2f, 0.2f, 0.2f});
 
-    // update light matrix info.
-    auto lamp_matrix_info = reinterpret_cast<Matrix_info*>(matrix_info_contents);
+    auto lamp_object_info = to_object_info(lamp_model);
 
-    lamp_matrix_info->model = translate(mat4 {1.0}, cfgs_.light.translation);
-    lamp_matrix_info->model = scale(lamp_matrix_info->model, {0.2f, 0.2f, 0.2f});
-    lamp_matrix_info->view = view;
-    lamp_matrix_info->projection = projection;
-    lamp_matrix_info->mv = view * lamp_matrix_info->model;
-    lamp_matrix_info->mvp = projection * lamp_matrix_info->mv;
-    lamp_matrix_info->normal = inverse(transpose(lamp_matrix_info->mv));
+    auto bottom_plane_model = translate(mat4 {1.0}, {0.0f, -1.0f, 0.0f});
 
-    auto bottom_plane_matrix_info = reinterpret_cast<Matrix_info*>(matrix_info_contents + 512 * 2);
+    bottom_plane_model = rotate(bottom_plane_model, radians(-90.0f), {1.0f, 0.0f, 0.0f});
+    bottom_plane_model = scale(bottom_plane_model, {10.0f, 10.0f, 1.0f});
 
-    bottom_plane_matrix_info->model = translate(mat4 {1.0}, {0.0f, -1.0f, 0.0f});
-    bottom_plane_matrix_info->model = rotate(bottom_plane_matrix_info->model, radians(-90.0f), {1.0f, 0.0f, 0.0f});
-    bottom_plane_matrix_info->model = scale(bottom_plane_matrix_info->model, {10.0f, 10.0f, 1.0f});
-    bottom_plane_matrix_info->view = view;
-    bottom_plane_matrix_info->projection = projection;
-    bottom_plane_matrix_info->mv = view * bottom_plane_matrix_info->model;
-    bottom_plane_matrix_info->mvp = projection * bottom_plane_matrix_info->mv;
-    bottom_plane_matrix_info->normal = inverse(transpose(bottom_plane_matrix_info->mv));
+    auto bottom_plane_object_info = to_object_info(bottom_plane_model);
 
-    auto far_plane_matrix_info = reinterpret_cast<Matrix_info*>(matrix_info_contents + 512 * 3);
+    auto far_plane_model = translate(mat4 {1.0}, {0.0f, 4.0f, -5.0f});
 
-    far_plane_matrix_info->model = translate(mat4 {1.0}, {0.0f, 4.0f, -5.0f});
-    far_plane_matrix_info->model = scale(far_plane_matrix_info->model, {10.0f, 10.0f, 1.0f});
-    far_plane_matrix_info->view = view;
-    far_plane_matrix_info->projection = projection;
-    far_plane_matrix_info->mv = view * far_plane_matrix_info->model;
-    far_plane_matrix_info->mvp = projection * far_plane_matrix_info->mv;
-    far_plane_matrix_info->normal = inverse(transpose(far_plane_matrix_info->mv));
+    far_plane_model = scale(far_plane_model, {10.0f, 10.0f, 1.0f});
 
-    // update cube matrix info.
-    auto cube_matrix_info = reinterpret_cast<Matrix_info*>(matrix_info_contents + 512 * 4);
+    auto far_plane_object_info = to_object_info(far_plane_model);
 
+    // update cube object info.
     if (cfgs_.cube.animation)
         cfgs_.cube.rotation.z += 1.0f;
 
-    cube_matrix_info->model = translate(mat4 {1.0}, cfgs_.cube.translation);
-    cube_matrix_info->model = rotate(cube_matrix_info->model, radians(cfgs_.cube.rotation.x), {1.0f, 0.0f, 0.0f});
-    cube_matrix_info->model = rotate(cube_matrix_info->model, radians(cfgs_.cube.rotation.y), {0.0f, 1.0f, 0.0f});
-    cube_matrix_info->model = rotate(cube_matrix_info->model, radians(cfgs_.cube.rotation.z), {0.0f, 0.0f, 1.0f});
-    cube_matrix_info->model = scale(cube_matrix_info->model, cfgs_.cube.scale);
-    cube_matrix_info->view = view;
-    cube_matrix_info->projection = projection;
-    cube_matrix_info->mv = view * cube_matrix_info->model;
-    cube_matrix_info->mvp = projection * cube_matrix_info->mv;
-    cube_matrix_info->normal = inverse(transpose(cube_matrix_info->mv));
+    auto cube_model = translate(mat4 {1.0}, cfgs_.cube.translation);
 
-    // update torus matrix info.
-    auto torus_matrix_info = reinterpret_cast<Matrix_info*>(matrix_info_contents + 512 * 5);
+    cube_model = rotate(cube_model, radians(cfgs_.cube.rotation.x), {1.0f, 0.0f, 0.0f});
+    cube_model = rotate(cube_model, radians(cfgs_.cube.rotation.y), {0.0f, 1.0f, 0.0f});
+    cube_model = rotate(cube_model, radians(cfgs_.cube.rotation.z), {0.0f, 0.0f, 1.0f});
+    cube_model = scale(cube_model, cfgs_.cube.scale);
 
+    auto cube_object_info = to_object_info(cube_model);
+
+    // update torus object info.
     if (cfgs_.torus.animation)
         cfgs_.torus.rotation.y += 1.0f;
 
-    torus_matrix_info->model = translate(mat4 {1.0}, cfgs_.torus.translation);
-    torus_matrix_info->model = rotate(torus_matrix_info->model, radians(cfgs_.torus.rotation.x), {1.0f, 0.0f, 0.0f});
-    torus_matrix_info->model = rotate(torus_matrix_info->model, radians(cfgs_.torus.rotation.y), {0.0f, 1.0f, 0.0f});
-    torus_matrix_info->model = rotate(torus_matrix_info->model, radians(cfgs_.torus.rotation.z), {0.0f, 0.0f, 1.0f});
-    torus_matrix_info->model = scale(torus_matrix_info->model, cfgs_.torus.scale);
-    torus_matrix_info->view = view;
-    torus_matrix_info->projection = projection;
-    torus_matrix_info->mv = view * torus_matrix_info->model;
-    torus_matrix_info->mvp = projection * torus_matrix_info->mv;
-    torus_matrix_info->normal = inverse(transpose(torus_matrix_info->mv));
+    auto torus_model = translate(mat4 {1.0}, cfgs_.torus.translation);
+
+    torus_model = rotate(torus_model, radians(cfgs_.torus.rotation.x), {1.0f, 0.0f, 0.0f});
+    torus_model = rotate(torus_model, radians(cfgs_.torus.rotation.y), {0.0f, 1.0f, 0.0f});
+    torus_model = rotate(torus_model, radians(cfgs_.torus.rotation.z), {0.0f, 0.0f, 1.0f});
+    torus_model = scale(torus_model, cfgs_.torus.scale);
 
-    // update torus matrix info.
-    auto sphere_matrix_info = reinterpret_cast<Matrix_info*>(matrix_info_contents + 512 * 6);
+    auto torus_object_info = to_object_info(torus_model);
 
+    // update sphere object info.
     if (cfgs_.sphere.animation)
         cfgs_.sphere.rotation.z += 1.0f;
 
-    sphere_matrix_info->model = translate(mat4 {1.0}, cfgs_.sphere.translation);
-    sphere_matrix_info->model = rotate(sphere_matrix_info->model, radians(cfgs_.sphere.rotation.x), {1.0f, 0.0f, 0.0f});
-    sphere_matrix_info->model = rotate(sphere_matrix_info->model, radians(cfgs_.sphere.rotation.y), {0.0f, 1.0f, 0.0f});
-    sphere_matrix_info->model = rotate(sphere_matrix_info->model, radians(cfgs_.sphere.rotation.z), {0.0f, 0.0f, 1.0f});
-    sphere_matrix_info->model = scale(sphere_matrix_info->model, cfgs_.sphere.scale);
-    sphere_matrix_info->view = view;
-    sphere_matrix_info->projection = projection;
-    sphere_matrix_info->mv = view * sphere_matrix_info->model;
-    sphere_matrix_info->mvp = projection * sphere_matrix_info->mv;
-    sphere_matrix_info->normal = inverse(transpose(sphere_matrix_info->mv));
+    auto sphere_model = translate(mat4 {1.0}, cfgs_.sphere.translation);
+
+    sphere_model = rotate(sphere_model, radians(cfgs_.sphere.rotation.x), {1.0f, 0.0f, 0.0f});
+    sphere_model = rotate(sphere_model, radians(cfgs_.sphere.rotation.y), {0.0f, 1.0f, 0.0f});
+    sphere_model = rotate(sphere_model, radians(cfgs_.sphere.rotation.z), {0.0f, 0.0f, 1.0f});
+    sphere_model = scale(sphere_model, cfgs_.sphere.scale);
 
-    buffers_["matrix_info"]->unmap();
+    auto sphere_object_info = to_object_info(sphere_model);
 
-    auto material_info_contents = reinterpret_cast<uint8_t*>(buffers_["material_info"]->map());
-    auto bottom_plane_material_info = reinterpret_cast<Material_info*>(material_info_contents + 256 * 2);
+    auto bottom_plane_material_allocation = frame_context_->allocate(sizeof(Material_info));
+    auto bottom_plane_material_info = static_cast<Material_info*>(bottom_plane_material_allocation.data);
 
     bottom_plane_material_info->ambient = {0.2125f, 0.1275f, 0.054f, 0.0f};
     bottom_plane_material_info->diffuse = {0.714f, 0.4284f, 0.18144f, 0.0f};
     bottom_plane_material_info->specular = {0.393548f, 0.271906f, 0.166721f};
     bottom_plane_material_info->shininess = 0.25f * 128.0f;
 
-    auto far_plane_material_info = reinterpret_cast<Material_info*>(material_info_contents + 256 * 3);
+    auto far_plane_material_allocation = frame_context_->allocate(sizeof(Material_info));
+    auto far_plane_material_info = static_cast<Material_info*>(far_plane_material_allocation.data);
 
     far_plane_material_info->ambient = {0.2125f, 0.1275f, 0.054f, 0.0f};
     far_plane_material_info->diffuse = {0.714f, 0.4284f, 0.18144f, 0.0f};
     far_plane_material_info->specular = {0.393548f, 0.271906f, 0.166721f};
     far_plane_material_info->shininess = 0.25f * 128.0f;
 
-    auto cube_material_info = reinterpret_cast<Material_info*>(material_info_contents + 256 * 4);
+    auto cube_material_allocation = frame_context_->allocate(sizeof(Material_info));
+    auto cube_material_info = static_cast<Material_info*>(cube_material_allocation.data);
 
     cube_material_info->ambient = {cfgs_.cube.ambient, 0.0};
     cube_material_info->diffuse = {cfgs_.cube.diffuse, 0.0};
     cube_material_info->specular = cfgs_.cube.specular;
     cube_material_info->shininess = cfgs_.cube.shininess;
 
-    auto torus_material_info = reinterpret_cast<Material_info*>(material_info_contents + 256 * 5);
+    auto torus_material_allocation = frame_context_->allocate(sizeof(Material_info));
+    auto torus_material_info = static_cast<Material_info*>(torus_material_allocation.data);
 
     torus_material_info->ambient = {cfgs_.torus.ambient, 0.0};
     torus_material_info->diffuse = {cfgs_.torus.diffuse, 0.0};
     torus_material_info->specular = cfgs_.torus.specular;
     torus_material_info->shininess = cfgs_.torus.shininess;
 
-    auto sphere_material_info = reinterpret_cast<Material_info*>(material_info_contents + 256 * 6);
+    auto sphere_material_allocation = frame_context_->allocate(sizeof(Material_info));
+    auto sphere_material_info = static_cast<Material_info*>(sphere_material_allocation.data);
 
     sphere_material_info->ambient = {cfgs_.sphere.ambient, 0.0};
     sphere_material_info->diffuse = {cfgs_.sphere.diffuse, 0.0};
     sphere_material_info->specular = cfgs_.sphere.specular;
     sphere_material_info->shininess = cfgs_.sphere.shininess;
 
-    buffers_["material_info"]->unmap();
-
     Render_encoder_desc render_encoder_desc;
 
     render_encoder_desc.colors[0].image = images_["light_color"].get();
@@ -677,51 +634,42 @@ void Gfx_demo::record_light_render_pass_()
         }
     };
 
-    auto render_encoder = cmd_buffer_->create(render_encoder_desc);
-
-    render_encoder->vertex_buffer(buffers_["cube_vertex"].get(), 0, 0);
-    render_encoder->index_buffer(buffers_["cube_index"].get(), 0, Index_type::uint16);
-    render_encoder->shader_buffer(buffers_["matrix_info"].get(), 0, 0);
-    render_encoder->pipeline(pipelines_["lamp"].get());
-    render_encoder->draw_indexed(draw_counts_["cube"]);
-
-    render_encoder->vertex_buffer(buffers_["plane_vertex"].get(), 0, 0);
-    render_encoder->index_buffer(buffers_["plane_index"].get(), 0, Index_type::uint16);
-    render_encoder->shader_buffer(buffers_["matrix_info"].get(), 512 * 2, 0);
-    render_encoder->shader_buffer(buffers_["light_info"].get(), 0, 1);
-    render_encoder->shader_buffer(buffers_["material_info"].get(), 256 * 2, 2);
-    render_encoder->pipeline(pipelines_["phong"].get());
-    render_encoder->draw_indexed(draw_counts_["plane"]);
-
-    render_encoder->shader_buffer(buffers_["matrix_info"].get(), 512 * 3, 0);
-    render_encoder->shader_buffer(buffers_["light_info"].get(), 0, 1);
-    render_encoder->shader_buffer(buffers_["material_info"].get(), 256 * 3, 2);
-    render_encoder->draw_indexed(draw_counts_["plane"]);
-
-    render_encoder->vertex_buffer(buffers_["cube_vertex"].get(), 0, 0);
-    render_encoder->index_buffer(buffers_["cube_index"].get(), 0, Index_type::uint16);
-    render_encoder->shader_buffer(buffers_["matrix_info"].get(), 512 * 4, 0);
-    render_encoder->shader_buffer(buffers_["light_info"].get(), 0, 1);
-    render_encoder->shader_buffer(buffers_["material_info"].get(), 256 * 4, 2);
-    render_encoder->pipeline(pipeline(cfgs_.cube.style));
-    render_encoder->draw_indexed(draw_counts_["cube"]);
-
-    render_encoder->vertex_buffer(buffers_["torus_vertex"].get(), 0, 0);
-    render_encoder->index_buffer(buffers_["torus_index"].get(), 0, Index_type::uint16);
-    render_encoder->shader_buffer(buffers_["matrix_info"].get(), 512 * 5, 0);
-    render_encoder->shader_buffer(buffers_["light_info"].get(), 0, 1);
-    render_encoder->shader_buffer(buffers_["material_info"].get(), 256 * 5, 2);
-    render_encoder->pipeline(pipeline(cfgs_.torus.style));
-    render_encoder->draw_indexed(draw_counts_["torus"]);
-
-    render_encoder->vertex_buffer(buffers_["sphere_vertex"].get(), 0, 0);
-    render_encoder->index_buffer(buffers_["sphere_index"].get(), 0, Index_type::uint16);
-    render_encoder->shader_buffer(buffers_["matrix_info"].get(), 512 * 6, 0);
-    render_encoder->shader_buffer(buffers_["light_info"].get(), 0, 1);
-    render_encoder->shader_buffer(buffers_["material_info"].get(), 256 * 6, 2);
-    render_encoder->pipeline(pipeline(cfgs_.sphere.style));
-    render_encoder->draw_indexed(draw_counts_["sphere"]);
+    // draws are sorted by states, so a pipeline and buffers are only set when they change.
+    auto add_draw = [&](Pipeline* pipeline, const string& mesh, const Object_info& object_info,
+                        const Frame_allocation& material_allocation) {
+        Draw_item item;
+
+        item.pipeline = pipeline;
+        item.vertex_buffer = buffers_[mesh + "_vertex"].get();
+        item.index_buffer = buffers_[mesh + "_index"].get();
+        item.bytes = &object_info;
+        item.byte_size = sizeof(Object_info);
+        item.count = draw_counts_[mesh];
+        item.depth = glm::clamp(-object_info.mv[3][2] / cfgs_.camera.far, 0.0f, 1.0f);
+
+        if (material_allocation.buffer) {
+            item.shader_buffer = material_allocation.buffer;
+            item.shader_buffer_offset = material_allocation.offset;
+            item.shader_buffer_index = 2;
+        }
+
+        draw_queue_.add(item);
+    };
+
+    draw_queue_.clear();
+
+    add_draw(pipelines_["lamp"].get(), "cube", lamp_object_info, {});
+    add_draw(pipelines_["phong"].get(), "plane", bottom_plane_object_info, bottom_plane_material_allocation);
+    add_draw(pipelines_["phong"].get(), "plane", far_plane_object_info, far_plane_material_allocation);
+    add_draw(pipeline(cfgs_.cube.style), "cube", cube_object_info, cube_material_allocation);
+    add_draw(pipeline(cfgs_.torus.style), "torus", torus_object_info, torus_material_allocation);
+    add_draw(pipeline(cfgs_.sphere.style), "sphere", sphere_object_info, sphere_material_allocation);
+
+    auto render_encoder = frame_context_->cmd_buffer()->create(render_encoder_desc);
 
+    render_encoder->shader_buffer(camera_allocation.buffer, camera_allocation.offset, 0);
+    render_encoder->shader_buffer(light_allocation.buffer, light_allocation.offset, 1);
+    draw_queue_.encode(render_encoder);
     render_encoder->end();
 }
 
@@ -801,9 +749,16 @@ void Gfx_demo::record_present_render_pass_()
 
     auto draw_data = ImGui::GetDrawData();
 
+    Frame_allocation vertex_allocation;
+    Frame_allocation index_allocation;
+
     if (draw_data->CmdListsCount) {
-        auto vertex_data {static_cast<ImDrawVert*>(buffers_["imgui_vertex"]->map())};
-        auto index_data {static_cast<ImDrawIdx*>(buffers_["imgui_index"]->map())};
+        // geometry is rebuilt every frame, so it is written to transient memory of the current frame.
+        vertex_allocation = frame_context_->allocate(draw_data->TotalVtxCount * sizeof(ImDrawVert));
+        index_allocation = frame_context_->allocate(draw_data->TotalIdxCount * sizeof(ImDrawIdx));
+
+        auto vertex_data {static_cast<ImDrawVert*>(vertex_allocation.data)};
+        auto index_data {static_cast<ImDrawIdx*>(index_allocation.data)};
 
         for (auto i = 0; i != draw_data->CmdListsCount; ++i) {
             auto cmd_list = draw_data->CmdLists[i];
@@ -821,7 +776,7 @@ void Gfx_demo::record_present_render_pass_()
     desc.colors[0].image = swap_chain_->acquire();
     desc.colors[0].load_op = Load_op::dont_care;
 
-    auto render_encoder = cmd_buffer_->create(desc);
+    auto render_encoder = frame_context_->cmd_buffer()->create(desc);
 
     render_encoder->shader_texture(images_["light_color"].get(), samplers_["light_linear"].get(), 0);
     render_encoder->pipeline(pipelines_["composite"].get());
@@ -832,17 +787,18 @@ void Gfx_demo::record_present_render_pass_()
         render_encoder->shader_texture(images_["imgui_font"].get(), samplers_["light_linear"].get(), 0);
         render_encoder->pipeline(pipelines_["imgui"].get());
 
-        auto vertex_buffer_offset {0};
-        auto index_buffer_offset {0};
+        auto vertex_buffer_offset {vertex_allocation.offset};
+        auto index_buffer_offset {index_allocation.offset};
 
         for (auto i = 0; i != draw_data->CmdListsCount; ++i) {
-            render_encoder->vertex_buffer(buffers_["imgui_vertex"].get(), vertex_buffer_offset, 0);
-            render_encoder->index_buffer(buffers_["imgui_index"].get(), index_buffer_offset, Index_type::uint16);
+            render_encoder->vertex_buffer(vertex_allocation.buffer, vertex_buffer_offset, 0);
+            render_encoder->index_buffer(index_allocation.buffer, index_buffer_offset, Index_type::uint16);
 
             auto cmd_list = draw_data->CmdLists[i];
 
+            // a large list is split by imgui, commands of each split are offset by a base vertex.
             for (auto& cmd : cmd_list->CmdBuffer)
-                render_encoder->draw_indexed(cmd.ElemCount, cmd.IdxOffset);
+                render_encoder->draw_indexed(cmd.ElemCount, cmd.IdxOffset, 1, 0, cmd.VtxOffset);
 
             vertex_buffer_offset += cmd_list->VtxBuffer.Size * sizeof(ImDrawVert);
             index_buffer_offset += cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx);
@@ -877,22 +833,13 @@ void Gfx_demo::init_swap_chain_(Platform_lib::Window* window)
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Gfx_demo::init_cmd_buffer_()
+void Gfx_demo::init_frame_context_()
 {
-    try {
-        cmd_buffer_ = device_->create(Cmd_buffer_desc {});
-    }
-    catch(exception& e) {
-        throw runtime_error("fail to create a demo");
-    }
-}
-
-//----------------------------------------------------------------------------------------------------------------------
+    // dynamic data is written to transient memory, so frames in flight don't share it.
+    Frame_context_desc frame_context_desc {};
 
-void Gfx_demo::init_fence_()
-{
     try {
-        fence_ = device_->create(Fence_desc { true });
+        frame_context_ = make_unique<Frame_context>(frame_context_desc, device_.get());
     }
     catch(exception& e) {
         throw runtime_error("fail to create a demo");
@@ -919,28 +866,6 @@ void Gfx_demo::init_imgui_()
 
 void Gfx_demo::init_imgui_resources_()
 {
-    try {
-        Buffer_desc desc;
-
-        desc.size = 5 * 1024 * 1024;
-
-        buffers_["imgui_vertex"] = device_->create(desc);
-    }
-    catch (exception& e) {
-        throw runtime_error("fail to create gfx demo");
-    }
-
-    try {
-        Buffer_desc desc;
-
-        desc.size = 1024 * 1024;
-
-        buffers_["imgui_index"] = device_->create(desc);
-    }
-    catch (exception& e) {
-        throw runtime_error("fail to create gfx demo");
-    }
-
     try {
         auto& io = ImGui::GetIO();
 
@@ -11,6 +11,8 @@
 #include <platform/Window.h>
 #include <sc/Spirv_compiler.h>
 #include <gfx/Device.h>
+#include <gfx/Frame_context.h>
+#include <gfx/Draw_queue.h>
 
 //----------------------------------------------------------------------------------------------------------------------
 
@@ -83,9 +85,7 @@ private:
 
     void init_swap_chain_(Platform_lib::Window* window);
 
-    void init_cmd_buffer_();
-
-    void init_fence_();
+    void init_frame_context_();
 
     void init_imgui_();
 
@@ -107,8 +107,8 @@ private:
     std::unordered_map<std::string, std::unique_ptr<Gfx_lib::Sampler>> samplers_;
     std::unordered_map<std::string, std::unique_ptr<Gfx_lib::Pipeline>> pipelines_;
     std::unique_ptr<Gfx_lib::Swap_chain> swap_chain_;
-    std::unique_ptr<Gfx_lib::Cmd_buffer> cmd_buffer_;
-    std::unique_ptr<Gfx_lib::Fence> fence_;
+    std::unique_ptr<Gfx_lib::Frame_context> frame_context_;
+    Gfx_lib::Draw_queue draw_queue_;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
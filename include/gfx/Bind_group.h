@@ -0,0 +1,70 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_BIND_GROUP_GUARD
+#define GFX_BIND_GROUP_GUARD
+
+#include <cstdint>
+#include <vector>
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Device;
+class Buffer;
+class Image;
+class Sampler;
+class Pipeline;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Bind_group_entry final {
+    uint32_t index {0};
+    Buffer* buffer {nullptr};
+    Image* image {nullptr};
+    Sampler* sampler {nullptr};
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Bind_group_desc final {
+    Pipeline* pipeline {nullptr};
+    uint32_t index {0};
+    std::vector<Bind_group_entry> entries;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Bind_group {
+public:
+    explicit Bind_group(const Bind_group_desc& desc);
+
+    virtual ~Bind_group() = default;
+
+    virtual Device* device() const = 0;
+
+    inline auto index() const noexcept
+    { return index_; }
+
+    inline auto& entries() const noexcept
+    { return entries_; }
+
+    inline auto dynamic_offset_count() const noexcept
+    { return dynamic_offset_count_; }
+
+    void validate_binding(uint32_t index, const std::vector<uint32_t>& dynamic_offsets) const;
+
+protected:
+    uint32_t index_;
+    std::vector<Bind_group_entry> entries_;
+    uint32_t dynamic_offset_count_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_BIND_GROUP_GUARD
@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <array>
 #include <bitset>
+#include <vector>
 #include <platform/Extent.h>
 #include "limitations.h"
 #include "enums.h"
@@ -23,6 +24,7 @@ class Buffer;
 class Image;
 class Sampler;
 class Pipeline;
+class Bind_group;
 class Cmd_buffer;
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -43,15 +45,41 @@ struct Render_encoder_desc final {
 
 //----------------------------------------------------------------------------------------------------------------------
 
+struct Draw_indirect_args final {
+    uint32_t count {0};
+    uint32_t instance_count {1};
+    uint32_t first {0};
+    uint32_t first_instance {0};
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Draw_indexed_indirect_args final {
+    uint32_t count {0};
+    uint32_t instance_count {1};
+    uint32_t first {0};
+    int32_t base_vertex {0};
+    uint32_t first_instance {0};
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
 class Render_encoder {
 public:
     virtual ~Render_encoder() = default;
 
     virtual void end() = 0;
 
-    virtual void draw(uint32_t count, uint32_t first = 0) = 0;
+    virtual void draw(uint32_t count, uint32_t first = 0, uint32_t instance_count = 1, uint32_t first_instance = 0) = 0;
+
+    virtual void draw_indexed(uint32_t count, uint32_t first = 0, uint32_t instance_count = 1,
+                              uint32_t first_instance = 0, int32_t base_vertex = 0) = 0;
+
+    virtual void draw_indirect(Buffer* buffer, uint64_t offset, uint32_t draw_count = 1,
+                               uint32_t stride = sizeof(Draw_indirect_args)) = 0;
 
-    virtual void draw_indexed(uint32_t count, uint32_t first = 0) = 0;
+    virtual void draw_indexed_indirect(Buffer* buffer, uint64_t offset, uint32_t draw_count = 1,
+                                       uint32_t stride = sizeof(Draw_indexed_indirect_args)) = 0;
 
     virtual void vertex_buffer(Buffer* buffer, uint64_t offset, uint32_t index) = 0;
 
@@ -61,6 +89,11 @@ public:
 
     virtual void shader_texture(Image* image, Sampler* sampler, uint32_t index) = 0;
 
+    virtual void shader_bytes(Pipeline_stage stage, uint32_t offset, const void* data, uint32_t size) = 0;
+
+    virtual void bind_group(uint32_t index, Bind_group* bind_group,
+                            const std::vector<uint32_t>& dynamic_offsets = {}) = 0;
+
     virtual void pipeline(Pipeline* pipeline) = 0;
 
     virtual void viewport(const Viewport& viewport) = 0;
@@ -72,6 +105,55 @@ public:
 
 //----------------------------------------------------------------------------------------------------------------------
 
+struct Parallel_render_encoder_desc final {
+    Render_encoder_desc render_encoder;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Parallel_render_encoder {
+public:
+    virtual ~Parallel_render_encoder() = default;
+
+    virtual Render_encoder* render_encoder() = 0;
+
+    virtual void end() = 0;
+
+    virtual Cmd_buffer* cmd_buffer() const = 0;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Compute_encoder_desc final {
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Compute_encoder {
+public:
+    virtual ~Compute_encoder() = default;
+
+    virtual void end() = 0;
+
+    virtual void dispatch(uint32_t x, uint32_t y = 1, uint32_t z = 1) = 0;
+
+    virtual void dispatch_indirect(Buffer* buffer, uint64_t offset = 0) = 0;
+
+    virtual void shader_buffer(Buffer* buffer, uint32_t offset, uint32_t index) = 0;
+
+    virtual void shader_texture(Image* image, Sampler* sampler, uint32_t index) = 0;
+
+    virtual void storage_buffer(Buffer* buffer, uint32_t offset, uint32_t index) = 0;
+
+    virtual void storage_image(Image* image, uint32_t index) = 0;
+
+    virtual void pipeline(Pipeline* pipeline) = 0;
+
+    virtual Cmd_buffer* cmd_buffer() const = 0;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
 struct Image_subresource final {
     uint32_t mip_level {0};
     uint32_t array_layer {0};
@@ -121,6 +203,7 @@ public:
 //----------------------------------------------------------------------------------------------------------------------
 
 struct Cmd_buffer_desc final {
+    Queue_type queue_type {Queue_type::graphics};
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -131,8 +214,12 @@ public:
 
     virtual std::unique_ptr<Render_encoder> create(const Render_encoder_desc& desc) = 0;
 
+    virtual std::unique_ptr<Parallel_render_encoder> create(const Parallel_render_encoder_desc& desc) = 0;
+
     virtual std::unique_ptr<Blit_encoder> create(const Blit_encoder_desc& desc) = 0;
 
+    virtual std::unique_ptr<Compute_encoder> create(const Compute_encoder_desc& desc) = 0;
+
     virtual void end() = 0;
 
     virtual void reset() = 0;
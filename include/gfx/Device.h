@@ -7,15 +7,21 @@
 #define GFX_DEVICE_GUARD
 
 #include <memory>
+#include <string>
+#include <vector>
+#include <functional>
 #include "enums.h"
 #include "Buffer.h"
 #include "Image.h"
 #include "Sampler.h"
 #include "Shader.h"
 #include "Pipeline.h"
+#include "Bind_group.h"
 #include "Swap_chain.h"
 #include "Cmd_buffer.h"
 #include "Fence.h"
+#include "Semaphore.h"
+#include "Timeline.h"
 
 namespace Gfx_lib {
 
@@ -28,10 +34,50 @@ struct Caps final {
 
 //----------------------------------------------------------------------------------------------------------------------
 
+struct Adapter final {
+    uint32_t index {0};
+    std::string name;
+    Adapter_type type {Adapter_type::other};
+    uint64_t memory_size {0};
+    uint32_t queue_family_count {0};
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+using Adapter_score = std::function<uint64_t (const Adapter& adapter)>;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+uint64_t default_adapter_score(const Adapter& adapter) noexcept;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Device_desc final {
+    Backend backend {Backend::automatic};
+    uint32_t adapter_index {UINT32_MAX};
+    Adapter_score adapter_score {default_adapter_score};
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Submit_desc final {
+    std::vector<Cmd_buffer*> cmd_buffers;
+    std::vector<Semaphore*> wait_semaphores;
+    std::vector<Semaphore*> signal_semaphores;
+    Timeline* timeline {nullptr};
+    uint64_t timeline_value {0};
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
 class Device {
 public:
     static std::unique_ptr<Device> create();
 
+    static std::unique_ptr<Device> create(const Device_desc& desc);
+
+    static std::vector<Adapter> enumerate(Backend backend);
+
     virtual ~Device() = default;
 
     virtual std::unique_ptr<Buffer> create(const Buffer_desc& desc) = 0;
@@ -44,21 +90,50 @@ public:
 
     virtual std::unique_ptr<Pipeline> create(const Pipeline_desc& desc) = 0;
 
+    virtual std::unique_ptr<Pipeline> create(const Compute_pipeline_desc& desc) = 0;
+
+    virtual std::unique_ptr<Bind_group> create(const Bind_group_desc& desc) = 0;
+
     virtual std::unique_ptr<Swap_chain> create(const Swap_chain_desc& desc) = 0;
 
     virtual std::unique_ptr<Cmd_buffer> create(const Cmd_buffer_desc& desc) = 0;
 
     virtual std::unique_ptr<Fence> create(const Fence_desc& desc) = 0;
 
+    virtual std::unique_ptr<Semaphore> create(const Semaphore_desc& desc) = 0;
+
+    virtual std::unique_ptr<Timeline> create(const Timeline_desc& desc) = 0;
+
     virtual void submit(Cmd_buffer* cmd_buffer, Fence* fence = nullptr) = 0;
 
+    virtual void submit(const std::vector<Submit_desc>& descs, Fence* fence = nullptr) = 0;
+
+    virtual bool wait(const std::vector<Fence*>& fences, bool wait_all, uint64_t timeout = UINT64_MAX);
+
     virtual void wait_idle() = 0;
 
+    inline auto wait_all(const std::vector<Fence*>& fences, uint64_t timeout = UINT64_MAX)
+    { return wait(fences, true, timeout); }
+
+    inline auto wait_any(const std::vector<Fence*>& fences, uint64_t timeout = UINT64_MAX)
+    { return wait(fences, false, timeout); }
+
     inline auto caps() const noexcept
     { return caps_; }
 
+    inline auto backend() const noexcept
+    { return backend_; }
+
+    inline auto adapter() const noexcept
+    { return adapter_; }
+
+protected:
+    static const Adapter& select(const std::vector<Adapter>& adapters, const Device_desc& desc);
+
 protected:
     Caps caps_;
+    Backend backend_ {Backend::automatic};
+    Adapter adapter_;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,103 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_DRAW_QUEUE_GUARD
+#define GFX_DRAW_QUEUE_GUARD
+
+#include <cstdint>
+#include <array>
+#include <vector>
+#include "enums.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Buffer;
+class Pipeline;
+class Bind_group;
+class Render_encoder;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Draw_item final {
+    Pipeline* pipeline {nullptr};
+    Bind_group* bind_group {nullptr};
+    Buffer* vertex_buffer {nullptr};
+    uint64_t vertex_offset {0};
+    Buffer* index_buffer {nullptr};
+    uint64_t index_offset {0};
+    Index_type index_type {Index_type::uint16};
+    Buffer* shader_buffer {nullptr};
+    uint32_t shader_buffer_offset {0};
+    uint32_t shader_buffer_index {0};
+    Pipeline_stage bytes_stage {Pipeline_stage::vertex_shader};
+    const void* bytes {nullptr};
+    uint32_t byte_size {0};
+    uint32_t count {0};
+    uint32_t first {0};
+    uint32_t instance_count {1};
+    uint32_t first_instance {0};
+    int32_t base_vertex {0};
+    float depth {0.0f};
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Draw_queue final {
+public:
+    Draw_queue();
+
+    void add(const Draw_item& item);
+
+    void encode(Render_encoder* render_encoder);
+
+    void clear() noexcept;
+
+    inline auto size() const noexcept
+    { return static_cast<uint32_t>(entries_.size()); }
+
+    inline auto empty() const noexcept
+    { return entries_.empty(); }
+
+private:
+    struct Entry final {
+        Draw_item item;
+        uint32_t bytes_offset;
+        uint64_t key;
+    };
+
+    struct Id_slot final {
+        const void* object;
+        uint32_t id;
+        uint32_t generation;
+    };
+
+    uint64_t to_key_(const Draw_item& item);
+
+    uint32_t to_id_(const void* object, uint32_t category);
+
+    void grow_id_slots_();
+
+    void sort_();
+
+private:
+    std::vector<Entry> entries_;
+    std::vector<uint8_t> bytes_;
+    std::vector<uint64_t> keys_;
+    std::vector<uint32_t> order_;
+    std::vector<uint64_t> sort_keys_;
+    std::vector<uint32_t> sort_order_;
+    std::vector<Id_slot> id_slots_;
+    uint32_t id_generation_;
+    uint32_t id_slot_count_;
+    std::array<uint32_t, 4> id_counts_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_DRAW_QUEUE_GUARD
@@ -6,6 +6,8 @@
 #ifndef GFX_FENCE_GUARD
 #define GFX_FENCE_GUARD
 
+#include <cstdint>
+
 namespace Gfx_lib {
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -24,7 +26,7 @@ class Fence {
 public:
     virtual ~Fence() = default;
 
-    virtual void wait_signal() = 0;
+    virtual bool wait_signal(uint64_t timeout = UINT64_MAX) = 0;
 
     virtual void reset() = 0;
 
@@ -0,0 +1,102 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_FRAME_CONTEXT_GUARD
+#define GFX_FRAME_CONTEXT_GUARD
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Device.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Frame_context_desc final {
+    uint32_t frame_count {2};
+    uint32_t cmd_buffer_count {1};
+    Queue_type queue_type {Queue_type::graphics};
+    uint64_t transient_size {1024 * 1024};
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Frame_allocation final {
+    Buffer* buffer {nullptr};
+    uint64_t offset {0};
+    void* data {nullptr};
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Frame_context final {
+public:
+    Frame_context(const Frame_context_desc& desc, Device* device);
+
+    ~Frame_context();
+
+    void begin_frame();
+
+    void end_frame();
+
+    Frame_allocation allocate(uint64_t size, uint64_t alignment = 256);
+
+    template<typename T>
+    inline void release(std::unique_ptr<T> object)
+    { frames_[frame_index_].releases.emplace_back(std::move(object)); }
+
+    inline auto cmd_buffer(uint32_t index = 0) const noexcept
+    { return frames_[frame_index_].cmd_buffers[index].get(); }
+
+    inline auto fence() const noexcept
+    { return frames_[frame_index_].fence.get(); }
+
+    inline auto frame_index() const noexcept
+    { return frame_index_; }
+
+    inline auto frame_count() const noexcept
+    { return static_cast<uint32_t>(frames_.size()); }
+
+    inline auto frame_number() const noexcept
+    { return frame_number_; }
+
+    inline auto device() const noexcept
+    { return device_; }
+
+private:
+    struct Transient_block final {
+        std::unique_ptr<Buffer> buffer;
+        uint8_t* data {nullptr};
+    };
+
+    struct Frame final {
+        std::vector<std::unique_ptr<Cmd_buffer>> cmd_buffers;
+        std::unique_ptr<Fence> fence;
+        std::vector<Transient_block> transient_blocks;
+        size_t transient_index {0};
+        uint64_t transient_offset {0};
+        std::vector<std::shared_ptr<void>> releases;
+    };
+
+    void init_frames_(const Frame_context_desc& desc);
+
+    void fini_frames_();
+
+    void unmap_transient_blocks_(Frame& frame);
+
+private:
+    Device* device_;
+    uint64_t transient_size_;
+    std::vector<Frame> frames_;
+    uint32_t frame_index_;
+    uint64_t frame_number_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_FRAME_CONTEXT_GUARD
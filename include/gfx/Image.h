@@ -25,6 +25,7 @@ struct Image_desc final {
     uint8_t mip_levels {1};
     uint8_t array_layers {1};
     uint8_t samples {1};
+    bool storage {false};
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -37,7 +38,8 @@ public:
         extent_ {desc.extent},
         mip_levels_ {desc.mip_levels},
         array_layers_ {desc.array_layers},
-        samples_ {desc.samples}
+        samples_ {desc.samples},
+        storage_ {desc.storage}
     {}
 
     virtual ~Image() = default;
@@ -62,6 +64,9 @@ public:
     inline uint8_t samples() const noexcept
     { return samples_; }
 
+    inline bool storage() const noexcept
+    { return storage_; }
+
 protected:
     Image_type type_;
     Format format_;
@@ -69,6 +74,7 @@ protected:
     uint8_t mip_levels_;
     uint8_t array_layers_;
     uint8_t samples_;
+    bool storage_;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
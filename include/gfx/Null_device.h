@@ -0,0 +1,152 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_NULL_DEVICE_GUARD
+#define GFX_NULL_DEVICE_GUARD
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include "Device.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+enum class Null_call : uint32_t {
+    device_create_buffer = 0,
+    device_create_image,
+    device_create_sampler,
+    device_create_shader,
+    device_create_pipeline,
+    device_create_compute_pipeline,
+    device_create_bind_group,
+    device_create_swap_chain,
+    device_create_cmd_buffer,
+    device_create_fence,
+    device_create_semaphore,
+    device_create_timeline,
+    device_submit,
+    device_submit_batch,
+    device_wait,
+    device_wait_idle,
+    buffer_map,
+    buffer_unmap,
+    swap_chain_acquire,
+    swap_chain_present,
+    cmd_buffer_create_render_encoder,
+    cmd_buffer_create_parallel_render_encoder,
+    cmd_buffer_create_blit_encoder,
+    cmd_buffer_create_compute_encoder,
+    cmd_buffer_end,
+    cmd_buffer_reset,
+    render_encoder_end,
+    render_encoder_draw,
+    render_encoder_draw_indexed,
+    render_encoder_draw_indirect,
+    render_encoder_draw_indexed_indirect,
+    render_encoder_vertex_buffer,
+    render_encoder_index_buffer,
+    render_encoder_shader_buffer,
+    render_encoder_shader_texture,
+    render_encoder_shader_bytes,
+    render_encoder_bind_group,
+    render_encoder_pipeline,
+    render_encoder_viewport,
+    render_encoder_scissor,
+    parallel_render_encoder_render_encoder,
+    parallel_render_encoder_end,
+    blit_encoder_copy,
+    blit_encoder_end,
+    compute_encoder_end,
+    compute_encoder_dispatch,
+    compute_encoder_dispatch_indirect,
+    compute_encoder_shader_buffer,
+    compute_encoder_shader_texture,
+    compute_encoder_storage_buffer,
+    compute_encoder_storage_image,
+    compute_encoder_pipeline,
+    fence_wait_signal,
+    fence_reset,
+    fence_signaled,
+    count
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Null_counter final {
+    uint64_t count {0};
+    uint64_t first_time {0};
+    uint64_t last_time {0};
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Null_device final : public Device {
+public:
+    explicit Null_device(const Device_desc& desc = {});
+
+    static std::vector<Adapter> enumerate();
+
+    std::unique_ptr<Buffer> create(const Buffer_desc& desc) override;
+
+    std::unique_ptr<Image> create(const Image_desc& desc) override;
+
+    std::unique_ptr<Sampler> create(const Sampler_desc& desc) override;
+
+    std::unique_ptr<Shader> create(const Shader_desc& desc) override;
+
+    std::unique_ptr<Pipeline> create(const Pipeline_desc& desc) override;
+
+    std::unique_ptr<Pipeline> create(const Compute_pipeline_desc& desc) override;
+
+    std::unique_ptr<Bind_group> create(const Bind_group_desc& desc) override;
+
+    std::unique_ptr<Swap_chain> create(const Swap_chain_desc& desc) override;
+
+    std::unique_ptr<Cmd_buffer> create(const Cmd_buffer_desc& desc) override;
+
+    std::unique_ptr<Fence> create(const Fence_desc& desc) override;
+
+    std::unique_ptr<Semaphore> create(const Semaphore_desc& desc) override;
+
+    std::unique_ptr<Timeline> create(const Timeline_desc& desc) override;
+
+    void submit(Cmd_buffer* cmd_buffer, Fence* fence = nullptr) override;
+
+    void submit(const std::vector<Submit_desc>& descs, Fence* fence = nullptr) override;
+
+    bool wait(const std::vector<Fence*>& fences, bool wait_all, uint64_t timeout = UINT64_MAX) override;
+
+    void wait_idle() override;
+
+    void record(Null_call call) noexcept;
+
+    Null_counter counter(Null_call call) const noexcept;
+
+    void reset_counters() noexcept;
+
+private:
+    struct Atomic_counter final {
+        std::atomic<uint64_t> count {0};
+        std::atomic<uint64_t> first_time {0};
+        std::atomic<uint64_t> last_time {0};
+    };
+
+private:
+    void init_adapter_(const Device_desc& desc);
+
+    void init_caps_();
+
+private:
+    std::chrono::steady_clock::time_point epoch_;
+    std::array<Atomic_counter, static_cast<uint32_t>(Null_call::count)> counters_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_NULL_DEVICE_GUARD
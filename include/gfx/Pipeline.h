@@ -7,9 +7,11 @@
 #define GFX_PIPELINE_GUARD
 
 #include <array>
+#include <vector>
 #include <unordered_map>
 #include "limitations.h"
 #include "enums.h"
+#include "types.h"
 
 namespace Gfx_lib {
 
@@ -119,9 +121,19 @@ struct Output_merger final {
 
 //----------------------------------------------------------------------------------------------------------------------
 
+struct Push_constant_range final {
+    uint32_t stages {0};
+    uint32_t size {0};
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
 struct Reflection {
     std::unordered_map<uint32_t, uint32_t> buffers;
     std::unordered_map<uint32_t, uint32_t> textures;
+    std::unordered_map<uint32_t, uint32_t> storage_buffers;
+    std::unordered_map<uint32_t, uint32_t> storage_images;
+    Push_constant_range push_constants;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -136,6 +148,16 @@ struct Pipeline_desc final {
     Depth_stencil depth_stencil;
     Color_blend color_blend;
     Output_merger output_merger;
+    uint32_t push_constant_size {0};
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Compute_pipeline_desc final {
+    Shader* compute_shader;
+    std::vector<uint32_t> storage_buffers;
+    std::vector<uint32_t> storage_images;
+    Extent work_group_size {1, 1, 1};
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -144,6 +166,8 @@ class Pipeline {
 public:
     explicit Pipeline(const Pipeline_desc& desc);
 
+    explicit Pipeline(const Compute_pipeline_desc& desc);
+
     virtual ~Pipeline() = default;
 
     virtual Device* device() const = 0;
@@ -169,12 +193,22 @@ public:
     inline auto output_merger() const noexcept
     { return output_merger_; }
 
+    inline auto work_group_size() const noexcept
+    { return work_group_size_; }
+
     inline auto reflection() const noexcept
     { return reflection_; }
 
+    inline auto push_constants() const noexcept
+    { return reflection_.push_constants; }
+
 private:
     void init_reflection_(const std::vector<Shader*> shaders);
 
+    void init_storage_reflection_(const std::vector<uint32_t>& buffers, const std::vector<uint32_t>& images);
+
+    void init_push_constant_reflection_(uint32_t size);
+
 protected:
     Vertex_input vertex_input_;
     Input_assembly input_assembly_;
@@ -183,6 +217,7 @@ protected:
     Depth_stencil depth_stencil_;
     Color_blend color_blend_;
     Output_merger output_merger_;
+    Extent work_group_size_;
     Reflection reflection_;
 };
 
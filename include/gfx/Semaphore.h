@@ -0,0 +1,33 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_SEMAPHORE_GUARD
+#define GFX_SEMAPHORE_GUARD
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Device;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Semaphore_desc final {
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Semaphore {
+public:
+    virtual ~Semaphore() = default;
+
+    virtual Device* device() const = 0;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_SEMAPHORE_GUARD
@@ -0,0 +1,42 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_TIMELINE_GUARD
+#define GFX_TIMELINE_GUARD
+
+#include <cstdint>
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Device;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Timeline_desc final {
+    uint64_t value {0};
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Timeline {
+public:
+    virtual ~Timeline() = default;
+
+    virtual bool wait(uint64_t value, uint64_t timeout = UINT64_MAX) = 0;
+
+    virtual void signal(uint64_t value) = 0;
+
+    virtual Device* device() const = 0;
+
+    virtual uint64_t value() const = 0;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_TIMELINE_GUARD
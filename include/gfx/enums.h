@@ -18,6 +18,24 @@ enum class Vender : uint32_t {
 
 //----------------------------------------------------------------------------------------------------------------------
 
+enum class Backend : uint8_t {
+    automatic = 0, vulkan, opengl, metal, cpu, null
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+enum class Adapter_type : uint8_t {
+    other = 0, discrete, integrated, virtual_gpu, cpu
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+enum class Queue_type : uint8_t {
+    graphics = 0, transfer
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
 enum class Coords : uint8_t {
     invalid = 0,
     origin_upper_left, origin_lower_left
@@ -70,7 +88,7 @@ enum class Address_mode : uint8_t {
 
 enum class Pipeline_stage : uint8_t {
     invalid = 0,
-    vertex_shader = 0x01, fragment_shader = 0x02, output_merger = 0x04, transfer = 0x08
+    vertex_shader = 0x01, fragment_shader = 0x02, output_merger = 0x04, transfer = 0x08, compute_shader = 0x10
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -14,7 +14,10 @@ constexpr auto max_vertex_input_attributes {16u};
 constexpr auto max_vertex_input_bindings {8u};
 constexpr auto max_shader_buffers {16u};
 constexpr auto max_shader_textures {16u};
+constexpr auto max_storage_buffers {8u};
+constexpr auto max_storage_images {8u};
 constexpr auto max_color_attachments {4u};
+constexpr auto max_push_constant_size {128u};
 
 //----------------------------------------------------------------------------------------------------------------------
 
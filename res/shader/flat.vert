@@ -10,14 +10,17 @@ layout(location = 0) out flat vec3 light_intensity;
 
 //----------------------------------------------------------------------------------------------------------------------
 
-layout(binding = 0) uniform Matrix_info {
-    mat4 model;
+layout(binding = 0) uniform Camera_info {
     mat4 view;
     mat4 projection;
+} camera_info;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+layout(push_constant) uniform Object_info {
     mat4 mv;
-    mat4 mvp;
     mat4 normal;
-} matrix_info;
+} object_info;
 
 //----------------------------------------------------------------------------------------------------------------------
 
@@ -41,14 +44,14 @@ layout(binding = 2) uniform Material_info {
 
 void main()
 {
-    gl_Position = matrix_info.mvp * vec4(vertex_position, 1.0);
+    gl_Position = camera_info.projection * object_info.mv * vec4(vertex_position, 1.0);
 
     vec3 ambient = light_info.ambient * material_info.ambient;
 
-    vec3 position = (matrix_info.mv * vec4(vertex_position, 1.0)).xyz;
-    vec3 normal = mat3(matrix_info.normal) * vertex_normal;
+    vec3 position = (object_info.mv * vec4(vertex_position, 1.0)).xyz;
+    vec3 normal = mat3(object_info.normal) * vertex_normal;
     vec3 n = normalize(normal);
-    vec3 s = normalize((matrix_info.view * vec4(light_info.translation, 1.0)).xyz - position);
+    vec3 s = normalize((camera_info.view * vec4(light_info.translation, 1.0)).xyz - position);
 
     float n_dot_s = max(dot(n, s), 0.0);
     vec3 diffuse = n_dot_s * light_info.diffuse * material_info.diffuse;
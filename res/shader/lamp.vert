@@ -4,20 +4,23 @@ layout(location = 0) in vec3 vertex_position;
 
 //----------------------------------------------------------------------------------------------------------------------
 
-layout(binding = 0) uniform Matrix_info {
-    mat4 model;
+layout(binding = 0) uniform Camera_info {
     mat4 view;
     mat4 projection;
+} camera_info;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+layout(push_constant) uniform Object_info {
     mat4 mv;
-    mat4 mvp;
     mat4 normal;
-} matrix_info;
+} object_info;
 
 //----------------------------------------------------------------------------------------------------------------------
 
 void main()
 {
-	gl_Position = matrix_info.mvp * vec4(vertex_position, 1.0);
+	gl_Position = camera_info.projection * object_info.mv * vec4(vertex_position, 1.0);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
\ No newline at end of file
@@ -13,14 +13,10 @@ layout(location = 0) out vec4 fragment_color;
 
 //----------------------------------------------------------------------------------------------------------------------
 
-layout(binding = 0) uniform Matrix_info {
-    mat4 model;
+layout(binding = 0) uniform Camera_info {
     mat4 view;
     mat4 projection;
-    mat4 mv;
-    mat4 mvp;
-    mat4 normal;
-} matrix_info;
+} camera_info;
 
 //----------------------------------------------------------------------------------------------------------------------
 
@@ -47,7 +43,7 @@ void main()
     vec3 ambient = light_info.ambient * material_info.ambient;
 
     vec3 n = normalize(normal);
-    vec3 s = normalize((matrix_info.view * vec4(light_info.translation, 1.0)).xyz - position);
+    vec3 s = normalize((camera_info.view * vec4(light_info.translation, 1.0)).xyz - position);
 
     float n_dot_s = max(dot(n, s), 0.0);
     vec3 diffuse = n_dot_s * light_info.diffuse * material_info.diffuse;
@@ -11,22 +11,25 @@ layout(location = 1) out vec3 normal;
 
 //----------------------------------------------------------------------------------------------------------------------
 
-layout(binding = 0) uniform Matrix_info {
-    mat4 model;
+layout(binding = 0) uniform Camera_info {
     mat4 view;
     mat4 projection;
+} camera_info;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+layout(push_constant) uniform Object_info {
     mat4 mv;
-    mat4 mvp;
     mat4 normal;
-} matrix_info;
+} object_info;
 
 //----------------------------------------------------------------------------------------------------------------------
 
 void main()
 {
-    gl_Position = matrix_info.mvp * vec4(vertex_position, 1.0);
-    position = (matrix_info.mv * vec4(vertex_position, 1.0)).xyz;
-    normal = mat3(matrix_info.normal) * vertex_normal;
+    gl_Position = camera_info.projection * object_info.mv * vec4(vertex_position, 1.0);
+    position = (object_info.mv * vec4(vertex_position, 1.0)).xyz;
+    normal = mat3(object_info.normal) * vertex_normal;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,59 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "std_lib.h"
+#include "Bind_group.h"
+#include "Pipeline.h"
+
+using namespace std;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Bind_group::Bind_group(const Bind_group_desc& desc) :
+    index_ {desc.index},
+    entries_ {desc.entries},
+    dynamic_offset_count_ {0}
+{
+    // uniform buffers are grouped at the index 0 and textures are grouped at the index 1.
+    if (!desc.pipeline || desc.index > 1)
+        throw runtime_error("fail to create a bind group");
+
+    auto reflection = desc.pipeline->reflection();
+    auto& args = desc.index ? reflection.textures : reflection.buffers;
+
+    if (args.size() != entries_.size())
+        throw runtime_error("fail to create a bind group");
+
+    for (auto& entry : entries_) {
+        auto valid = desc.index ? entry.image && entry.sampler : entry.buffer != nullptr;
+
+        if (!valid || !args.count(entry.index))
+            throw runtime_error("fail to create a bind group");
+    }
+
+    // dynamic offsets are ordered by indices.
+    sort(entries_.begin(), entries_.end(), [](auto& lhs, auto& rhs) { return lhs.index < rhs.index; });
+
+    if (!desc.index)
+        dynamic_offset_count_ = static_cast<uint32_t>(entries_.size());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Bind_group::validate_binding(uint32_t index, const std::vector<uint32_t>& dynamic_offsets) const
+{
+    // a group is baked for its index, so it can't be bound to another slot.
+    if (index != index_)
+        throw runtime_error("fail to bind a group");
+
+    if (!dynamic_offsets.empty() && dynamic_offsets.size() != dynamic_offset_count_)
+        throw runtime_error("fail to bind a group");
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
@@ -4,13 +4,17 @@
 //
 
 #include <platform/build_target.h>
+#include <chrono>
+#include <thread>
+#include "std_lib.h"
 #include "Device.h"
+#include "Null_device.h"
 
 #if TARGET_OS_IOS || TARGET_OS_OSX
 #include "Mtl_device.h"
 #endif
 
-#if defined(__ANDROID__) || defined(_WIN32)
+#if defined(__ANDROID__) || defined(__linux__) || defined(_WIN32)
 #include "Vlk_device.h"
 #endif
 
@@ -18,32 +22,244 @@
 #include "Ogl_device.h"
 #endif
 
+#include "Cpu_device.h"
+
 using namespace std;
+using namespace std::chrono;
+using namespace Gfx_lib;
 
-namespace Gfx_lib {
+namespace {
 
 //----------------------------------------------------------------------------------------------------------------------
 
-std::unique_ptr<Device> Device::create()
+inline uint64_t to_rank(Adapter_type type) noexcept
+{
+    switch (type) {
+        case Adapter_type::discrete:
+            return 4;
+        case Adapter_type::integrated:
+            return 3;
+        case Adapter_type::virtual_gpu:
+            return 2;
+        case Adapter_type::cpu:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline const char* to_name(Backend backend) noexcept
+{
+    switch (backend) {
+        case Backend::vulkan:
+            return "vulkan";
+        case Backend::opengl:
+            return "opengl";
+        case Backend::metal:
+            return "metal";
+        case Backend::cpu:
+            return "cpu";
+        case Backend::null:
+            return "null";
+        default:
+            return "automatic";
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline vector<Backend> automatic_backends()
 {
+    // a cpu backend is a fixed-function test rasterizer, so it is never selected automatically.
 #if TARGET_OS_IOS || TARGET_OS_OSX
-    return make_unique<Mtl_device>();
+    return {Backend::metal};
+#elif defined(__ANDROID__)
+    return {Backend::vulkan, Backend::opengl};
+#elif defined(__linux__) || defined(_WIN32)
+    return {Backend::vulkan};
+#else
+    return {};
 #endif
+}
 
+//----------------------------------------------------------------------------------------------------------------------
+
+unique_ptr<Device> create_device(Backend backend, const Device_desc& desc)
+{
+    switch (backend) {
+#if defined(__ANDROID__) || defined(__linux__) || defined(_WIN32)
+        case Backend::vulkan:
+            return make_unique<Vlk_device>(desc);
+#endif
 #if defined(__ANDROID__)
-    try {
-        return make_unique<Vlk_device>();
+        case Backend::opengl:
+            return make_unique<Ogl_device>(desc);
+#endif
+#if TARGET_OS_IOS || TARGET_OS_OSX
+        case Backend::metal:
+            return make_unique<Mtl_device>(desc);
+#endif
+        case Backend::cpu:
+            return make_unique<Cpu_device>(desc);
+        case Backend::null:
+            return make_unique<Null_device>(desc);
+        default:
+            throw runtime_error("fail to create a device");
     }
-    catch (exception& e) {
-        return make_unique<Ogl_device>();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+uint64_t default_adapter_score(const Adapter& adapter) noexcept
+{
+    // prefer a type, then a memory size in MiB, then a number of queue families.
+    constexpr auto max_memory_size {(uint64_t(1) << 40) - 1};
+    constexpr auto max_queue_family_count {uint64_t(UINT8_MAX)};
+
+    return (to_rank(adapter.type) << 56) |
+           (min(adapter.memory_size >> 20, max_memory_size) << 8) |
+           min(uint64_t(adapter.queue_family_count), max_queue_family_count);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Device> Device::create()
+{
+    return create(Device_desc {});
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Device> Device::create(const Device_desc& desc)
+{
+    if (Backend::automatic != desc.backend)
+        return create_device(desc.backend, desc);
+
+    string errors;
+
+    // try backends from the most preferred one, a failure of each backend is reported together.
+    for (auto backend : automatic_backends()) {
+        try {
+            return create_device(backend, desc);
+        }
+        catch (exception& e) {
+            errors += "\n"s + to_name(backend) + ": " + e.what();
+        }
     }
-#endif
 
-#if defined(_WIN32)
-    return make_unique<Vlk_device>();
+    throw runtime_error("fail to create a device" + errors);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::vector<Adapter> Device::enumerate(Backend backend)
+{
+    switch (backend) {
+        case Backend::automatic: {
+            for (auto automatic_backend : automatic_backends()) {
+                if (auto adapters = enumerate(automatic_backend); !adapters.empty())
+                    return adapters;
+            }
+
+            return {};
+        }
+#if defined(__ANDROID__) || defined(__linux__) || defined(_WIN32)
+        case Backend::vulkan:
+            return Vlk_device::enumerate();
 #endif
+#if defined(__ANDROID__)
+        case Backend::opengl:
+            return Ogl_device::enumerate();
+#endif
+#if TARGET_OS_IOS || TARGET_OS_OSX
+        case Backend::metal:
+            return Mtl_device::enumerate();
+#endif
+        case Backend::cpu:
+            return Cpu_device::enumerate();
+        case Backend::null:
+            return Null_device::enumerate();
+        default:
+            return {};
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+bool Device::wait(const std::vector<Fence*>& fences, bool wait_all, uint64_t timeout)
+{
+    if (fences.empty())
+        return true;
+
+    auto start = steady_clock::now();
+    auto remaining = [=]() -> uint64_t {
+        if (UINT64_MAX == timeout)
+            return UINT64_MAX;
+
+        auto elapsed = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+
+        return timeout > uint64_t(elapsed) ? timeout - elapsed : 0;
+    };
+
+    // wait fences one by one, a fence is signaled only once until it is reset.
+    if (wait_all) {
+        for (auto fence : fences) {
+            if (!fence->wait_signal(remaining()))
+                return false;
+        }
+
+        return true;
+    }
+
+    // poll fences because a backend can't wait any of them at once, a poll backs off up to a millisecond.
+    for (auto interval = microseconds(50); ; interval = min(interval * 2, microseconds(1000))) {
+        for (auto fence : fences) {
+            if (fence->signaled())
+                return true;
+        }
+
+        auto time = remaining();
+
+        if (!time)
+            return false;
+
+        this_thread::sleep_for(min<nanoseconds>(interval, nanoseconds(min(time, uint64_t(INT64_MAX)))));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+const Adapter& Device::select(const std::vector<Adapter>& adapters, const Device_desc& desc)
+{
+    if (adapters.empty())
+        throw runtime_error("fail to create a device");
+
+    // use an adapter pinned by an index.
+    if (UINT32_MAX != desc.adapter_index) {
+        auto iter = find_if(adapters, [&desc](auto& adapter) {
+            return desc.adapter_index == adapter.index;
+        });
+
+        if (adapters.end() == iter)
+            throw runtime_error("fail to create a device");
+
+        return *iter;
+    }
+
+    // use an adapter which has the highest score.
+    auto score = desc.adapter_score ? desc.adapter_score : Adapter_score {default_adapter_score};
 
-    return nullptr;
+    return *max_element(adapters.begin(), adapters.end(), [&score](auto& lhs, auto& rhs) {
+        return score(lhs) < score(rhs);
+    });
 }
 
 //----------------------------------------------------------------------------------------------------------------------
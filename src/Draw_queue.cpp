@@ -0,0 +1,278 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "std_lib.h"
+#include "Draw_queue.h"
+#include "Bind_group.h"
+#include "Cmd_buffer.h"
+
+using namespace std;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+// a key is ordered by a pipeline, a bind group, a vertex buffer, an index buffer and a depth.
+constexpr uint32_t pipeline_shift {52};
+constexpr uint32_t bind_group_shift {40};
+constexpr uint32_t vertex_buffer_shift {30};
+constexpr uint32_t index_buffer_shift {20};
+constexpr uint64_t depth_mask {(1u << 20) - 1};
+constexpr uint32_t min_id_slots {256};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline size_t to_hash(const void* object) noexcept
+{
+    // objects are aligned, so low bits are dropped and high bits of a product are folded into a slot index.
+    auto hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(object) >> 4) * 0x9e3779b97f4a7c15ull;
+
+    return static_cast<size_t>(hash ^ (hash >> 32));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Draw_queue::Draw_queue() :
+    entries_ {},
+    bytes_ {},
+    keys_ {},
+    order_ {},
+    sort_keys_ {},
+    sort_order_ {},
+    id_slots_ {},
+    id_generation_ {1},
+    id_slot_count_ {0},
+    id_counts_ {}
+{
+    id_slots_.resize(min_id_slots, {nullptr, 0, 0});
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Draw_queue::add(const Draw_item& item)
+{
+    if (!item.pipeline || item.byte_size > max_push_constant_size || item.shader_buffer_index >= max_shader_buffers)
+        throw runtime_error("fail to add a draw item");
+
+    // bytes are copied, so a caller doesn't need to keep them until an encoding.
+    auto bytes_offset = static_cast<uint32_t>(bytes_.size());
+
+    if (item.byte_size) {
+        auto bytes = static_cast<const uint8_t*>(item.bytes);
+
+        bytes_.insert(bytes_.end(), bytes, bytes + item.byte_size);
+    }
+
+    entries_.push_back({item, bytes_offset, to_key_(item)});
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Draw_queue::encode(Render_encoder* render_encoder)
+{
+    sort_();
+
+    Pipeline* pipeline {nullptr};
+    Bind_group* bind_group {nullptr};
+    Buffer* vertex_buffer {nullptr};
+    uint64_t vertex_offset {0};
+    Buffer* index_buffer {nullptr};
+    uint64_t index_offset {0};
+    array<Buffer*, max_shader_buffers> shader_buffers {};
+    array<uint32_t, max_shader_buffers> shader_buffer_offsets {};
+
+    // only states which differ from a previous draw are set to an encoder.
+    for (auto index : order_) {
+        auto& entry = entries_[index];
+        auto& item = entry.item;
+
+        if (pipeline != item.pipeline) {
+            render_encoder->pipeline(item.pipeline);
+            pipeline = item.pipeline;
+        }
+
+        if (item.bind_group && bind_group != item.bind_group) {
+            render_encoder->bind_group(item.bind_group->index(), item.bind_group);
+            bind_group = item.bind_group;
+        }
+
+        if (item.vertex_buffer && (vertex_buffer != item.vertex_buffer || vertex_offset != item.vertex_offset)) {
+            render_encoder->vertex_buffer(item.vertex_buffer, item.vertex_offset, 0);
+            vertex_buffer = item.vertex_buffer;
+            vertex_offset = item.vertex_offset;
+        }
+
+        if (item.index_buffer && (index_buffer != item.index_buffer || index_offset != item.index_offset)) {
+            render_encoder->index_buffer(item.index_buffer, item.index_offset, item.index_type);
+            index_buffer = item.index_buffer;
+            index_offset = item.index_offset;
+        }
+
+        if (item.shader_buffer) {
+            auto i = item.shader_buffer_index;
+
+            if (shader_buffers[i] != item.shader_buffer || shader_buffer_offsets[i] != item.shader_buffer_offset) {
+                render_encoder->shader_buffer(item.shader_buffer, item.shader_buffer_offset, i);
+                shader_buffers[i] = item.shader_buffer;
+                shader_buffer_offsets[i] = item.shader_buffer_offset;
+            }
+        }
+
+        if (item.byte_size)
+            render_encoder->shader_bytes(item.bytes_stage, 0, &bytes_[entry.bytes_offset], item.byte_size);
+
+        if (item.index_buffer) {
+            render_encoder->draw_indexed(item.count, item.first, item.instance_count,
+                                         item.first_instance, item.base_vertex);
+        }
+        else {
+            render_encoder->draw(item.count, item.first, item.instance_count, item.first_instance);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Draw_queue::clear() noexcept
+{
+    // containers keep their capacities, so a steady frame doesn't allocate.
+    entries_.clear();
+    bytes_.clear();
+    id_counts_.fill(0);
+    id_slot_count_ = 0;
+
+    // slots of a previous generation are empty, so a table is reset without touching it.
+    if (!++id_generation_) {
+        fill(id_slots_.begin(), id_slots_.end(), Id_slot {nullptr, 0, 0});
+        id_generation_ = 1;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+uint64_t Draw_queue::to_key_(const Draw_item& item)
+{
+    // an overflowed id only loses grouping, an encoding compares objects themselves.
+    uint64_t key {0};
+
+    key |= static_cast<uint64_t>(to_id_(item.pipeline, 0) & 0xfff) << pipeline_shift;
+    key |= static_cast<uint64_t>(to_id_(item.bind_group, 1) & 0xfff) << bind_group_shift;
+    key |= static_cast<uint64_t>(to_id_(item.vertex_buffer, 2) & 0x3ff) << vertex_buffer_shift;
+    key |= static_cast<uint64_t>(to_id_(item.index_buffer, 3) & 0x3ff) << index_buffer_shift;
+    key |= static_cast<uint64_t>(clamp(item.depth, 0.0f, 1.0f) * depth_mask);
+
+    return key;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+uint32_t Draw_queue::to_id_(const void* object, uint32_t category)
+{
+    if (!object)
+        return 0;
+
+    // a load factor is kept under a half, so a linear probing is short.
+    if (id_slot_count_ * 2 >= id_slots_.size())
+        grow_id_slots_();
+
+    auto mask = id_slots_.size() - 1;
+
+    for (auto i = to_hash(object) & mask; ; i = (i + 1) & mask) {
+        auto& slot = id_slots_[i];
+
+        if (id_generation_ != slot.generation) {
+            // ids are dense in each category, so they fit in a few bits of a key.
+            slot = {object, ++id_counts_[category], id_generation_};
+            ++id_slot_count_;
+
+            return slot.id;
+        }
+
+        if (object == slot.object)
+            return slot.id;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Draw_queue::grow_id_slots_()
+{
+    vector<Id_slot> id_slots(id_slots_.size() * 2, {nullptr, 0, 0});
+    auto mask = id_slots.size() - 1;
+
+    for (auto& slot : id_slots_) {
+        if (id_generation_ != slot.generation)
+            continue;
+
+        auto i = to_hash(slot.object) & mask;
+
+        while (id_generation_ == id_slots[i].generation)
+            i = (i + 1) & mask;
+
+        id_slots[i] = slot;
+    }
+
+    id_slots_.swap(id_slots);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Draw_queue::sort_()
+{
+    auto count = entries_.size();
+
+    keys_.resize(count);
+    order_.resize(count);
+    sort_keys_.resize(count);
+    sort_order_.resize(count);
+
+    for (size_t i = 0; i != count; ++i) {
+        keys_[i] = entries_[i].key;
+        order_[i] = static_cast<uint32_t>(i);
+    }
+
+    // sort keys with a stable radix sort, a digit is a byte from the least significant one.
+    for (uint32_t shift = 0; shift != 64; shift += 8) {
+        array<uint32_t, 256> offsets {};
+
+        for (auto key : keys_)
+            ++offsets[(key >> shift) & 0xff];
+
+        // a pass is skipped when every key has a same digit.
+        if (!count || offsets[(keys_[0] >> shift) & 0xff] == count)
+            continue;
+
+        uint32_t offset {0};
+
+        for (auto& value : offsets) {
+            auto digit_count = value;
+
+            value = offset;
+            offset += digit_count;
+        }
+
+        for (size_t i = 0; i != count; ++i) {
+            auto position = offsets[(keys_[i] >> shift) & 0xff]++;
+
+            sort_keys_[position] = keys_[i];
+            sort_order_[position] = order_[i];
+        }
+
+        keys_.swap(sort_keys_);
+        order_.swap(sort_order_);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
@@ -0,0 +1,163 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "std_lib.h"
+#include "Frame_context.h"
+
+using namespace std;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Frame_context::Frame_context(const Frame_context_desc& desc, Device* device) :
+    device_ {device},
+    transient_size_ {desc.transient_size},
+    frames_ {},
+    frame_index_ {0},
+    frame_number_ {0}
+{
+    init_frames_(desc);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Frame_context::~Frame_context()
+{
+    fini_frames_();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Frame_context::begin_frame()
+{
+    auto& frame = frames_[frame_index_];
+
+    // block only while the gpu still executes the frame which used this slot before.
+    if (!frame.fence->signaled())
+        frame.fence->wait_signal();
+
+    // the slot is idle, so deferred objects can be destroyed and memory can be reused.
+    frame.releases.clear();
+
+    for (auto& cmd_buffer : frame.cmd_buffers)
+        cmd_buffer->reset();
+
+    // transient blocks are kept, so a steady frame rewinds them without creating buffers.
+    frame.transient_index = 0;
+    frame.transient_offset = 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Frame_context::end_frame()
+{
+    auto& frame = frames_[frame_index_];
+
+    unmap_transient_blocks_(frame);
+
+    Submit_desc submit_desc;
+
+    for (auto& cmd_buffer : frame.cmd_buffers) {
+        cmd_buffer->end();
+        submit_desc.cmd_buffers.push_back(cmd_buffer.get());
+    }
+
+    frame.fence->reset();
+    device_->submit({submit_desc}, frame.fence.get());
+
+    // advance to the next slot, it is waited for at the next frame.
+    frame_index_ = (frame_index_ + 1) % frames_.size();
+    ++frame_number_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Frame_allocation Frame_context::allocate(uint64_t size, uint64_t alignment)
+{
+    auto& frame = frames_[frame_index_];
+    auto& blocks = frame.transient_blocks;
+    uint64_t offset {0};
+
+    // move to the next block when an allocation doesn't fit in the current one.
+    while (frame.transient_index != blocks.size()) {
+        offset = (frame.transient_offset + alignment - 1) / alignment * alignment;
+
+        if (offset + size <= blocks[frame.transient_index].buffer->size())
+            break;
+
+        ++frame.transient_index;
+        frame.transient_offset = 0;
+    }
+
+    if (frame.transient_index == blocks.size()) {
+        try {
+            Buffer_desc buffer_desc {nullptr, max(size, transient_size_), Heap_type::upload};
+
+            blocks.push_back({device_->create(buffer_desc), nullptr});
+        }
+        catch (exception& e) {
+            throw runtime_error("fail to allocate a transient memory");
+        }
+
+        offset = 0;
+    }
+
+    auto& block = blocks[frame.transient_index];
+
+    // a block is mapped once per frame, it stays mapped until the frame is submitted.
+    if (!block.data)
+        block.data = static_cast<uint8_t*>(block.buffer->map());
+
+    frame.transient_offset = offset + size;
+
+    return {block.buffer.get(), offset, block.data + offset};
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Frame_context::init_frames_(const Frame_context_desc& desc)
+{
+    if (!desc.frame_count || !desc.cmd_buffer_count)
+        throw runtime_error("fail to create a frame context");
+
+    frames_.resize(desc.frame_count);
+
+    for (auto& frame : frames_) {
+        for (auto i = 0; i != desc.cmd_buffer_count; ++i)
+            frame.cmd_buffers.push_back(device_->create(Cmd_buffer_desc {desc.queue_type}));
+
+        // a fence is signaled, so the first use of a slot doesn't block.
+        frame.fence = device_->create(Fence_desc {true});
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Frame_context::fini_frames_()
+{
+    for (auto& frame : frames_) {
+        unmap_transient_blocks_(frame);
+
+        if (!frame.fence->signaled())
+            frame.fence->wait_signal();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Frame_context::unmap_transient_blocks_(Frame& frame)
+{
+    for (auto& block : frame.transient_blocks) {
+        if (block.data) {
+            block.buffer->unmap();
+            block.data = nullptr;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
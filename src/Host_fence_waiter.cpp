@@ -0,0 +1,61 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include <chrono>
+#include <algorithm>
+#include "Host_fence_waiter.h"
+
+using namespace std;
+using namespace std::chrono;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Host_fence_waiter::Host_fence_waiter() :
+    mutex_ {},
+    signal_ {}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+bool Host_fence_waiter::wait(const std::vector<Fence*>& fences, bool wait_all, uint64_t timeout)
+{
+    if (fences.empty())
+        return true;
+
+    unique_lock<mutex> lock {mutex_};
+    auto satisfied = [&]() {
+        auto signaled = [](auto fence) { return fence->signaled(); };
+
+        return wait_all ? all_of(fences.begin(), fences.end(), signaled) :
+                          any_of(fences.begin(), fences.end(), signaled);
+    };
+
+    if (UINT64_MAX == timeout) {
+        signal_.wait(lock, satisfied);
+
+        return true;
+    }
+
+    return signal_.wait_for(lock, nanoseconds(min(timeout, uint64_t(INT64_MAX))), satisfied);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Host_fence_waiter::notify()
+{
+    // a lock orders a signaled flag before a waiter checks it again, so a wake up is never lost.
+    {
+        lock_guard<mutex> lock {mutex_};
+    }
+
+    signal_.notify_all();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
@@ -0,0 +1,36 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_HOST_FENCE_WAITER_GUARD
+#define GFX_HOST_FENCE_WAITER_GUARD
+
+#include <cstdint>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include "Fence.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Host_fence_waiter final {
+public:
+    Host_fence_waiter();
+
+    bool wait(const std::vector<Fence*>& fences, bool wait_all, uint64_t timeout = UINT64_MAX);
+
+    void notify();
+
+private:
+    std::mutex mutex_;
+    std::condition_variable signal_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_HOST_FENCE_WAITER_GUARD
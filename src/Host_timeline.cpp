@@ -0,0 +1,74 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include <chrono>
+#include "std_lib.h"
+#include "Host_timeline.h"
+
+using namespace std;
+using namespace std::chrono;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Host_timeline::Host_timeline(const Timeline_desc& desc, Device* device) :
+    Timeline {},
+    device_ {device},
+    mutex_ {},
+    signal_ {},
+    value_ {desc.value}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+bool Host_timeline::wait(uint64_t value, uint64_t timeout)
+{
+    unique_lock<mutex> lock {mutex_};
+    auto reached = [=]() { return value_ >= value; };
+
+    if (UINT64_MAX == timeout) {
+        signal_.wait(lock, reached);
+
+        return true;
+    }
+
+    return signal_.wait_for(lock, nanoseconds(timeout), reached);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Host_timeline::signal(uint64_t value)
+{
+    {
+        lock_guard<mutex> lock {mutex_};
+
+        // a timeline value never decreases.
+        value_ = max(value_, value);
+    }
+
+    signal_.notify_all();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Device* Host_timeline::device() const
+{
+    return device_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+uint64_t Host_timeline::value() const
+{
+    lock_guard<mutex> lock {mutex_};
+
+    return value_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
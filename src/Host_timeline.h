@@ -0,0 +1,40 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_HOST_TIMELINE_GUARD
+#define GFX_HOST_TIMELINE_GUARD
+
+#include <mutex>
+#include <condition_variable>
+#include "Timeline.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Host_timeline final : public Timeline {
+public:
+    Host_timeline(const Timeline_desc& desc, Device* device);
+
+    bool wait(uint64_t value, uint64_t timeout = UINT64_MAX) override;
+
+    void signal(uint64_t value) override;
+
+    Device* device() const override;
+
+    uint64_t value() const override;
+
+private:
+    Device* device_;
+    mutable std::mutex mutex_;
+    std::condition_variable signal_;
+    uint64_t value_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_HOST_TIMELINE_GUARD
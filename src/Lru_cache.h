@@ -57,6 +57,20 @@ public:
         return std::end(pool_) != pool_.find(key);
     }
 
+    template<typename F>
+    void erase_if(F predicate)
+    {
+        for (auto iter = std::begin(history_); iter != std::end(history_);) {
+            if (predicate(*pool_[*iter])) {
+                pool_.erase(*iter);
+                iter = history_.erase(iter);
+            }
+            else {
+                ++iter;
+            }
+        }
+    }
+
     void clear()
     {
         pool_.clear();
@@ -22,6 +22,8 @@ auto to_Pipeline_stage(Shader_type type)
             return Pipeline_stage::vertex_shader;
         case Shader_type::fragment:
             return Pipeline_stage::fragment_shader;
+        case Shader_type::compute:
+            return Pipeline_stage::compute_shader;
         default:
             throw runtime_error("invalid Shader_type");
     }
@@ -43,9 +45,28 @@ Pipeline::Pipeline(const Pipeline_desc& desc) :
     depth_stencil_ {desc.depth_stencil},
     color_blend_ {desc.color_blend},
     output_merger_ {desc.output_merger},
+    work_group_size_ {1, 1, 1},
     reflection_ {}
 {
     init_reflection_({desc.vertex_shader, desc.fragment_shader});
+    init_push_constant_reflection_(desc.push_constant_size);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Pipeline::Pipeline(const Compute_pipeline_desc& desc) :
+    vertex_input_ {},
+    input_assembly_ {},
+    rasterization_ {},
+    multisample_ {},
+    depth_stencil_ {},
+    color_blend_ {},
+    output_merger_ {},
+    work_group_size_ {desc.work_group_size},
+    reflection_ {}
+{
+    init_reflection_({desc.compute_shader});
+    init_storage_reflection_(desc.storage_buffers, desc.storage_images);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -80,4 +101,41 @@ void Pipeline::init_reflection_(const std::vector<Shader*> shaders)
 
 //----------------------------------------------------------------------------------------------------------------------
 
+void Pipeline::init_storage_reflection_(const std::vector<uint32_t>& buffers, const std::vector<uint32_t>& images)
+{
+    // storage bindings are declared by a desc, they are never bound as uniform buffers or sampled textures.
+    for (auto binding : buffers) {
+        if (max_storage_buffers <= binding)
+            throw runtime_error("fail to create a pipeline");
+
+        reflection_.buffers.erase(binding);
+        reflection_.storage_buffers[binding] = etoi(Pipeline_stage::compute_shader);
+    }
+
+    for (auto binding : images) {
+        if (max_storage_images <= binding)
+            throw runtime_error("fail to create a pipeline");
+
+        reflection_.textures.erase(binding);
+        reflection_.storage_images[binding] = etoi(Pipeline_stage::compute_shader);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Pipeline::init_push_constant_reflection_(uint32_t size)
+{
+    if (!size)
+        return;
+
+    // a push constant block is declared by a desc, it is visible to every stage of a pipeline.
+    if (max_push_constant_size < size || size % 4)
+        throw runtime_error("fail to create a pipeline");
+
+    reflection_.push_constants.stages = etoi(Pipeline_stage::vertex_shader) | etoi(Pipeline_stage::fragment_shader);
+    reflection_.push_constants.size = size;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 } // of namespace Gfx_lib
@@ -0,0 +1,28 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "Cpu_bind_group.h"
+#include "Cpu_device.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cpu_bind_group::Cpu_bind_group(const Bind_group_desc& desc, Cpu_device* device) :
+    Bind_group {desc},
+    device_ {device}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Device* Cpu_bind_group::device() const
+{
+    return device_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
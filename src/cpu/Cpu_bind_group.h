@@ -0,0 +1,33 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_CPU_BIND_GROUP_GUARD
+#define GFX_CPU_BIND_GROUP_GUARD
+
+#include "Bind_group.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Cpu_device;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Cpu_bind_group final : public Bind_group {
+public:
+    Cpu_bind_group(const Bind_group_desc& desc, Cpu_device* device);
+
+    Device* device() const override;
+
+private:
+    Cpu_device* device_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_CPU_BIND_GROUP_GUARD
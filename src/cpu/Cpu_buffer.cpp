@@ -0,0 +1,58 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include <cstring>
+#include "std_lib.h"
+#include "Cpu_buffer.h"
+#include "Cpu_device.h"
+
+using namespace std;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cpu_buffer::Cpu_buffer(const Buffer_desc& desc, Cpu_device* device) :
+    Buffer {desc},
+    device_ {device},
+    contents_ {}
+{
+    init_contents_(desc.data);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void* Cpu_buffer::map()
+{
+    return contents_.get();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_buffer::unmap()
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Device* Cpu_buffer::device() const
+{
+    return device_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_buffer::init_contents_(const void* data)
+{
+    // every heap lives in the system memory.
+    contents_ = make_unique<uint8_t[]>(size_);
+
+    if (data)
+        memcpy(contents_.get(), data, size_);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
@@ -0,0 +1,45 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_CPU_BUFFER_GUARD
+#define GFX_CPU_BUFFER_GUARD
+
+#include <memory>
+#include "Buffer.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Cpu_device;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Cpu_buffer final : public Buffer {
+public:
+    Cpu_buffer(const Buffer_desc& desc, Cpu_device* device);
+
+    void* map() override;
+
+    void unmap() override;
+
+    Device* device() const override;
+
+    inline auto data() const noexcept
+    { return contents_.get(); }
+
+private:
+    void init_contents_(const void* data);
+
+private:
+    Cpu_device* device_;
+    std::unique_ptr<uint8_t[]> contents_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_CPU_BUFFER_GUARD
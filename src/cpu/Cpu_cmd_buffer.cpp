@@ -0,0 +1,433 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "std_lib.h"
+#include "Cpu_cmd_buffer.h"
+#include "Cpu_device.h"
+#include "Cpu_buffer.h"
+#include "Cpu_image.h"
+#include "Cpu_pipeline.h"
+
+using namespace std;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template<typename F>
+inline void for_each_row(Cpu_image* image, const Buffer_image_copy_region& region, F func)
+{
+    auto texel_size = image->texel_size();
+    auto row_size = (region.buffer_row_size ? region.buffer_row_size : region.image_extent.w) * texel_size;
+    auto image_height = region.buffer_image_height ? region.buffer_image_height : region.image_extent.h;
+    auto& subresource = region.image_subresource;
+    auto& offset = region.image_offset;
+
+    for (auto z = 0; z != region.image_extent.d; ++z) {
+        auto data = image->data(subresource.mip_level, subresource.array_layer + offset.z + z);
+
+        for (auto y = 0; y != region.image_extent.h; ++y) {
+            func(data + (offset.y + y) * image->row_pitch(subresource.mip_level) + offset.x * texel_size,
+                 region.buffer_offset + (z * image_height + y) * row_size,
+                 region.image_extent.w * texel_size);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cpu_render_encoder::Cpu_render_encoder(const Render_encoder_desc& desc, Cpu_device* device,
+                                       Cpu_cmd_buffer* cmd_buffer) :
+    Render_encoder {},
+    device_ {device},
+    cmd_buffer_ {cmd_buffer},
+    primary_encoder_ {nullptr},
+    render_pass_ {},
+    draw_ {}
+{
+    init_render_pass_(desc);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cpu_render_encoder::Cpu_render_encoder(Cpu_render_encoder* primary_encoder) :
+    Render_encoder {},
+    device_ {primary_encoder->device_},
+    cmd_buffer_ {primary_encoder->cmd_buffer_},
+    primary_encoder_ {primary_encoder},
+    render_pass_ {primary_encoder->render_pass_},
+    draw_ {primary_encoder->draw_}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_render_encoder::end()
+{
+    // draws are merged into the primary's render pass by the parallel render encoder.
+    if (primary_encoder_)
+        return;
+
+    cmd_buffer_->record([rasterizer = device_->rasterizer(), render_pass = move(render_pass_)]() {
+        rasterizer->draw(render_pass);
+    });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_render_encoder::draw(uint32_t count, uint32_t first, uint32_t instance_count, uint32_t first_instance)
+{
+    add_draw_(count, first, instance_count, first_instance, 0, false);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_render_encoder::draw_indexed(uint32_t count, uint32_t first, uint32_t instance_count,
+                                      uint32_t first_instance, int32_t base_vertex)
+{
+    add_draw_(count, first, instance_count, first_instance, base_vertex, true);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_render_encoder::draw_indirect(Buffer* buffer, uint64_t offset, uint32_t draw_count, uint32_t stride)
+{
+    add_indirect_draws_(buffer, offset, draw_count, stride, false);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_render_encoder::draw_indexed_indirect(Buffer* buffer, uint64_t offset, uint32_t draw_count, uint32_t stride)
+{
+    add_indirect_draws_(buffer, offset, draw_count, stride, true);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_render_encoder::vertex_buffer(Buffer* buffer, uint64_t offset, uint32_t index)
+{
+    draw_.vertex_streams[index] = {static_cast<Cpu_buffer*>(buffer), offset};
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_render_encoder::index_buffer(Buffer* buffer, uint64_t offset, Index_type index_type)
+{
+    draw_.index_stream = {static_cast<Cpu_buffer*>(buffer), offset, index_type};
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_render_encoder::shader_buffer(Buffer* buffer, uint32_t offset, uint32_t index)
+{
+    // shaders aren't executed, so resources aren't referenced.
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_render_encoder::shader_texture(Image* image, Sampler* sampler, uint32_t index)
+{
+    // shaders aren't executed, so resources aren't referenced.
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_render_encoder::shader_bytes(Pipeline_stage stage, uint32_t offset, const void* data, uint32_t size)
+{
+    // shaders aren't executed, so resources aren't referenced.
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_render_encoder::bind_group(uint32_t index, Bind_group* bind_group, const vector<uint32_t>& dynamic_offsets)
+{
+    bind_group->validate_binding(index, dynamic_offsets);
+
+    // shaders aren't executed, so resources aren't referenced.
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_render_encoder::pipeline(Pipeline* pipeline)
+{
+    draw_.pipeline = static_cast<Cpu_pipeline*>(pipeline);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_render_encoder::viewport(const Viewport& viewport)
+{
+    draw_.viewport = viewport;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_render_encoder::scissor(const Scissor& scissor)
+{
+    draw_.scissor = scissor;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cmd_buffer* Cpu_render_encoder::cmd_buffer() const
+{
+    return cmd_buffer_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_render_encoder::init_render_pass_(const Render_encoder_desc& desc)
+{
+    for (auto i = 0; i != max_color_attachments; ++i) {
+        auto& attachment = desc.colors[i];
+
+        if (!attachment.image)
+            continue;
+
+        render_pass_.colors[i] = {static_cast<Cpu_image*>(attachment.image),
+                                  attachment.load_op,
+                                  attachment.clear_value};
+        render_pass_.extent = attachment.image->extent();
+    }
+
+    if (auto& attachment = desc.depth_stencil; attachment.image) {
+        render_pass_.depth_stencil = {static_cast<Cpu_image*>(attachment.image),
+                                      attachment.load_op,
+                                      attachment.clear_value};
+        render_pass_.extent = attachment.image->extent();
+    }
+
+    // the default viewport and scissor cover the render area.
+    auto& extent = render_pass_.extent;
+
+    draw_.viewport = {0.0f, 0.0f, static_cast<float>(extent.w), static_cast<float>(extent.h)};
+    draw_.scissor = {0, 0, extent.w, extent.h};
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_render_encoder::add_draw_(uint32_t count, uint32_t first, uint32_t instance_count,
+                                   uint32_t first_instance, int32_t base_vertex, bool indexed)
+{
+    assert(draw_.pipeline);
+
+    draw_.count = count;
+    draw_.first = first;
+    draw_.instance_count = instance_count;
+    draw_.first_instance = first_instance;
+    draw_.base_vertex = base_vertex;
+    draw_.indexed = indexed;
+
+    render_pass_.draws.push_back(draw_);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_render_encoder::add_indirect_draws_(Buffer* buffer, uint64_t offset, uint32_t draw_count, uint32_t stride,
+                                             bool indexed)
+{
+    assert(draw_.pipeline);
+
+    auto draw = draw_;
+
+    draw.indexed = indexed;
+    draw.indirect_buffer = static_cast<Cpu_buffer*>(buffer);
+
+    for (uint32_t i = 0; i != draw_count; ++i) {
+        draw.indirect_offset = offset + i * stride;
+        render_pass_.draws.push_back(draw);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cpu_parallel_render_encoder::Cpu_parallel_render_encoder(const Parallel_render_encoder_desc& desc,
+                                                         Cpu_device* device, Cpu_cmd_buffer* cmd_buffer) :
+    Parallel_render_encoder {},
+    cmd_buffer_ {cmd_buffer},
+    encoder_ {desc.render_encoder, device, cmd_buffer},
+    encoders_ {},
+    mutex_ {}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Render_encoder* Cpu_parallel_render_encoder::render_encoder()
+{
+    lock_guard<mutex> lock {mutex_};
+
+    encoders_.push_back(make_unique<Cpu_render_encoder>(&encoder_));
+
+    return encoders_.back().get();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_parallel_render_encoder::end()
+{
+    auto& draws = encoder_.render_pass_.draws;
+
+    // draws of encoders are rasterized in the order of their creation.
+    for (auto& encoder : encoders_)
+        draws.insert(draws.end(), encoder->render_pass_.draws.begin(), encoder->render_pass_.draws.end());
+
+    encoder_.end();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cmd_buffer* Cpu_parallel_render_encoder::cmd_buffer() const
+{
+    return cmd_buffer_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cpu_blit_encoder::Cpu_blit_encoder(const Blit_encoder_desc& desc, Cpu_device* device, Cpu_cmd_buffer* cmd_buffer) :
+    Blit_encoder {},
+    device_ {device},
+    cmd_buffer_ {cmd_buffer}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_blit_encoder::copy(Buffer* src_buffer, Buffer* dst_buffer, const Buffer_copy_region& region)
+{
+    auto src_buffer_impl = static_cast<Cpu_buffer*>(src_buffer);
+    auto dst_buffer_impl = static_cast<Cpu_buffer*>(dst_buffer);
+
+    cmd_buffer_->record([src_buffer_impl, dst_buffer_impl, region]() {
+        memmove(dst_buffer_impl->data() + region.dst_offset,
+                src_buffer_impl->data() + region.src_offset,
+                region.size);
+    });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_blit_encoder::copy(Buffer* src_buffer, Image* dst_image, const Buffer_image_copy_region& region)
+{
+    auto src_buffer_impl = static_cast<Cpu_buffer*>(src_buffer);
+    auto dst_image_impl = static_cast<Cpu_image*>(dst_image);
+
+    cmd_buffer_->record([src_buffer_impl, dst_image_impl, region]() {
+        for_each_row(dst_image_impl, region, [src_buffer_impl](uint8_t* data, uint64_t offset, uint64_t size) {
+            memcpy(data, src_buffer_impl->data() + offset, size);
+        });
+    });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_blit_encoder::copy(Image* src_image, Buffer* dst_buffer, const Buffer_image_copy_region& region)
+{
+    auto src_image_impl = static_cast<Cpu_image*>(src_image);
+    auto dst_buffer_impl = static_cast<Cpu_buffer*>(dst_buffer);
+
+    cmd_buffer_->record([src_image_impl, dst_buffer_impl, region]() {
+        for_each_row(src_image_impl, region, [dst_buffer_impl](uint8_t* data, uint64_t offset, uint64_t size) {
+            memcpy(dst_buffer_impl->data() + offset, data, size);
+        });
+    });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_blit_encoder::end()
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cmd_buffer* Cpu_blit_encoder::cmd_buffer() const
+{
+    return cmd_buffer_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cpu_cmd_buffer::Cpu_cmd_buffer(Cpu_device* device) :
+    Cmd_buffer {},
+    device_ {device},
+    cmds_ {}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Render_encoder> Cpu_cmd_buffer::create(const Render_encoder_desc& desc)
+{
+    return make_unique<Cpu_render_encoder>(desc, device_, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Parallel_render_encoder> Cpu_cmd_buffer::create(const Parallel_render_encoder_desc& desc)
+{
+    return make_unique<Cpu_parallel_render_encoder>(desc, device_, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Blit_encoder> Cpu_cmd_buffer::create(const Blit_encoder_desc& desc)
+{
+    return make_unique<Cpu_blit_encoder>(desc, device_, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Compute_encoder> Cpu_cmd_buffer::create(const Compute_encoder_desc& desc)
+{
+    throw runtime_error("fail to create a compute encoder");
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_cmd_buffer::end()
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_cmd_buffer::reset()
+{
+    cmds_.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Device* Cpu_cmd_buffer::device() const
+{
+    return device_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_cmd_buffer::record(std::function<void ()>&& cmd)
+{
+    cmds_.push_back(move(cmd));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_cmd_buffer::execute()
+{
+    for (auto& cmd : cmds_)
+        cmd();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
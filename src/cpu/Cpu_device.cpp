@@ -0,0 +1,200 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "std_lib.h"
+#include "Cpu_device.h"
+#include "Cpu_buffer.h"
+#include "Cpu_image.h"
+#include "Cpu_sampler.h"
+#include "Cpu_shader.h"
+#include "Cpu_pipeline.h"
+#include "Cpu_bind_group.h"
+#include "Cpu_swap_chain.h"
+#include "Cpu_cmd_buffer.h"
+#include "Cpu_fence.h"
+#include "Cpu_semaphore.h"
+#include "Host_timeline.h"
+
+using namespace std;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cpu_device::Cpu_device(const Device_desc& desc, uint32_t thread_count) :
+    Device(),
+    thread_pool_ {thread_count},
+    rasterizer_ {&thread_pool_},
+    mutex_ {},
+    fence_waiter_ {}
+{
+    init_adapter_(desc);
+    init_caps_();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::vector<Adapter> Cpu_device::enumerate()
+{
+    // shaders aren't executed, it is a fixed-function test rasterizer which is only created on request.
+    return {{0, "CPU fixed-function rasterizer", Adapter_type::cpu, 0, 1}};
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Buffer> Cpu_device::create(const Buffer_desc& desc)
+{
+    return make_unique<Cpu_buffer>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Image> Cpu_device::create(const Image_desc& desc)
+{
+    return make_unique<Cpu_image>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Sampler> Cpu_device::create(const Sampler_desc& desc)
+{
+    return make_unique<Cpu_sampler>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Shader> Cpu_device::create(const Shader_desc& desc)
+{
+    return make_unique<Cpu_shader>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Pipeline> Cpu_device::create(const Pipeline_desc& desc)
+{
+    return make_unique<Cpu_pipeline>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Pipeline> Cpu_device::create(const Compute_pipeline_desc& desc)
+{
+    // compute shaders can't be executed without a shader interpreter.
+    throw runtime_error("fail to create a pipeline");
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Bind_group> Cpu_device::create(const Bind_group_desc& desc)
+{
+    return make_unique<Cpu_bind_group>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Swap_chain> Cpu_device::create(const Swap_chain_desc& desc)
+{
+    return make_unique<Cpu_swap_chain>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Cmd_buffer> Cpu_device::create(const Cmd_buffer_desc& desc)
+{
+    return make_unique<Cpu_cmd_buffer>(this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Fence> Cpu_device::create(const Fence_desc& desc)
+{
+    return make_unique<Cpu_fence>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Semaphore> Cpu_device::create(const Semaphore_desc& desc)
+{
+    return make_unique<Cpu_semaphore>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Timeline> Cpu_device::create(const Timeline_desc& desc)
+{
+    return make_unique<Host_timeline>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_device::submit(Cmd_buffer* cmd_buffer, Fence* fence)
+{
+    // the rasterizer is shared, so submissions are executed one at a time.
+    {
+        lock_guard<mutex> lock {mutex_};
+
+        static_cast<Cpu_cmd_buffer*>(cmd_buffer)->execute();
+    }
+
+    if (fence)
+        static_cast<Cpu_fence*>(fence)->signal();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_device::submit(const std::vector<Submit_desc>& descs, Fence* fence)
+{
+    // submissions are executed in order, so semaphores are always satisfied.
+    {
+        lock_guard<mutex> lock {mutex_};
+
+        for (auto& desc : descs) {
+            for (auto cmd_buffer : desc.cmd_buffers)
+                static_cast<Cpu_cmd_buffer*>(cmd_buffer)->execute();
+
+            if (desc.timeline)
+                desc.timeline->signal(desc.timeline_value);
+        }
+    }
+
+    if (fence)
+        static_cast<Cpu_fence*>(fence)->signal();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+bool Cpu_device::wait(const std::vector<Fence*>& fences, bool wait_all, uint64_t timeout)
+{
+    // a waiter sleeps until a submit of another thread signals fences.
+    return fence_waiter_.wait(fences, wait_all, timeout);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_device::wait_idle()
+{
+    // submissions are executed synchronously, so the device is always idle.
+    lock_guard<mutex> lock {mutex_};
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_device::init_adapter_(const Device_desc& desc)
+{
+    backend_ = Backend::cpu;
+    adapter_ = select(enumerate(), desc);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_device::init_caps_()
+{
+    caps_.window_coords = Coords::origin_upper_left;
+    caps_.texture_coords = Coords::origin_upper_left;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
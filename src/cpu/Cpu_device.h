@@ -0,0 +1,82 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_CPU_DEVICE_GUARD
+#define GFX_CPU_DEVICE_GUARD
+
+#include <mutex>
+#include "Device.h"
+#include "Host_fence_waiter.h"
+#include "Cpu_thread_pool.h"
+#include "Cpu_rasterizer.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Cpu_device final : public Device {
+public:
+    explicit Cpu_device(const Device_desc& desc = {}, uint32_t thread_count = 0);
+
+    static std::vector<Adapter> enumerate();
+
+    std::unique_ptr<Buffer> create(const Buffer_desc& desc) override;
+
+    std::unique_ptr<Image> create(const Image_desc& desc) override;
+
+    std::unique_ptr<Sampler> create(const Sampler_desc& desc) override;
+
+    std::unique_ptr<Shader> create(const Shader_desc& desc) override;
+
+    std::unique_ptr<Pipeline> create(const Pipeline_desc& desc) override;
+
+    std::unique_ptr<Pipeline> create(const Compute_pipeline_desc& desc) override;
+
+    std::unique_ptr<Bind_group> create(const Bind_group_desc& desc) override;
+
+    std::unique_ptr<Swap_chain> create(const Swap_chain_desc& desc) override;
+
+    std::unique_ptr<Cmd_buffer> create(const Cmd_buffer_desc& desc) override;
+
+    std::unique_ptr<Fence> create(const Fence_desc& desc) override;
+
+    std::unique_ptr<Semaphore> create(const Semaphore_desc& desc) override;
+
+    std::unique_ptr<Timeline> create(const Timeline_desc& desc) override;
+
+    void submit(Cmd_buffer* cmd_buffer, Fence* fence = nullptr) override;
+
+    void submit(const std::vector<Submit_desc>& descs, Fence* fence = nullptr) override;
+
+    bool wait(const std::vector<Fence*>& fences, bool wait_all, uint64_t timeout = UINT64_MAX) override;
+
+    void wait_idle() override;
+
+    inline auto thread_pool() noexcept
+    { return &thread_pool_; }
+
+    inline auto rasterizer() noexcept
+    { return &rasterizer_; }
+
+    inline auto fence_waiter() noexcept
+    { return &fence_waiter_; }
+
+private:
+    void init_adapter_(const Device_desc& desc);
+
+    void init_caps_();
+
+private:
+    Cpu_thread_pool thread_pool_;
+    Cpu_rasterizer rasterizer_;
+    std::mutex mutex_;
+    Host_fence_waiter fence_waiter_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_CPU_DEVICE_GUARD
@@ -0,0 +1,59 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "Cpu_fence.h"
+#include "Cpu_device.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cpu_fence::Cpu_fence(const Fence_desc& desc, Cpu_device* device) :
+    Fence {},
+    device_ {device},
+    signaled_ {desc.signaled}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+bool Cpu_fence::wait_signal(uint64_t timeout)
+{
+    // a submit of another thread can still be in flight, so a waiter sleeps until it signals.
+    return device_->fence_waiter()->wait({this}, true, timeout);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_fence::reset()
+{
+    signaled_ = false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Device* Cpu_fence::device() const
+{
+    return device_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+bool Cpu_fence::signaled() const
+{
+    return signaled_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_fence::signal()
+{
+    signaled_ = true;
+    device_->fence_waiter()->notify();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
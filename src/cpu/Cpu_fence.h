@@ -0,0 +1,43 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_CPU_FENCE_GUARD
+#define GFX_CPU_FENCE_GUARD
+
+#include <atomic>
+#include "Fence.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Cpu_device;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Cpu_fence final : public Fence {
+public:
+    Cpu_fence(const Fence_desc& desc, Cpu_device* device);
+
+    bool wait_signal(uint64_t timeout = UINT64_MAX) override;
+
+    void reset() override;
+
+    Device* device() const override;
+
+    bool signaled() const override;
+
+    void signal();
+
+private:
+    Cpu_device* device_;
+    std::atomic<bool> signaled_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_CPU_FENCE_GUARD
@@ -0,0 +1,74 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "std_lib.h"
+#include "cpu_lib.h"
+#include "Cpu_image.h"
+#include "Cpu_device.h"
+
+using namespace std;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cpu_image::Cpu_image(const Image_desc& desc, Cpu_device* device) :
+    Image {desc},
+    device_ {device},
+    texel_size_ {Gfx_lib::texel_size(desc.format)},
+    offsets_ {},
+    contents_ {}
+{
+    init_contents_();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Device* Cpu_image::device() const
+{
+    return device_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+uint8_t* Cpu_image::data(uint32_t mip_level, uint32_t array_layer) noexcept
+{
+    return &contents_[offsets_[array_layer * mip_levels_ + mip_level]];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Extent Cpu_image::mip_extent(uint32_t mip_level) const noexcept
+{
+    return {max(extent_.w >> mip_level, 1u), max(extent_.h >> mip_level, 1u), 1};
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+uint32_t Cpu_image::row_pitch(uint32_t mip_level) const noexcept
+{
+    return mip_extent(mip_level).w * texel_size_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_image::init_contents_()
+{
+    uint64_t size {0};
+
+    // lay out every mip level of every array layer in a linear storage.
+    for (auto i = 0; i != array_layers_; ++i) {
+        for (auto j = 0; j != mip_levels_; ++j) {
+            offsets_.push_back(size);
+            size += row_pitch(j) * mip_extent(j).h;
+        }
+    }
+
+    contents_.resize(size);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
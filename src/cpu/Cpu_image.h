@@ -0,0 +1,49 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_CPU_IMAGE_GUARD
+#define GFX_CPU_IMAGE_GUARD
+
+#include <vector>
+#include "Image.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Cpu_device;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Cpu_image final : public Image {
+public:
+    Cpu_image(const Image_desc& desc, Cpu_device* device);
+
+    Device* device() const override;
+
+    uint8_t* data(uint32_t mip_level = 0, uint32_t array_layer = 0) noexcept;
+
+    Extent mip_extent(uint32_t mip_level) const noexcept;
+
+    uint32_t row_pitch(uint32_t mip_level) const noexcept;
+
+    inline auto texel_size() const noexcept
+    { return texel_size_; }
+
+private:
+    void init_contents_();
+
+private:
+    Cpu_device* device_;
+    uint32_t texel_size_;
+    std::vector<uint64_t> offsets_;
+    std::vector<uint8_t> contents_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_CPU_IMAGE_GUARD
@@ -0,0 +1,28 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "Cpu_pipeline.h"
+#include "Cpu_device.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cpu_pipeline::Cpu_pipeline(const Pipeline_desc& desc, Cpu_device* device) :
+    Pipeline {desc},
+    device_ {device}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Device* Cpu_pipeline::device() const
+{
+    return device_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
@@ -0,0 +1,33 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_CPU_PIPELINE_GUARD
+#define GFX_CPU_PIPELINE_GUARD
+
+#include "Pipeline.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Cpu_device;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Cpu_pipeline final : public Pipeline {
+public:
+    Cpu_pipeline(const Pipeline_desc& desc, Cpu_device* device);
+
+    Device* device() const override;
+
+private:
+    Cpu_device* device_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_CPU_PIPELINE_GUARD
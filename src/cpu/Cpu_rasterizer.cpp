@@ -0,0 +1,785 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "std_lib.h"
+#include "cpu_lib.h"
+#include "Cpu_rasterizer.h"
+#include "Cmd_buffer.h"
+#include "Cpu_thread_pool.h"
+#include "Cpu_buffer.h"
+#include "Cpu_image.h"
+#include "Cpu_pipeline.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define GFX_CPU_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define GFX_CPU_NEON
+#endif
+
+using namespace std;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+constexpr auto w_epsilon {1.0e-5f};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+inline T lerp(const T& lhs, const T& rhs, float t) noexcept
+{
+    T result;
+
+    for (auto i = 0; i != lhs.size(); ++i)
+        result[i] = lhs[i] + (rhs[i] - lhs[i]) * t;
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline uint32_t restart_index(Index_type type) noexcept
+{
+    return Index_type::uint16 == type ? UINT16_MAX : UINT32_MAX;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline uint8_t write_stencil(uint8_t stencil, uint8_t value, uint32_t write_mask) noexcept
+{
+    return (stencil & ~write_mask) | (value & write_mask);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template<typename E>
+inline float edge_value(const E& edge, float x, float y) noexcept
+{
+    return edge.sign * (edge.dx * (y - edge.y) - edge.dy * (x - edge.x));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template<typename E>
+inline uint32_t coverage_mask(const std::array<E, 3>& edges, int32_t x, int32_t y) noexcept
+{
+    // evaluate the edge functions of four horizontally adjacent pixel centers at once.
+#if defined(GFX_CPU_SSE2)
+    const auto px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f));
+    const auto py = _mm_set1_ps(y + 0.5f);
+    const auto zero = _mm_setzero_ps();
+    auto mask = _mm_cmpeq_ps(zero, zero);
+
+    for (auto& edge : edges) {
+        auto value = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(edge.dx), _mm_sub_ps(py, _mm_set1_ps(edge.y))),
+                                _mm_mul_ps(_mm_set1_ps(edge.dy), _mm_sub_ps(px, _mm_set1_ps(edge.x))));
+
+        value = _mm_mul_ps(value, _mm_set1_ps(edge.sign));
+        mask = _mm_and_ps(mask, edge.top_left ? _mm_cmpge_ps(value, zero) : _mm_cmpgt_ps(value, zero));
+    }
+
+    return static_cast<uint32_t>(_mm_movemask_ps(mask));
+#elif defined(GFX_CPU_NEON)
+    const float offsets[4] {0.5f, 1.5f, 2.5f, 3.5f};
+    const auto px = vaddq_f32(vdupq_n_f32(static_cast<float>(x)), vld1q_f32(offsets));
+    const auto py = vdupq_n_f32(y + 0.5f);
+    const auto zero = vdupq_n_f32(0.0f);
+    auto mask = vdupq_n_u32(UINT32_MAX);
+
+    for (auto& edge : edges) {
+        auto value = vsubq_f32(vmulq_f32(vdupq_n_f32(edge.dx), vsubq_f32(py, vdupq_n_f32(edge.y))),
+                               vmulq_f32(vdupq_n_f32(edge.dy), vsubq_f32(px, vdupq_n_f32(edge.x))));
+
+        value = vmulq_f32(value, vdupq_n_f32(edge.sign));
+        mask = vandq_u32(mask, edge.top_left ? vcgeq_f32(value, zero) : vcgtq_f32(value, zero));
+    }
+
+    uint32_t lanes[4];
+
+    vst1q_u32(lanes, mask);
+
+    return (lanes[0] & 0x1) | (lanes[1] & 0x2) | (lanes[2] & 0x4) | (lanes[3] & 0x8);
+#else
+    uint32_t mask {0};
+
+    for (auto i = 0; i != 4; ++i) {
+        auto inside = true;
+
+        for (auto& edge : edges) {
+            auto value = edge_value(edge, x + i + 0.5f, y + 0.5f);
+
+            inside &= edge.top_left ? value >= 0.0f : value > 0.0f;
+        }
+
+        mask |= inside << i;
+    }
+
+    return mask;
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cpu_draw to_direct_draw(const Cpu_draw& draw)
+{
+    auto result = draw;
+    auto data = draw.indirect_buffer->data() + draw.indirect_offset;
+
+    if (draw.indexed) {
+        Draw_indexed_indirect_args args;
+
+        memcpy(&args, data, sizeof(Draw_indexed_indirect_args));
+
+        result.count = args.count;
+        result.instance_count = args.instance_count;
+        result.first = args.first;
+        result.first_instance = args.first_instance;
+        result.base_vertex = args.base_vertex;
+    }
+    else {
+        Draw_indirect_args args;
+
+        memcpy(&args, data, sizeof(Draw_indirect_args));
+
+        result.count = args.count;
+        result.instance_count = args.instance_count;
+        result.first = args.first;
+        result.first_instance = args.first_instance;
+    }
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cpu_rasterizer::Cpu_rasterizer(Cpu_thread_pool* thread_pool) :
+    thread_pool_ {thread_pool},
+    extent_ {0, 0, 1},
+    tile_cols_ {0},
+    tile_rows_ {0},
+    states_ {},
+    triangles_ {},
+    bins_ {}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_rasterizer::draw(const Cpu_render_pass& render_pass)
+{
+    extent_ = render_pass.extent;
+    tile_cols_ = (extent_.w + cpu_tile_size - 1) / cpu_tile_size;
+    tile_rows_ = (extent_.h + cpu_tile_size - 1) / cpu_tile_size;
+
+    // transform and bin every primitive, the order of a bin is the submission order.
+    set_up_bins_(render_pass);
+
+    // tiles don't overlap, so they can be rasterized in any order on any thread.
+    thread_pool_->parallel_for(tile_cols_ * tile_rows_, [&](uint32_t tile) {
+        clear_(render_pass, tile);
+        raster_(render_pass, tile);
+    });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_rasterizer::set_up_bins_(const Cpu_render_pass& render_pass)
+{
+    states_.clear();
+    triangles_.clear();
+    bins_.resize(tile_cols_ * tile_rows_);
+
+    for (auto& bin : bins_)
+        bin.clear();
+
+    // arguments of an indirect draw are read when a render pass is executed.
+    for (auto& draw : render_pass.draws)
+        set_up_triangles_(draw.indirect_buffer ? to_direct_draw(draw) : draw);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_rasterizer::set_up_triangles_(const Cpu_draw& draw)
+{
+    auto pipeline = draw.pipeline;
+
+    states_.push_back({pipeline->vertex_input(),
+                       pipeline->input_assembly(),
+                       pipeline->rasterization(),
+                       pipeline->depth_stencil(),
+                       pipeline->color_blend()});
+
+    auto& input_assembly = states_.back().input_assembly;
+    array<Vertex, 3> vertices;
+    uint32_t vertex_count;
+    uint32_t triangle_count;
+
+    for (uint32_t j = 0; j != draw.instance_count; ++j) {
+        auto instance = draw.first_instance + j;
+
+        // each instance assembles its primitives from the start.
+        vertex_count = 0;
+        triangle_count = 0;
+
+        for (uint32_t i = 0; i != draw.count; ++i) {
+            auto index = draw.indexed ? fetch_index_(draw, i) : draw.first + i;
+
+            // a restart index begins a new strip.
+            if (draw.indexed && input_assembly.restart && restart_index(draw.index_stream.index_type) == index) {
+                vertex_count = 0;
+                triangle_count = 0;
+                continue;
+            }
+
+            // a base vertex offsets indices after a restart index is checked.
+            auto vertex = fetch_vertex_(draw, index + draw.base_vertex, instance);
+
+            switch (input_assembly.topology) {
+                case Topology::point:
+                    add_point_(draw, vertex);
+                    break;
+                case Topology::triangle_list:
+                    vertices[vertex_count++] = vertex;
+
+                    if (3 == vertex_count) {
+                        clip_triangle_(draw, vertices);
+                        vertex_count = 0;
+                    }
+                    break;
+                case Topology::triangle_strip:
+                    if (2 > vertex_count) {
+                        vertices[vertex_count++] = vertex;
+                    }
+                    else {
+                        vertices[2] = vertex;
+
+                        // odd triangles swap the first two vertices to keep a winding order.
+                        if (triangle_count++ % 2)
+                            clip_triangle_(draw, {vertices[1], vertices[0], vertices[2]});
+                        else
+                            clip_triangle_(draw, vertices);
+
+                        vertices[0] = vertices[1];
+                        vertices[1] = vertices[2];
+                    }
+                    break;
+                default:
+                    throw runtime_error("invalid the topology");
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+uint32_t Cpu_rasterizer::fetch_index_(const Cpu_draw& draw, uint32_t index) const
+{
+    auto& index_stream = draw.index_stream;
+    auto size = byte_size(index_stream.index_type);
+    auto data = index_stream.buffer->data() + index_stream.offset + (draw.first + index) * size;
+
+    if (Index_type::uint16 == index_stream.index_type) {
+        uint16_t value;
+
+        memcpy(&value, data, sizeof(uint16_t));
+
+        return value;
+    }
+    else {
+        uint32_t value;
+
+        memcpy(&value, data, sizeof(uint32_t));
+
+        return value;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cpu_rasterizer::Vertex Cpu_rasterizer::fetch_vertex_(const Cpu_draw& draw, uint32_t index, uint32_t instance) const
+{
+    auto& vertex_input = states_.back().vertex_input;
+    Vertex vertex {{0.0f, 0.0f, 0.0f, 1.0f}, {1.0f, 1.0f, 1.0f, 1.0f}};
+
+    // the location 0 is a clip space position and the location 1 is a color.
+    for (auto i = 0; i != 2; ++i) {
+        auto& attribute = vertex_input.attributes[i];
+
+        if (UINT32_MAX == attribute.binding || Format::invalid == attribute.format)
+            continue;
+
+        auto& vertex_stream = draw.vertex_streams[attribute.binding];
+
+        if (!vertex_stream.buffer)
+            continue;
+
+        auto& binding = vertex_input.bindings[attribute.binding];
+        auto element = Step_rate::vertex == binding.step_rate ? index : instance;
+        auto data = vertex_stream.buffer->data() + vertex_stream.offset + element * binding.stride + attribute.offset;
+
+        if (0 == i)
+            vertex.position = to_Cpu_color(attribute.format, data);
+        else
+            vertex.color = to_Cpu_color(attribute.format, data);
+    }
+
+    return vertex;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_rasterizer::clip_triangle_(const Cpu_draw& draw, const std::array<Vertex, 3>& vertices)
+{
+    auto& rasterization = states_.back().rasterization;
+
+    // clip against w > 0 and, unless a depth is clamped, against the near plane z > 0.
+    auto distance = [&](const Vertex& vertex, uint32_t plane) {
+        return plane ? vertex.position[2] : vertex.position[3] - w_epsilon;
+    };
+
+    auto plane_count = rasterization.depth_clamp ? 1u : 2u;
+    auto inside = true;
+
+    for (auto& vertex : vertices) {
+        for (auto i = 0; i != plane_count; ++i)
+            inside &= distance(vertex, i) >= 0.0f;
+    }
+
+    if (inside) {
+        add_triangle_(draw, vertices);
+        return;
+    }
+
+    array<Vertex, 9> polygon {vertices[0], vertices[1], vertices[2]};
+    array<Vertex, 9> clipped;
+    uint32_t count {3};
+
+    for (auto i = 0; i != plane_count; ++i) {
+        uint32_t clipped_count {0};
+
+        for (auto j = 0; j != count; ++j) {
+            auto& curr = polygon[j];
+            auto& next = polygon[(j + 1) % count];
+            auto curr_distance = distance(curr, i);
+            auto next_distance = distance(next, i);
+
+            if (curr_distance >= 0.0f)
+                clipped[clipped_count++] = curr;
+
+            if ((curr_distance >= 0.0f) != (next_distance >= 0.0f)) {
+                auto t = curr_distance / (curr_distance - next_distance);
+
+                clipped[clipped_count++] = {lerp(curr.position, next.position, t), lerp(curr.color, next.color, t)};
+            }
+        }
+
+        polygon = clipped;
+        count = clipped_count;
+    }
+
+    for (auto i = 1; i + 1 < count; ++i)
+        add_triangle_(draw, {polygon[0], polygon[i], polygon[i + 1]});
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_rasterizer::add_point_(const Cpu_draw& draw, const Vertex& vertex)
+{
+    if (vertex.position[3] <= w_epsilon)
+        return;
+
+    Triangle triangle {};
+
+    triangle.vertices[0] = vertex;
+    triangle.point = true;
+    triangle.front = true;
+    triangle.state = states_.size() - 1;
+
+    // apply the perspective division and the viewport transformation.
+    auto& viewport = draw.viewport;
+    auto& position = triangle.vertices[0].position;
+    auto inv_w = 1.0f / position[3];
+
+    position[0] = viewport.x + viewport.w * 0.5f * (position[0] * inv_w + 1.0f);
+    position[1] = viewport.h * 0.5f - viewport.y - viewport.h * 0.5f * position[1] * inv_w;
+    position[2] = position[2] * inv_w;
+    position[3] = 1.0f;
+
+    auto x = static_cast<int32_t>(floor(position[0]));
+    auto y = static_cast<int32_t>(floor(position[1]));
+
+    triangle.bounds = {x, y, x + 1, y + 1};
+
+    bin_(draw, triangle);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_rasterizer::add_triangle_(const Cpu_draw& draw, const std::array<Vertex, 3>& vertices)
+{
+    auto& state = states_.back();
+    auto& viewport = draw.viewport;
+    Triangle triangle {};
+
+    triangle.vertices = vertices;
+    triangle.state = states_.size() - 1;
+
+    // apply the perspective division and the viewport transformation, the viewport is flipped like vulkan.
+    for (auto& vertex : triangle.vertices) {
+        auto inv_w = 1.0f / vertex.position[3];
+
+        vertex.position[0] = viewport.x + viewport.w * 0.5f * (vertex.position[0] * inv_w + 1.0f);
+        vertex.position[1] = viewport.h * 0.5f - viewport.y - viewport.h * 0.5f * vertex.position[1] * inv_w;
+        vertex.position[2] = vertex.position[2] * inv_w;
+        vertex.position[3] = inv_w;
+
+        // store perspective correct attributes.
+        for (auto& component : vertex.color)
+            component *= inv_w;
+    }
+
+    // determine a facing and cull.
+    auto& v = triangle.vertices;
+    auto facing = 0.0f;
+
+    for (auto i = 0; i != 3; ++i) {
+        auto j = (i + 1) % 3;
+
+        facing -= v[i].position[0] * v[j].position[1] - v[j].position[0] * v[i].position[1];
+    }
+
+    if (0.0f == facing)
+        return;
+
+    triangle.front = Front_face::counter_clockwise == state.rasterization.front_face ? facing > 0.0f : facing < 0.0f;
+
+    if ((Cull_mode::front == state.rasterization.cull_mode && triangle.front) ||
+        (Cull_mode::back == state.rasterization.cull_mode && !triangle.front))
+        return;
+
+    // set up edges in a canonical direction, so edges shared by triangles are evaluated identically.
+    for (auto i = 0; i != 3; ++i) {
+        auto p = &v[(i + 1) % 3].position;
+        auto q = &v[(i + 2) % 3].position;
+        auto& edge = triangle.edges[i];
+
+        edge.sign = 1.0f;
+
+        if ((*q)[1] < (*p)[1] || ((*q)[1] == (*p)[1] && (*q)[0] < (*p)[0])) {
+            swap(p, q);
+            edge.sign = -1.0f;
+        }
+
+        edge.dx = (*q)[0] - (*p)[0];
+        edge.dy = (*q)[1] - (*p)[1];
+        edge.x = (*p)[0];
+        edge.y = (*p)[1];
+    }
+
+    triangle.area = edge_value(triangle.edges[0], v[0].position[0], v[0].position[1]);
+
+    if (0.0f == triangle.area)
+        return;
+
+    if (0.0f > triangle.area) {
+        for (auto& edge : triangle.edges)
+            edge.sign = -edge.sign;
+
+        triangle.area = -triangle.area;
+    }
+
+    // decide an owner of pixels lying exactly on an edge.
+    for (auto& edge : triangle.edges) {
+        auto dx = edge.sign * edge.dx;
+        auto dy = edge.sign * edge.dy;
+
+        edge.top_left = dy > 0.0f || (dy == 0.0f && dx < 0.0f);
+    }
+
+    // calculate a depth bias.
+    if (state.rasterization.depth_bias) {
+        auto dzdx = 0.0f;
+        auto dzdy = 0.0f;
+
+        for (auto i = 0; i != 3; ++i) {
+            auto& edge = triangle.edges[i];
+
+            dzdx -= v[i].position[2] * edge.sign * edge.dy / triangle.area;
+            dzdy += v[i].position[2] * edge.sign * edge.dx / triangle.area;
+        }
+
+        auto bias = state.rasterization.depth_bias_constant_factor / 0xFFFFFF +
+                    state.rasterization.depth_bias_slope_factor * max(abs(dzdx), abs(dzdy));
+        auto clamp = state.rasterization.depth_bias_clamp;
+
+        if (0.0f < clamp)
+            bias = min(bias, clamp);
+        else if (0.0f > clamp)
+            bias = max(bias, clamp);
+
+        triangle.depth_bias = bias;
+    }
+
+    // calculate a bounding box.
+    auto min_x = min({v[0].position[0], v[1].position[0], v[2].position[0]});
+    auto min_y = min({v[0].position[1], v[1].position[1], v[2].position[1]});
+    auto max_x = max({v[0].position[0], v[1].position[0], v[2].position[0]});
+    auto max_y = max({v[0].position[1], v[1].position[1], v[2].position[1]});
+
+    triangle.bounds = {static_cast<int32_t>(floor(max(min_x, -1.0f))),
+                       static_cast<int32_t>(floor(max(min_y, -1.0f))),
+                       static_cast<int32_t>(ceil(min(max_x, static_cast<float>(extent_.w)))),
+                       static_cast<int32_t>(ceil(min(max_y, static_cast<float>(extent_.h))))};
+
+    bin_(draw, triangle);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_rasterizer::bin_(const Cpu_draw& draw, const Triangle& triangle)
+{
+    auto& scissor = draw.scissor;
+    auto triangle_impl = triangle;
+    auto& bounds = triangle_impl.bounds;
+
+    // clamp to the scissor and the render area.
+    bounds[0] = max({bounds[0], static_cast<int32_t>(scissor.x), 0});
+    bounds[1] = max({bounds[1], static_cast<int32_t>(scissor.y), 0});
+    bounds[2] = min({bounds[2], static_cast<int32_t>(scissor.x + scissor.w), static_cast<int32_t>(extent_.w)});
+    bounds[3] = min({bounds[3], static_cast<int32_t>(scissor.y + scissor.h), static_cast<int32_t>(extent_.h)});
+    if (bounds[0] >= bounds[2] || bounds[1] >= bounds[3])
+        return;
+
+    auto index = static_cast<uint32_t>(triangles_.size());
+
+    triangles_.push_back(triangle_impl);
+
+    for (auto y = bounds[1] / cpu_tile_size; y <= (bounds[3] - 1) / cpu_tile_size; ++y) {
+        for (auto x = bounds[0] / cpu_tile_size; x <= (bounds[2] - 1) / cpu_tile_size; ++x)
+            bins_[y * tile_cols_ + x].push_back(index);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_rasterizer::clear_(const Cpu_render_pass& render_pass, uint32_t tile)
+{
+    auto x0 = static_cast<int32_t>(tile % tile_cols_) * cpu_tile_size;
+    auto y0 = static_cast<int32_t>(tile / tile_cols_) * cpu_tile_size;
+    auto x1 = min(x0 + cpu_tile_size, static_cast<int32_t>(extent_.w));
+    auto y1 = min(y0 + cpu_tile_size, static_cast<int32_t>(extent_.h));
+
+    for (auto& color : render_pass.colors) {
+        if (!color.image || Load_op::clear != color.load_op)
+            continue;
+
+        auto image = color.image;
+        auto texel_size = image->texel_size();
+        array<uint8_t, 16> texel;
+
+        from_Cpu_color(image->format(),
+                       {color.clear_value.r, color.clear_value.g, color.clear_value.b, color.clear_value.a},
+                       &texel[0]);
+
+        for (auto y = y0; y != y1; ++y) {
+            auto data = image->data() + y * image->row_pitch(0) + x0 * texel_size;
+
+            for (auto x = x0; x != x1; ++x, data += texel_size)
+                memcpy(data, &texel[0], texel_size);
+        }
+    }
+
+    auto& depth_stencil = render_pass.depth_stencil;
+
+    if (depth_stencil.image && Load_op::clear == depth_stencil.load_op) {
+        auto image = depth_stencil.image;
+        auto value = to_d24s8(depth_stencil.clear_value.d, depth_stencil.clear_value.s);
+
+        for (auto y = y0; y != y1; ++y) {
+            auto data = image->data() + y * image->row_pitch(0) + x0 * sizeof(uint32_t);
+
+            for (auto x = x0; x != x1; ++x, data += sizeof(uint32_t))
+                memcpy(data, &value, sizeof(uint32_t));
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_rasterizer::raster_(const Cpu_render_pass& render_pass, uint32_t tile)
+{
+    auto x0 = static_cast<int32_t>(tile % tile_cols_) * cpu_tile_size;
+    auto y0 = static_cast<int32_t>(tile / tile_cols_) * cpu_tile_size;
+    auto x1 = x0 + cpu_tile_size;
+    auto y1 = y0 + cpu_tile_size;
+
+    for (auto index : bins_[tile]) {
+        auto& triangle = triangles_[index];
+        auto& bounds = triangle.bounds;
+        auto min_x = max(x0, bounds[0]);
+        auto min_y = max(y0, bounds[1]);
+        auto max_x = min(x1, bounds[2]);
+        auto max_y = min(y1, bounds[3]);
+
+        if (triangle.point) {
+            shade_(render_pass, triangle, min_x, min_y);
+            continue;
+        }
+
+        for (auto y = min_y; y < max_y; ++y) {
+            for (auto x = min_x; x < max_x; x += 4) {
+                auto mask = coverage_mask(triangle.edges, x, y);
+
+                // discard lanes outside of a tile.
+                if (4 > max_x - x)
+                    mask &= (0x1u << (max_x - x)) - 1;
+
+                for (auto i = 0; mask; ++i, mask >>= 1) {
+                    if (mask & 0x1)
+                        shade_(render_pass, triangle, x + i, y);
+                }
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_rasterizer::shade_(const Cpu_render_pass& render_pass, const Triangle& triangle, int32_t x, int32_t y)
+{
+    auto& state = states_[triangle.state];
+    auto& v = triangle.vertices;
+    array<float, 3> barycentrics {1.0f, 0.0f, 0.0f};
+
+    if (!triangle.point) {
+        for (auto i = 0; i != 3; ++i)
+            barycentrics[i] = edge_value(triangle.edges[i], x + 0.5f, y + 0.5f) / triangle.area;
+    }
+
+    // interpolate a depth.
+    auto z = triangle.depth_bias;
+
+    for (auto i = 0; i != 3; ++i)
+        z += barycentrics[i] * v[i].position[2];
+
+    if (state.rasterization.depth_clamp)
+        z = clamp(z, 0.0f, 1.0f);
+    else if (0.0f > z || 1.0f < z)
+        return;
+
+    // apply the stencil test and the depth test.
+    if (auto image = render_pass.depth_stencil.image; image) {
+        auto& depth_stencil = state.depth_stencil;
+        auto& stencil = triangle.front ? depth_stencil.front_stencil : depth_stencil.back_stencil;
+        auto data = image->data() + y * image->row_pitch(0) + x * sizeof(uint32_t);
+        uint32_t value;
+
+        memcpy(&value, data, sizeof(uint32_t));
+
+        auto depth = value & 0xFFFFFF;
+        auto stencil_value = static_cast<uint8_t>(value >> 24);
+        auto reference = static_cast<uint8_t>(stencil.referece);
+        auto passed = true;
+
+        if (depth_stencil.stencil_test) {
+            if (!compare(stencil.compare_op, reference & stencil.read_mask, stencil_value & stencil.read_mask)) {
+                stencil_value = write_stencil(stencil_value,
+                                              apply(stencil.stencil_fail_op, stencil_value, reference),
+                                              stencil.write_mask);
+                passed = false;
+            }
+        }
+
+        if (passed && depth_stencil.depth_test) {
+            if (!compare(depth_stencil.depth_compare_op, to_depth24(z), depth)) {
+                if (depth_stencil.stencil_test) {
+                    stencil_value = write_stencil(stencil_value,
+                                                  apply(stencil.depth_fail_op, stencil_value, reference),
+                                                  stencil.write_mask);
+                }
+
+                passed = false;
+            }
+        }
+
+        if (passed) {
+            if (depth_stencil.stencil_test) {
+                stencil_value = write_stencil(stencil_value,
+                                              apply(stencil.depth_stencil_pass_op, stencil_value, reference),
+                                              stencil.write_mask);
+            }
+
+            if (depth_stencil.depth_test && depth_stencil.write_mask)
+                depth = to_depth24(z);
+        }
+
+        value = (depth & 0xFFFFFF) | (stencil_value << 24);
+        memcpy(data, &value, sizeof(uint32_t));
+
+        if (!passed)
+            return;
+    }
+
+    // interpolate a color with the perspective correction.
+    auto inv_w = 0.0f;
+    Cpu_color color {0.0f, 0.0f, 0.0f, 0.0f};
+
+    for (auto i = 0; i != 3; ++i) {
+        inv_w += barycentrics[i] * v[i].position[3];
+
+        for (auto j = 0; j != 4; ++j)
+            color[j] += barycentrics[i] * v[i].color[j];
+    }
+
+    for (auto& component : color)
+        component /= inv_w;
+
+    // blend and write a color to each attachment.
+    for (auto i = 0; i != max_color_attachments; ++i) {
+        auto image = render_pass.colors[i].image;
+
+        if (!image)
+            continue;
+
+        auto& attachment = state.color_blend.attachments[i];
+        auto data = image->data() + y * image->row_pitch(0) + x * image->texel_size();
+        auto dst = to_Cpu_color(image->format(), data);
+        auto src = color;
+
+        if (attachment.blend) {
+            for (auto j = 0; j != 3; ++j) {
+                src[j] = blend(attachment.rgb_blend_op, color[j], dst[j],
+                               to_blend_factor(attachment.src_rgb_blend_factor, color[3], dst[3]),
+                               to_blend_factor(attachment.dst_rgb_blend_factor, color[3], dst[3]));
+            }
+
+            src[3] = blend(attachment.a_blend_op, color[3], dst[3],
+                           to_blend_factor(attachment.src_a_blend_factor, color[3], dst[3]),
+                           to_blend_factor(attachment.dst_a_blend_factor, color[3], dst[3]));
+        }
+
+        for (auto j = 0; j != 4; ++j) {
+            if (!(attachment.write_mask & (0x1 << j)))
+                src[j] = dst[j];
+        }
+
+        from_Cpu_color(image->format(), src, data);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
@@ -0,0 +1,159 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_CPU_RASTERIZER_GUARD
+#define GFX_CPU_RASTERIZER_GUARD
+
+#include <array>
+#include <vector>
+#include "limitations.h"
+#include "enums.h"
+#include "types.h"
+#include "Pipeline.h"
+#include "cpu_lib.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Cpu_buffer;
+class Cpu_image;
+class Cpu_pipeline;
+class Cpu_thread_pool;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+constexpr auto cpu_tile_size {64};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Cpu_vertex_stream final {
+    Cpu_buffer* buffer {nullptr};
+    uint64_t offset {0};
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Cpu_index_stream final {
+    Cpu_buffer* buffer {nullptr};
+    uint64_t offset {0};
+    Index_type index_type {Index_type::invalid};
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Cpu_attachment final {
+    Cpu_image* image {nullptr};
+    Load_op load_op {Load_op::dont_care};
+    Clear_value clear_value;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Cpu_draw final {
+    Cpu_pipeline* pipeline {nullptr};
+    std::array<Cpu_vertex_stream, max_vertex_input_bindings> vertex_streams;
+    Cpu_index_stream index_stream;
+    Viewport viewport;
+    Scissor scissor;
+    uint32_t count {0};
+    uint32_t first {0};
+    uint32_t instance_count {1};
+    uint32_t first_instance {0};
+    int32_t base_vertex {0};
+    bool indexed {false};
+    Cpu_buffer* indirect_buffer {nullptr};
+    uint64_t indirect_offset {0};
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Cpu_render_pass final {
+    std::array<Cpu_attachment, max_color_attachments> colors;
+    Cpu_attachment depth_stencil;
+    Extent extent {0, 0, 1};
+    std::vector<Cpu_draw> draws;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Cpu_rasterizer final {
+public:
+    explicit Cpu_rasterizer(Cpu_thread_pool* thread_pool);
+
+    void draw(const Cpu_render_pass& render_pass);
+
+private:
+    struct Vertex final {
+        std::array<float, 4> position;
+        Cpu_color color;
+    };
+
+    struct Edge final {
+        float dx;
+        float dy;
+        float x;
+        float y;
+        float sign;
+        bool top_left;
+    };
+
+    struct State final {
+        Vertex_input vertex_input;
+        Input_assembly input_assembly;
+        Rasterization rasterization;
+        Depth_stencil depth_stencil;
+        Color_blend color_blend;
+    };
+
+    struct Triangle final {
+        std::array<Vertex, 3> vertices;
+        std::array<Edge, 3> edges;
+        float area;
+        float depth_bias;
+        bool front;
+        bool point;
+        std::array<int32_t, 4> bounds;
+        uint32_t state;
+    };
+
+private:
+    void set_up_bins_(const Cpu_render_pass& render_pass);
+
+    void set_up_triangles_(const Cpu_draw& draw);
+
+    uint32_t fetch_index_(const Cpu_draw& draw, uint32_t index) const;
+
+    Vertex fetch_vertex_(const Cpu_draw& draw, uint32_t index, uint32_t instance) const;
+
+    void clip_triangle_(const Cpu_draw& draw, const std::array<Vertex, 3>& vertices);
+
+    void add_point_(const Cpu_draw& draw, const Vertex& vertex);
+
+    void add_triangle_(const Cpu_draw& draw, const std::array<Vertex, 3>& vertices);
+
+    void bin_(const Cpu_draw& draw, const Triangle& triangle);
+
+    void clear_(const Cpu_render_pass& render_pass, uint32_t tile);
+
+    void raster_(const Cpu_render_pass& render_pass, uint32_t tile);
+
+    void shade_(const Cpu_render_pass& render_pass, const Triangle& triangle, int32_t x, int32_t y);
+
+private:
+    Cpu_thread_pool* thread_pool_;
+    Extent extent_;
+    int32_t tile_cols_;
+    int32_t tile_rows_;
+    std::vector<State> states_;
+    std::vector<Triangle> triangles_;
+    std::vector<std::vector<uint32_t>> bins_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_CPU_RASTERIZER_GUARD
@@ -0,0 +1,28 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "Cpu_sampler.h"
+#include "Cpu_device.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cpu_sampler::Cpu_sampler(const Sampler_desc& desc, Cpu_device* device) :
+    Sampler {desc},
+    device_ {device}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Device* Cpu_sampler::device() const
+{
+    return device_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
@@ -0,0 +1,33 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_CPU_SAMPLER_GUARD
+#define GFX_CPU_SAMPLER_GUARD
+
+#include "Sampler.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Cpu_device;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Cpu_sampler final : public Sampler {
+public:
+    Cpu_sampler(const Sampler_desc& desc, Cpu_device* device);
+
+    Device* device() const override;
+
+private:
+    Cpu_device* device_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_CPU_SAMPLER_GUARD
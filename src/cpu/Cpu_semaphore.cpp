@@ -0,0 +1,28 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "Cpu_semaphore.h"
+#include "Cpu_device.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cpu_semaphore::Cpu_semaphore(const Semaphore_desc& desc, Cpu_device* device) :
+    Semaphore {},
+    device_ {device}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Device* Cpu_semaphore::device() const
+{
+    return device_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
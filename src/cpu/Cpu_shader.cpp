@@ -0,0 +1,48 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "std_lib.h"
+#include "Cpu_shader.h"
+#include "Cpu_device.h"
+
+using namespace std;
+using namespace Sc_lib;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cpu_shader::Cpu_shader(const Shader_desc& desc, Cpu_device* device) :
+    Shader {desc},
+    device_ {device},
+    signature_ {}
+{
+    init_signature_(desc.src);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Device* Cpu_shader::device() const
+{
+    return device_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Sc_lib::Signature Cpu_shader::reflect() const noexcept
+{
+    return signature_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_shader::init_signature_(const std::vector<uint32_t>& src)
+{
+    signature_ = Spirv_reflector().reflect(src);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
@@ -0,0 +1,39 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_CPU_SHADER_GUARD
+#define GFX_CPU_SHADER_GUARD
+
+#include "Shader.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Cpu_device;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Cpu_shader final : public Shader {
+public:
+    Cpu_shader(const Shader_desc& desc, Cpu_device* device);
+
+    Device* device() const override;
+
+    Sc_lib::Signature reflect() const noexcept override;
+
+private:
+    void init_signature_(const std::vector<uint32_t>& src);
+
+private:
+    Cpu_device* device_;
+    Sc_lib::Signature signature_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_CPU_SHADER_GUARD
@@ -0,0 +1,70 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "std_lib.h"
+#include "Cpu_swap_chain.h"
+#include "Cpu_device.h"
+#include "Cpu_image.h"
+
+using namespace std;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cpu_swap_chain::Cpu_swap_chain(const Swap_chain_desc& desc, Cpu_device* device) :
+    Swap_chain {desc},
+    device_ {device},
+    images_ {}
+{
+    init_images_(desc.image_count);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cpu_swap_chain::~Cpu_swap_chain()
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Image* Cpu_swap_chain::acquire()
+{
+    return images_[frame_count_ % images_.size()].get();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_swap_chain::present()
+{
+    ++frame_count_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Device* Cpu_swap_chain::device() const
+{
+    return device_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_swap_chain::init_images_(uint32_t count)
+{
+    // configure an image desc.
+    Image_desc desc;
+
+    desc.type = Image_type::swap_chain;
+    desc.format = image_format_;
+    desc.extent = image_extent_;
+
+    // create images.
+    for (auto i = 0; i != count; ++i)
+        images_.push_back(make_unique<Cpu_image>(desc, device_));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
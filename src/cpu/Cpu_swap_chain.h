@@ -0,0 +1,46 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_CPU_SWAP_CHAIN_GUARD
+#define GFX_CPU_SWAP_CHAIN_GUARD
+
+#include <memory>
+#include <vector>
+#include "Swap_chain.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Cpu_device;
+class Cpu_image;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Cpu_swap_chain final : public Swap_chain {
+public:
+    Cpu_swap_chain(const Swap_chain_desc& desc, Cpu_device* device);
+
+    ~Cpu_swap_chain() override;
+
+    Image* acquire() override;
+
+    void present() override;
+
+    Device* device() const override;
+
+private:
+    void init_images_(uint32_t count);
+
+private:
+    Cpu_device* device_;
+    std::vector<std::unique_ptr<Cpu_image>> images_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_CPU_SWAP_CHAIN_GUARD
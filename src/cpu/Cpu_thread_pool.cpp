@@ -0,0 +1,178 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "std_lib.h"
+#include "Cpu_thread_pool.h"
+
+using namespace std;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cpu_thread_pool::Cpu_thread_pool(uint32_t thread_count) :
+    queues_ {},
+    threads_ {},
+    mutex_ {},
+    work_cv_ {},
+    done_cv_ {},
+    func_ {nullptr},
+    remaining_ {0},
+    generation_ {0},
+    quit_ {false}
+{
+    init_threads_(thread_count);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cpu_thread_pool::~Cpu_thread_pool()
+{
+    fini_threads_();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_thread_pool::parallel_for(uint32_t count, const std::function<void (uint32_t)>& func)
+{
+    if (!count)
+        return;
+
+    // hand out contiguous ranges so neighbouring items stay on the same thread until stealing kicks in.
+    auto chunk = (count + thread_count() - 1) / thread_count();
+
+    func_ = &func;
+    remaining_ = count;
+
+    for (uint32_t i = 0; i != thread_count(); ++i) {
+        lock_guard<mutex> lock {queues_[i]->mutex};
+
+        for (auto item = i * chunk; item < min(count, (i + 1) * chunk); ++item)
+            queues_[i]->items.push_back(item);
+    }
+
+    {
+        lock_guard<mutex> lock {mutex_};
+        ++generation_;
+    }
+
+    work_cv_.notify_all();
+
+    // the calling thread works as the last worker.
+    work_(thread_count() - 1);
+
+    unique_lock<mutex> lock {mutex_};
+
+    done_cv_.wait(lock, [this]() { return !remaining_; });
+    func_ = nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_thread_pool::init_threads_(uint32_t thread_count)
+{
+    if (!thread_count)
+        thread_count = max(thread::hardware_concurrency(), 1u);
+
+    for (auto i = 0; i != thread_count; ++i)
+        queues_.push_back(make_unique<Queue>());
+
+    for (auto i = 0; i != thread_count - 1; ++i)
+        threads_.emplace_back(&Cpu_thread_pool::run_, this, i);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_thread_pool::fini_threads_()
+{
+    {
+        lock_guard<mutex> lock {mutex_};
+        quit_ = true;
+    }
+
+    work_cv_.notify_all();
+
+    for (auto& thread : threads_)
+        thread.join();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_thread_pool::run_(uint32_t index)
+{
+    uint64_t generation {0};
+
+    while (true) {
+        {
+            unique_lock<mutex> lock {mutex_};
+
+            work_cv_.wait(lock, [&]() { return quit_ || generation != generation_; });
+
+            if (quit_)
+                return;
+
+            generation = generation_;
+        }
+
+        work_(index);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Cpu_thread_pool::work_(uint32_t index)
+{
+    uint32_t item;
+
+    while (pop_(index, item) || steal_(index, item)) {
+        // an item is published after its function, so the function is valid for it.
+        (*func_.load())(item);
+
+        if (1 == remaining_.fetch_sub(1)) {
+            lock_guard<mutex> lock {mutex_};
+            done_cv_.notify_all();
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+bool Cpu_thread_pool::pop_(uint32_t index, uint32_t& item)
+{
+    auto& queue = *queues_[index];
+    lock_guard<mutex> lock {queue.mutex};
+
+    if (queue.items.empty())
+        return false;
+
+    item = queue.items.front();
+    queue.items.pop_front();
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+bool Cpu_thread_pool::steal_(uint32_t index, uint32_t& item)
+{
+    for (uint32_t i = 1; i != thread_count(); ++i) {
+        auto& queue = *queues_[(index + i) % thread_count()];
+        lock_guard<mutex> lock {queue.mutex};
+
+        if (queue.items.empty())
+            continue;
+
+        item = queue.items.back();
+        queue.items.pop_back();
+
+        return true;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
@@ -0,0 +1,69 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_CPU_THREAD_POOL_GUARD
+#define GFX_CPU_THREAD_POOL_GUARD
+
+#include <cstdint>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Cpu_thread_pool final {
+public:
+    explicit Cpu_thread_pool(uint32_t thread_count);
+
+    ~Cpu_thread_pool();
+
+    void parallel_for(uint32_t count, const std::function<void (uint32_t)>& func);
+
+    inline auto thread_count() const noexcept
+    { return static_cast<uint32_t>(queues_.size()); }
+
+private:
+    struct Queue final {
+        std::mutex mutex;
+        std::deque<uint32_t> items;
+    };
+
+private:
+    void init_threads_(uint32_t thread_count);
+
+    void fini_threads_();
+
+    void run_(uint32_t index);
+
+    void work_(uint32_t index);
+
+    bool pop_(uint32_t index, uint32_t& item);
+
+    bool steal_(uint32_t index, uint32_t& item);
+
+private:
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    std::atomic<const std::function<void (uint32_t)>*> func_;
+    std::atomic<uint32_t> remaining_;
+    uint64_t generation_;
+    bool quit_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_CPU_THREAD_POOL_GUARD
@@ -0,0 +1,261 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_CPU_LIB_MODULES_GUARD
+#define GFX_CPU_LIB_MODULES_GUARD
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <array>
+#include <algorithm>
+#include <stdexcept>
+#include "gfx/enums.h"
+#include "gfx/types.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+using Cpu_color = std::array<float, 4>;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline uint32_t texel_size(Format format)
+{
+    switch (format) {
+        case Format::rgb8_unorm:
+            return 3;
+        case Format::rgba8_unorm:
+        case Format::bgra8_unorm:
+        case Format::r32_float:
+        case Format::d24_unorm_s8_uint:
+            return 4;
+        case Format::rg32_float:
+            return 8;
+        case Format::rgb32_float:
+            return 12;
+        case Format::rgba32_float:
+            return 16;
+        default:
+            throw std::runtime_error("invalid the format");
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline float to_unorm(uint8_t value) noexcept
+{
+    return value / 255.0f;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline uint8_t to_uint8(float value) noexcept
+{
+    return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline Cpu_color to_Cpu_color(Format format, const uint8_t* data)
+{
+    Cpu_color color {0.0f, 0.0f, 0.0f, 1.0f};
+
+    switch (format) {
+        case Format::rgb8_unorm:
+            for (auto i = 0; i != 3; ++i)
+                color[i] = to_unorm(data[i]);
+            break;
+        case Format::rgba8_unorm:
+            for (auto i = 0; i != 4; ++i)
+                color[i] = to_unorm(data[i]);
+            break;
+        case Format::bgra8_unorm:
+            color = {to_unorm(data[2]), to_unorm(data[1]), to_unorm(data[0]), to_unorm(data[3])};
+            break;
+        case Format::r32_float:
+            memcpy(&color[0], data, sizeof(float) * 1);
+            break;
+        case Format::rg32_float:
+            memcpy(&color[0], data, sizeof(float) * 2);
+            break;
+        case Format::rgb32_float:
+            memcpy(&color[0], data, sizeof(float) * 3);
+            break;
+        case Format::rgba32_float:
+            memcpy(&color[0], data, sizeof(float) * 4);
+            break;
+        default:
+            throw std::runtime_error("invalid the format");
+    }
+
+    return color;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline void from_Cpu_color(Format format, const Cpu_color& color, uint8_t* data)
+{
+    switch (format) {
+        case Format::rgb8_unorm:
+            for (auto i = 0; i != 3; ++i)
+                data[i] = to_uint8(color[i]);
+            break;
+        case Format::rgba8_unorm:
+            for (auto i = 0; i != 4; ++i)
+                data[i] = to_uint8(color[i]);
+            break;
+        case Format::bgra8_unorm:
+            data[0] = to_uint8(color[2]);
+            data[1] = to_uint8(color[1]);
+            data[2] = to_uint8(color[0]);
+            data[3] = to_uint8(color[3]);
+            break;
+        case Format::r32_float:
+            memcpy(data, &color[0], sizeof(float) * 1);
+            break;
+        case Format::rg32_float:
+            memcpy(data, &color[0], sizeof(float) * 2);
+            break;
+        case Format::rgb32_float:
+            memcpy(data, &color[0], sizeof(float) * 3);
+            break;
+        case Format::rgba32_float:
+            memcpy(data, &color[0], sizeof(float) * 4);
+            break;
+        default:
+            throw std::runtime_error("invalid the format");
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline uint32_t to_depth24(float depth) noexcept
+{
+    return static_cast<uint32_t>(std::clamp(depth, 0.0f, 1.0f) * 0xFFFFFF + 0.5f);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline uint32_t to_d24s8(float depth, uint32_t stencil) noexcept
+{
+    return (to_depth24(depth) & 0xFFFFFF) | ((stencil & 0xFF) << 24);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+inline bool compare(Compare_op op, T lhs, T rhs)
+{
+    switch (op) {
+        case Compare_op::never:
+            return false;
+        case Compare_op::less:
+            return lhs < rhs;
+        case Compare_op::greater:
+            return lhs > rhs;
+        case Compare_op::equal:
+            return lhs == rhs;
+        case Compare_op::not_equal:
+            return lhs != rhs;
+        case Compare_op::less_or_equal:
+            return lhs <= rhs;
+        case Compare_op::greater_or_equal:
+            return lhs >= rhs;
+        case Compare_op::always:
+            return true;
+        default:
+            throw std::runtime_error("invalid the compare op");
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline uint8_t apply(Stencil_op op, uint8_t value, uint8_t reference)
+{
+    switch (op) {
+        case Stencil_op::keep:
+            return value;
+        case Stencil_op::zero:
+            return 0;
+        case Stencil_op::replace:
+            return reference;
+        case Stencil_op::increment_and_clamp:
+            return value == UINT8_MAX ? value : value + 1;
+        case Stencil_op::decrement_and_clamp:
+            return value == 0 ? value : value - 1;
+        case Stencil_op::invert:
+            return ~value;
+        case Stencil_op::increment_and_wrap:
+            return value + 1;
+        case Stencil_op::decrement_and_wrap:
+            return value - 1;
+        default:
+            throw std::runtime_error("invalid the stencil op");
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline float to_blend_factor(Blend_factor factor, float src_a, float dst_a)
+{
+    switch (factor) {
+        case Blend_factor::zero:
+            return 0.0f;
+        case Blend_factor::one:
+            return 1.0f;
+        case Blend_factor::src_alpha:
+            return src_a;
+        case Blend_factor::one_minus_src_alpha:
+            return 1.0f - src_a;
+        case Blend_factor::dst_alpha:
+            return dst_a;
+        case Blend_factor::one_minus_dst_alpha:
+            return 1.0f - dst_a;
+        default:
+            throw std::runtime_error("invalid the blend factor");
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline float blend(Blend_op op, float src, float dst, float src_factor, float dst_factor)
+{
+    switch (op) {
+        case Blend_op::add:
+            return src * src_factor + dst * dst_factor;
+        case Blend_op::subtract:
+            return src * src_factor - dst * dst_factor;
+        case Blend_op::reverse_subtract:
+            return dst * dst_factor - src * src_factor;
+        case Blend_op::min:
+            return std::min(src, dst);
+        case Blend_op::max:
+            return std::max(src, dst);
+        default:
+            throw std::runtime_error("invalid the blend op");
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline uint32_t byte_size(Index_type type)
+{
+    switch (type) {
+        case Index_type::uint16:
+            return sizeof(uint16_t);
+        case Index_type::uint32:
+            return sizeof(uint32_t);
+        default:
+            throw std::runtime_error("invalid the index type");
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_CPU_LIB_MODULES_GUARD
@@ -0,0 +1,33 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_MTL_BIND_GROUP_GUARD
+#define GFX_MTL_BIND_GROUP_GUARD
+
+#include "Bind_group.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Mtl_device;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Mtl_bind_group final : public Bind_group {
+public:
+    Mtl_bind_group(const Bind_group_desc& desc, Mtl_device* device);
+
+    Device* device() const override;
+
+private:
+    Mtl_device* device_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_MTL_BIND_GROUP_GUARD
@@ -0,0 +1,29 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "mtl_lib.h"
+#include "Mtl_bind_group.h"
+#include "Mtl_device.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Mtl_bind_group::Mtl_bind_group(const Bind_group_desc& desc, Mtl_device* device) :
+    Bind_group {desc},
+    device_ {device}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Device* Mtl_bind_group::device() const
+{
+    return device_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
@@ -7,6 +7,9 @@
 #define GFX_MTL_CMD_BUFFER_GUARD
 
 #include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include <unordered_map>
 #include <Metal/Metal.h>
 #include "limitations.h"
@@ -83,11 +86,20 @@ class Mtl_render_encoder final : public Render_encoder {
 public:
     Mtl_render_encoder(const Render_encoder_desc& desc, Mtl_cmd_buffer* cmd_buffer);
 
+    Mtl_render_encoder(id<MTLRenderCommandEncoder> render_command_encoder, Mtl_cmd_buffer* cmd_buffer);
+
     void end() override;
 
-    void draw(uint32_t count, uint32_t first = 0) override;
+    void draw(uint32_t count, uint32_t first = 0, uint32_t instance_count = 1, uint32_t first_instance = 0) override;
+
+    void draw_indexed(uint32_t count, uint32_t first = 0, uint32_t instance_count = 1,
+                      uint32_t first_instance = 0, int32_t base_vertex = 0) override;
 
-    void draw_indexed(uint32_t count, uint32_t first = 0) override;
+    void draw_indirect(Buffer* buffer, uint64_t offset, uint32_t draw_count = 1,
+                       uint32_t stride = sizeof(Draw_indirect_args)) override;
+
+    void draw_indexed_indirect(Buffer* buffer, uint64_t offset, uint32_t draw_count = 1,
+                               uint32_t stride = sizeof(Draw_indexed_indirect_args)) override;
 
     void vertex_buffer(Buffer* buffer, uint64_t offset, uint32_t index) override;
 
@@ -97,6 +109,11 @@ public:
 
     void shader_texture(Image* image, Sampler* sampler, uint32_t index) override;
 
+    void shader_bytes(Pipeline_stage stage, uint32_t offset, const void* data, uint32_t size) override;
+
+    void bind_group(uint32_t index, Bind_group* bind_group,
+                    const std::vector<uint32_t>& dynamic_offsets = {}) override;
+
     void pipeline(Pipeline* pipeline) override;
 
     void viewport(const Viewport& viewport) override;
@@ -117,17 +134,43 @@ private:
 
     void bind_arg_texture_(uint64_t index, uint32_t stages);
 
+    void bind_push_constants_();
+
 private:
     Mtl_cmd_buffer* cmd_buffer_;
     id<MTLRenderCommandEncoder> render_command_encoder_;
     std::array<Mtl_vertex_stream, 2> vertex_streams_;
     Mtl_index_stream index_stream_;
     Mtl_arg_table arg_table_;
+    std::array<uint8_t, max_push_constant_size> push_constants_;
+    bool push_constants_dirty_;
     Mtl_pipeline* pipeline_;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
 
+class Mtl_parallel_render_encoder final : public Parallel_render_encoder {
+public:
+    Mtl_parallel_render_encoder(const Parallel_render_encoder_desc& desc, Mtl_cmd_buffer* cmd_buffer);
+
+    Render_encoder* render_encoder() override;
+
+    void end() override;
+
+    Cmd_buffer* cmd_buffer() const override;
+
+private:
+    void init_parallel_render_command_encoder_(const Parallel_render_encoder_desc& desc);
+
+private:
+    Mtl_cmd_buffer* cmd_buffer_;
+    id<MTLParallelRenderCommandEncoder> parallel_render_command_encoder_;
+    std::vector<std::unique_ptr<Mtl_render_encoder>> encoders_;
+    std::mutex mutex_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
 class Mtl_blit_encoder final : public Blit_encoder {
 public:
     Mtl_blit_encoder(const Blit_encoder_desc& desc, Mtl_cmd_buffer* cmd_buffer);
@@ -155,14 +198,54 @@ private:
 
 //----------------------------------------------------------------------------------------------------------------------
 
+class Mtl_compute_encoder final : public Compute_encoder {
+public:
+    Mtl_compute_encoder(const Compute_encoder_desc& desc, Mtl_cmd_buffer* cmd_buffer);
+
+    void end() override;
+
+    void dispatch(uint32_t x, uint32_t y = 1, uint32_t z = 1) override;
+
+    void dispatch_indirect(Buffer* buffer, uint64_t offset = 0) override;
+
+    void shader_buffer(Buffer* buffer, uint32_t offset, uint32_t index) override;
+
+    void shader_texture(Image* image, Sampler* sampler, uint32_t index) override;
+
+    void storage_buffer(Buffer* buffer, uint32_t offset, uint32_t index) override;
+
+    void storage_image(Image* image, uint32_t index) override;
+
+    void pipeline(Pipeline* pipeline) override;
+
+    Cmd_buffer* cmd_buffer() const override;
+
+    inline auto compute_command_encoder() const noexcept
+    { return compute_command_encoder_; }
+
+private:
+    void init_compute_command_encoder_();
+
+private:
+    Mtl_cmd_buffer* cmd_buffer_;
+    id<MTLComputeCommandEncoder> compute_command_encoder_;
+    Mtl_pipeline* pipeline_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
 class Mtl_cmd_buffer final : public Cmd_buffer {
 public:
     Mtl_cmd_buffer(Mtl_device* device);
 
     std::unique_ptr<Render_encoder> create(const Render_encoder_desc& desc) override;
 
+    std::unique_ptr<Parallel_render_encoder> create(const Parallel_render_encoder_desc& desc) override;
+
     std::unique_ptr<Blit_encoder> create(const Blit_encoder_desc& desc) override;
 
+    std::unique_ptr<Compute_encoder> create(const Compute_encoder_desc& desc) override;
+
     void end() override;
 
     void reset() override;
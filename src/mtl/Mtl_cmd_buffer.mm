@@ -12,6 +12,7 @@
 #include "Mtl_image.h"
 #include "Mtl_sampler.h"
 #include "Mtl_pipeline.h"
+#include "Mtl_bind_group.h"
 
 using namespace std;
 using namespace Sc_lib;
@@ -49,6 +50,48 @@ inline auto byte_size(Index_type type)
 
 //----------------------------------------------------------------------------------------------------------------------
 
+inline auto to_MTLRenderPassDescriptor(const Render_encoder_desc& desc)
+{
+    // configure a render pass descriptor.
+    auto descriptor = [MTLRenderPassDescriptor renderPassDescriptor];
+
+    for( auto i = 0; i != desc.colors.size(); ++i) {
+        auto& color = desc.colors[i];
+
+        if (color.image) {
+            auto mtl_image = static_cast<Mtl_image*>(color.image);
+
+            // set up the color attachment descriptor at the index.
+            descriptor.colorAttachments[i].texture = mtl_image->texture();
+            descriptor.colorAttachments[i].loadAction = to_MTLLoadAction(color.load_op);
+            descriptor.colorAttachments[i].storeAction = to_MTLStoreAction(color.store_op);
+            descriptor.colorAttachments[i].clearColor = to_MTLClearColor(color.clear_value);
+        }
+    }
+
+    auto& depth_stencil = desc.depth_stencil;
+
+    if (depth_stencil.image) {
+        auto mtl_image = static_cast<Mtl_image*>(depth_stencil.image);
+
+        // set up the depth attachment descriptor.
+        descriptor.depthAttachment.texture = mtl_image->texture();
+        descriptor.depthAttachment.loadAction = to_MTLLoadAction(depth_stencil.load_op);
+        descriptor.depthAttachment.storeAction = to_MTLStoreAction(depth_stencil.store_op);
+        descriptor.depthAttachment.clearDepth = depth_stencil.clear_value.d;
+
+        // set up the stencil attachment descriptor.
+        descriptor.stencilAttachment.texture = mtl_image->texture();
+        descriptor.stencilAttachment.loadAction = descriptor.depthAttachment.loadAction;
+        descriptor.stencilAttachment.storeAction = descriptor.depthAttachment.storeAction;
+        descriptor.stencilAttachment.clearStencil = depth_stencil.clear_value.s;
+    }
+
+    return descriptor;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 } // of namespace
 
 namespace Gfx_lib {
@@ -62,6 +105,8 @@ Mtl_render_encoder::Mtl_render_encoder(const Render_encoder_desc& desc, Mtl_cmd_
     vertex_streams_ {},
     index_stream_ {},
     arg_table_ {},
+    push_constants_ {},
+    push_constants_dirty_ {false},
     pipeline_ {nullptr}
 {
     init_render_command_encoder_(desc);
@@ -69,6 +114,22 @@ Mtl_render_encoder::Mtl_render_encoder(const Render_encoder_desc& desc, Mtl_cmd_
 
 //----------------------------------------------------------------------------------------------------------------------
 
+Mtl_render_encoder::Mtl_render_encoder(id<MTLRenderCommandEncoder> render_command_encoder,
+                                       Mtl_cmd_buffer* cmd_buffer) :
+    Render_encoder(),
+    cmd_buffer_ {cmd_buffer},
+    render_command_encoder_ {render_command_encoder},
+    vertex_streams_ {},
+    index_stream_ {},
+    arg_table_ {},
+    push_constants_ {},
+    push_constants_dirty_ {false},
+    pipeline_ {nullptr}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 void Mtl_render_encoder::end()
 {
     [render_command_encoder_ endEncoding];
@@ -76,22 +137,27 @@ void Mtl_render_encoder::end()
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Mtl_render_encoder::draw(uint32_t count, uint32_t first)
+void Mtl_render_encoder::draw(uint32_t count, uint32_t first, uint32_t instance_count, uint32_t first_instance)
 {
     bind_arg_table_();
+    bind_push_constants_();
 
     auto input_assembly = pipeline_->input_assembly();
 
     [render_command_encoder_ drawPrimitives:to_MTLPrimitiveType(input_assembly.topology)
                                 vertexStart:first
-                                vertexCount:count];
+                                vertexCount:count
+                              instanceCount:instance_count
+                               baseInstance:first_instance];
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Mtl_render_encoder::draw_indexed(uint32_t count, uint32_t first)
+void Mtl_render_encoder::draw_indexed(uint32_t count, uint32_t first, uint32_t instance_count,
+                                      uint32_t first_instance, int32_t base_vertex)
 {
     bind_arg_table_();
+    bind_push_constants_();
 
     auto input_assembly = pipeline_->input_assembly();
     auto offset = first * byte_size(index_stream_.index_type);
@@ -100,7 +166,49 @@ void Mtl_render_encoder::draw_indexed(uint32_t count, uint32_t first)
                                         indexCount:count
                                          indexType:to_MTLIndexType(index_stream_.index_type)
                                        indexBuffer:index_stream_.buffer->buffer()
-                                 indexBufferOffset:offset + index_stream_.offset];
+                                 indexBufferOffset:offset + index_stream_.offset
+                                     instanceCount:instance_count
+                                        baseVertex:base_vertex
+                                      baseInstance:first_instance];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Mtl_render_encoder::draw_indirect(Buffer* buffer, uint64_t offset, uint32_t draw_count, uint32_t stride)
+{
+    bind_arg_table_();
+    bind_push_constants_();
+
+    auto input_assembly = pipeline_->input_assembly();
+    auto buffer_impl = static_cast<Mtl_buffer*>(buffer);
+
+    // a render command encoder reads a single draw from an indirect buffer.
+    for (uint32_t i = 0; i != draw_count; ++i) {
+        [render_command_encoder_ drawPrimitives:to_MTLPrimitiveType(input_assembly.topology)
+                                 indirectBuffer:buffer_impl->buffer()
+                           indirectBufferOffset:offset + i * stride];
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Mtl_render_encoder::draw_indexed_indirect(Buffer* buffer, uint64_t offset, uint32_t draw_count, uint32_t stride)
+{
+    bind_arg_table_();
+    bind_push_constants_();
+
+    auto input_assembly = pipeline_->input_assembly();
+    auto buffer_impl = static_cast<Mtl_buffer*>(buffer);
+
+    // a render command encoder reads a single draw from an indirect buffer.
+    for (uint32_t i = 0; i != draw_count; ++i) {
+        [render_command_encoder_ drawIndexedPrimitives:to_MTLPrimitiveType(input_assembly.topology)
+                                             indexType:to_MTLIndexType(index_stream_.index_type)
+                                           indexBuffer:index_stream_.buffer->buffer()
+                                     indexBufferOffset:index_stream_.offset
+                                        indirectBuffer:buffer_impl->buffer()
+                                  indirectBufferOffset:offset + i * stride];
+    }
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -172,6 +280,35 @@ void Mtl_render_encoder::shader_texture(Image* image, Sampler* sampler, uint32_t
 
 //----------------------------------------------------------------------------------------------------------------------
 
+void Mtl_render_encoder::shader_bytes(Pipeline_stage stage, uint32_t offset, const void* data, uint32_t size)
+{
+    if (max_push_constant_size < offset + size)
+        throw runtime_error("fail to set shader bytes");
+
+    // bytes are visible to every stage like other backends, a stage is ignored.
+    copy_n(static_cast<const uint8_t*>(data), size, push_constants_.begin() + offset);
+    push_constants_dirty_ = true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Mtl_render_encoder::bind_group(uint32_t index, Bind_group* bind_group, const vector<uint32_t>& dynamic_offsets)
+{
+    bind_group->validate_binding(index, dynamic_offsets);
+
+    auto offset_index = 0;
+
+    // arguments are set to a command encoder at a draw, so a group only updates an arg table.
+    for (auto& entry : bind_group->entries()) {
+        if (entry.buffer)
+            shader_buffer(entry.buffer, dynamic_offsets.empty() ? 0 : dynamic_offsets[offset_index++], entry.index);
+        else
+            shader_texture(entry.image, entry.sampler, entry.index);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 void Mtl_render_encoder::pipeline(Pipeline* pipeline)
 {
     pipeline_ = static_cast<Mtl_pipeline*>(pipeline);
@@ -219,43 +356,9 @@ Cmd_buffer* Mtl_render_encoder::cmd_buffer() const
 
 void Mtl_render_encoder::init_render_command_encoder_(const Render_encoder_desc& desc)
 {
-    // configure a render pass descriptor.
-    auto descriptor = [MTLRenderPassDescriptor renderPassDescriptor];
-
-    for( auto i = 0; i != desc.colors.size(); ++i) {
-        auto& color = desc.colors[i];
-
-        if (color.image) {
-            auto mtl_image = static_cast<Mtl_image*>(color.image);
-
-            // set up the color attachment descriptor at the index.
-            descriptor.colorAttachments[i].texture = mtl_image->texture();
-            descriptor.colorAttachments[i].loadAction = to_MTLLoadAction(color.load_op);
-            descriptor.colorAttachments[i].storeAction = to_MTLStoreAction(color.store_op);
-            descriptor.colorAttachments[i].clearColor = to_MTLClearColor(color.clear_value);
-        }
-    }
-
-    auto& depth_stencil = desc.depth_stencil;
-
-    if (depth_stencil.image) {
-        auto mtl_image = static_cast<Mtl_image*>(depth_stencil.image);
-
-        // set up the depth attachment descriptor.
-        descriptor.depthAttachment.texture = mtl_image->texture();
-        descriptor.depthAttachment.loadAction = to_MTLLoadAction(depth_stencil.load_op);
-        descriptor.depthAttachment.storeAction = to_MTLStoreAction(depth_stencil.store_op);
-        descriptor.depthAttachment.clearDepth = depth_stencil.clear_value.d;
-
-        // set up the stencil attachment descriptor.
-        descriptor.stencilAttachment.texture = mtl_image->texture();
-        descriptor.stencilAttachment.loadAction = descriptor.depthAttachment.loadAction;
-        descriptor.stencilAttachment.storeAction = descriptor.depthAttachment.storeAction;
-        descriptor.stencilAttachment.clearStencil = depth_stencil.clear_value.s;
-    }
-
     // start render encoding.
-    render_command_encoder_ = [cmd_buffer_->command_buffer() renderCommandEncoderWithDescriptor:descriptor];
+    render_command_encoder_ = [cmd_buffer_->command_buffer()
+                               renderCommandEncoderWithDescriptor:to_MTLRenderPassDescriptor(desc)];
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -345,6 +448,78 @@ void Mtl_render_encoder::bind_arg_texture_(uint64_t index, uint32_t stages)
 
 //----------------------------------------------------------------------------------------------------------------------
 
+void Mtl_render_encoder::bind_push_constants_()
+{
+    auto push_constants = pipeline_->push_constants();
+
+    if (!push_constants_dirty_ || !push_constants.size)
+        return;
+
+    // bytes are copied by a command encoder, there is no buffer to manage.
+    [render_command_encoder_ setVertexBytes:push_constants_.data()
+                                     length:push_constants.size
+                                    atIndex:push_constant_index];
+    [render_command_encoder_ setFragmentBytes:push_constants_.data()
+                                       length:push_constants.size
+                                      atIndex:push_constant_index];
+
+    push_constants_dirty_ = false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Mtl_parallel_render_encoder::Mtl_parallel_render_encoder(const Parallel_render_encoder_desc& desc,
+                                                         Mtl_cmd_buffer* cmd_buffer) :
+    Parallel_render_encoder(),
+    cmd_buffer_ {cmd_buffer},
+    parallel_render_command_encoder_ {nil},
+    encoders_ {},
+    mutex_ {}
+{
+    init_parallel_render_command_encoder_(desc);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Render_encoder* Mtl_parallel_render_encoder::render_encoder()
+{
+    lock_guard<mutex> lock {mutex_};
+
+    // encoders are executed in the order of their creation.
+    auto render_command_encoder = [parallel_render_command_encoder_ renderCommandEncoder];
+
+    encoders_.push_back(make_unique<Mtl_render_encoder>(render_command_encoder, cmd_buffer_));
+
+    return encoders_.back().get();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Mtl_parallel_render_encoder::end()
+{
+    [parallel_render_command_encoder_ endEncoding];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cmd_buffer* Mtl_parallel_render_encoder::cmd_buffer() const
+{
+    return cmd_buffer_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Mtl_parallel_render_encoder::init_parallel_render_command_encoder_(const Parallel_render_encoder_desc& desc)
+{
+    auto descriptor = to_MTLRenderPassDescriptor(desc.render_encoder);
+
+    // start parallel render encoding.
+    parallel_render_command_encoder_ = [cmd_buffer_->command_buffer()
+                                        parallelRenderCommandEncoderWithDescriptor:descriptor];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 Mtl_blit_encoder::Mtl_blit_encoder(const Blit_encoder_desc& desc, Mtl_cmd_buffer* cmd_buffer) :
     Blit_encoder(),
     cmd_buffer_ {cmd_buffer},
@@ -426,6 +601,110 @@ void Mtl_blit_encoder::init_blit_command_encoder_()
 
 //----------------------------------------------------------------------------------------------------------------------
 
+Mtl_compute_encoder::Mtl_compute_encoder(const Compute_encoder_desc& desc, Mtl_cmd_buffer* cmd_buffer) :
+    Compute_encoder(),
+    cmd_buffer_ {cmd_buffer},
+    compute_command_encoder_ {nil},
+    pipeline_ {nullptr}
+{
+    init_compute_command_encoder_();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Mtl_compute_encoder::end()
+{
+    [compute_command_encoder_ endEncoding];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Mtl_compute_encoder::dispatch(uint32_t x, uint32_t y, uint32_t z)
+{
+    [compute_command_encoder_ dispatchThreadgroups:MTLSizeMake(x, y, z)
+                             threadsPerThreadgroup:to_MTLSize(pipeline_->work_group_size())];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Mtl_compute_encoder::dispatch_indirect(Buffer* buffer, uint64_t offset)
+{
+    auto mtl_buffer = static_cast<Mtl_buffer*>(buffer);
+
+    [compute_command_encoder_ dispatchThreadgroupsWithIndirectBuffer:mtl_buffer->buffer()
+                                                indirectBufferOffset:offset
+                                               threadsPerThreadgroup:to_MTLSize(pipeline_->work_group_size())];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Mtl_compute_encoder::shader_buffer(Buffer* buffer, uint32_t offset, uint32_t index)
+{
+    auto mtl_buffer = static_cast<Mtl_buffer*>(buffer);
+
+    [compute_command_encoder_ setBuffer:mtl_buffer->buffer() offset:offset atIndex:index];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Mtl_compute_encoder::shader_texture(Image* image, Sampler* sampler, uint32_t index)
+{
+    auto mtl_image = static_cast<Mtl_image*>(image);
+    auto mtl_sampler = static_cast<Mtl_sampler*>(sampler);
+
+    [compute_command_encoder_ setTexture:mtl_image->texture() atIndex:index];
+    [compute_command_encoder_ setSamplerState:mtl_sampler->sampler_state() atIndex:index];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Mtl_compute_encoder::storage_buffer(Buffer* buffer, uint32_t offset, uint32_t index)
+{
+    auto mtl_buffer = static_cast<Mtl_buffer*>(buffer);
+
+    [compute_command_encoder_ setBuffer:mtl_buffer->buffer() offset:offset
+                                atIndex:index + storage_buffer_index_offset];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Mtl_compute_encoder::storage_image(Image* image, uint32_t index)
+{
+    if (!image->storage())
+        throw runtime_error("fail to bind a storage image");
+
+    auto mtl_image = static_cast<Mtl_image*>(image);
+
+    [compute_command_encoder_ setTexture:mtl_image->texture()
+                                 atIndex:index + storage_texture_index_offset];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Mtl_compute_encoder::pipeline(Pipeline* pipeline)
+{
+    pipeline_ = static_cast<Mtl_pipeline*>(pipeline);
+
+    [compute_command_encoder_ setComputePipelineState:pipeline_->compute_pipeline_state()];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cmd_buffer* Mtl_compute_encoder::cmd_buffer() const
+{
+    return cmd_buffer_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Mtl_compute_encoder::init_compute_command_encoder_()
+{
+    // dispatches are executed serially, so a dispatch always sees writes of a previous dispatch.
+    compute_command_encoder_ = [cmd_buffer_->command_buffer() computeCommandEncoder];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 Mtl_cmd_buffer::Mtl_cmd_buffer(Mtl_device* device) :
     device_ { device },
     command_buffer_ { nil }
@@ -442,6 +721,13 @@ std::unique_ptr<Render_encoder> Mtl_cmd_buffer::create(const Render_encoder_desc
 
 //----------------------------------------------------------------------------------------------------------------------
 
+std::unique_ptr<Parallel_render_encoder> Mtl_cmd_buffer::create(const Parallel_render_encoder_desc& desc)
+{
+    return make_unique<Mtl_parallel_render_encoder>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 std::unique_ptr<Blit_encoder> Mtl_cmd_buffer::create(const Blit_encoder_desc& desc)
 {
     return make_unique<Mtl_blit_encoder>(desc, this);
@@ -449,6 +735,13 @@ std::unique_ptr<Blit_encoder> Mtl_cmd_buffer::create(const Blit_encoder_desc& de
 
 //----------------------------------------------------------------------------------------------------------------------
 
+std::unique_ptr<Compute_encoder> Mtl_cmd_buffer::create(const Compute_encoder_desc& desc)
+{
+    return make_unique<Mtl_compute_encoder>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 void Mtl_cmd_buffer::end()
 {
 }
@@ -10,6 +10,7 @@
 #include <Foundation/Foundation.h>
 #include <Metal/Metal.h>
 #include "Device.h"
+#include "Host_fence_waiter.h"
 
 namespace Gfx_lib {
 
@@ -17,7 +18,9 @@ namespace Gfx_lib {
 
 class Mtl_device final : public Device {
 public:
-    Mtl_device();
+    explicit Mtl_device(const Device_desc& desc = {});
+
+    static std::vector<Adapter> enumerate();
 
     std::unique_ptr<Buffer> create(const Buffer_desc& desc) override;
 
@@ -29,14 +32,26 @@ public:
 
     std::unique_ptr<Pipeline> create(const Pipeline_desc& desc) override;
 
+    std::unique_ptr<Pipeline> create(const Compute_pipeline_desc& desc) override;
+
+    std::unique_ptr<Bind_group> create(const Bind_group_desc& desc) override;
+
     std::unique_ptr<Swap_chain> create(const Swap_chain_desc& desc) override;
 
     std::unique_ptr<Cmd_buffer> create(const Cmd_buffer_desc& desc) override;
 
     std::unique_ptr<Fence> create(const Fence_desc& desc) override;
 
+    std::unique_ptr<Semaphore> create(const Semaphore_desc& desc) override;
+
+    std::unique_ptr<Timeline> create(const Timeline_desc& desc) override;
+
     void submit(Cmd_buffer* cmd_buffer, Fence* fence = nullptr) override;
 
+    void submit(const std::vector<Submit_desc>& descs, Fence* fence = nullptr) override;
+
+    bool wait(const std::vector<Fence*>& fences, bool wait_all, uint64_t timeout = UINT64_MAX) override;
+
     void wait_idle() override;
 
     inline auto device() const noexcept
@@ -46,7 +61,7 @@ public:
     { return command_queue_; }
 
 private:
-    void init_device_();
+    void init_device_(const Device_desc& desc);
 
     void init_caps_();
 
@@ -57,6 +72,7 @@ private:
     id<MTLCommandQueue> command_queue_;
     NSMutableSet<id<MTLCommandBuffer>>* used_command_buffers_;
     std::mutex queue_mutex_;
+    Host_fence_waiter fence_waiter_;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -12,9 +12,12 @@
 #include "Mtl_sampler.h"
 #include "Mtl_shader.h"
 #include "Mtl_pipeline.h"
+#include "Mtl_bind_group.h"
 #include "Mtl_swap_chain.h"
 #include "Mtl_cmd_buffer.h"
 #include "Mtl_fence.h"
+#include "Mtl_semaphore.h"
+#include "Host_timeline.h"
 
 using namespace std;
 
@@ -22,20 +25,75 @@ namespace Gfx_lib {
 
 //----------------------------------------------------------------------------------------------------------------------
 
-Mtl_device::Mtl_device() :
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+NSArray<id<MTLDevice>>* query_devices()
+{
+#if TARGET_OS_OSX
+    return MTLCopyAllDevices();
+#else
+    if (auto device = MTLCreateSystemDefaultDevice(); device)
+        return @[device];
+
+    return @[];
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Adapter to_Adapter(uint32_t index, id<MTLDevice> device)
+{
+    Adapter adapter;
+
+    adapter.index = index;
+    adapter.name = device.name.UTF8String;
+#if TARGET_OS_OSX
+    adapter.type = device.isLowPower ? Adapter_type::integrated : Adapter_type::discrete;
+#else
+    adapter.type = Adapter_type::integrated;
+#endif
+    adapter.memory_size = device.recommendedMaxWorkingSetSize;
+    adapter.queue_family_count = 1;
+
+    return adapter;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Mtl_device::Mtl_device(const Device_desc& desc) :
     Device {},
     device_ {nil},
     command_queue_ {nil},
     used_command_buffers_ {[NSMutableSet new]},
-    queue_mutex_ {}
+    queue_mutex_ {},
+    fence_waiter_ {}
 {
-    init_device_();
+    init_device_(desc);
     init_caps_();
     init_command_queue_();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
+std::vector<Adapter> Mtl_device::enumerate()
+{
+    auto devices = query_devices();
+    vector<Adapter> adapters;
+
+    for (auto i = 0; i != devices.count; ++i)
+        adapters.push_back(to_Adapter(i, devices[i]));
+
+    return adapters;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 std::unique_ptr<Buffer> Mtl_device::create(const Buffer_desc& desc)
 {
     return make_unique<Mtl_buffer>(desc, this);
@@ -71,6 +129,20 @@ std::unique_ptr<Pipeline> Mtl_device::create(const Pipeline_desc& desc)
 
 //----------------------------------------------------------------------------------------------------------------------
 
+std::unique_ptr<Pipeline> Mtl_device::create(const Compute_pipeline_desc& desc)
+{
+    return make_unique<Mtl_pipeline>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Bind_group> Mtl_device::create(const Bind_group_desc& desc)
+{
+    return make_unique<Mtl_bind_group>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 std::unique_ptr<Swap_chain> Mtl_device::create(const Swap_chain_desc& desc)
 {
     return make_unique<Mtl_swap_chain>(desc, this);
@@ -92,6 +164,20 @@ std::unique_ptr<Fence> Mtl_device::create(const Fence_desc& desc)
 
 //----------------------------------------------------------------------------------------------------------------------
 
+std::unique_ptr<Semaphore> Mtl_device::create(const Semaphore_desc& desc)
+{
+    return make_unique<Mtl_semaphore>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Timeline> Mtl_device::create(const Timeline_desc& desc)
+{
+    return make_unique<Host_timeline>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 void Mtl_device::submit(Cmd_buffer* cmd_buffer, Fence* fence)
 {
     auto cmd_buffer_impl = static_cast<Mtl_cmd_buffer*>(cmd_buffer);
@@ -106,6 +192,7 @@ void Mtl_device::submit(Cmd_buffer* cmd_buffer, Fence* fence)
         if (fence_impl) {
             dispatch_semaphore_signal(fence_impl->semaphore());
             fence_impl->signaled_ = true;
+            fence_waiter_.notify();
         }
     }];
     [cmd_buffer_impl->command_buffer() commit];
@@ -117,6 +204,46 @@ void Mtl_device::submit(Cmd_buffer* cmd_buffer, Fence* fence)
 
 //----------------------------------------------------------------------------------------------------------------------
 
+void Mtl_device::submit(const std::vector<Submit_desc>& descs, Fence* fence)
+{
+    // a command queue executes command buffers in the commit order, so semaphores are always satisfied.
+    Cmd_buffer* last_cmd_buffer {nullptr};
+
+    for (auto& desc : descs) {
+        for (auto cmd_buffer : desc.cmd_buffers) {
+            if (last_cmd_buffer)
+                submit(last_cmd_buffer, nullptr);
+
+            last_cmd_buffer = cmd_buffer;
+        }
+
+        // signal a timeline when the last command buffer of a desc is completed.
+        if (desc.timeline && !desc.cmd_buffers.empty()) {
+            auto command_buffer = static_cast<Mtl_cmd_buffer*>(desc.cmd_buffers.back())->command_buffer();
+            auto timeline = desc.timeline;
+            auto value = desc.timeline_value;
+
+            [command_buffer addCompletedHandler:^(id<MTLCommandBuffer>) {
+                timeline->signal(value);
+            }];
+        }
+    }
+
+    // only the last command buffer signals a fence.
+    if (last_cmd_buffer)
+        submit(last_cmd_buffer, fence);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+bool Mtl_device::wait(const std::vector<Fence*>& fences, bool wait_all, uint64_t timeout)
+{
+    // completion handlers wake a waiter, so it sleeps instead of polling fences.
+    return fence_waiter_.wait(fences, wait_all, timeout);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 void Mtl_device::wait_idle()
 {
     lock_guard<mutex> lock {queue_mutex_};
@@ -129,19 +256,11 @@ void Mtl_device::wait_idle()
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Mtl_device::init_device_()
+void Mtl_device::init_device_(const Device_desc& desc)
 {
-#if TARGET_OS_OSX
-    for (id<MTLDevice> device in MTLCopyAllDevices()) {
-        if ([device.name isEqual:@"AMD Radeon Pro 5500M"])
-            continue;
-
-        device_ = device;
-        break;
-    }
-#else
-    device_ = MTLCreateSystemDefaultDevice();
-#endif
+    backend_ = Backend::metal;
+    adapter_ = select(enumerate(), desc);
+    device_ = query_devices()[adapter_.index];
 
     if (!device_)
         throw runtime_error("fail to create device");
@@ -21,7 +21,7 @@ class Mtl_fence final : public Fence {
 public:
     Mtl_fence(const Fence_desc& desc, Mtl_device* device);
 
-    void wait_signal() override;
+    bool wait_signal(uint64_t timeout = UINT64_MAX) override;
 
     void reset() override;
 
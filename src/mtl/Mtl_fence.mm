@@ -24,9 +24,11 @@ Mtl_fence::Mtl_fence(const Fence_desc& desc, Mtl_device* device) :
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Mtl_fence::wait_signal()
+bool Mtl_fence::wait_signal(uint64_t timeout)
 {
-    dispatch_semaphore_wait(semaphore_, DISPATCH_TIME_FOREVER);
+    auto time = (UINT64_MAX == timeout) ? DISPATCH_TIME_FOREVER : dispatch_time(DISPATCH_TIME_NOW, timeout);
+
+    return !dispatch_semaphore_wait(semaphore_, time);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -11,6 +11,27 @@
 using namespace std;
 using namespace Gfx_lib;
 
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline auto is_storage_format(Format format)
+{
+    switch (format) {
+        case Format::rgba8_unorm:
+        case Format::r32_float:
+        case Format::rg32_float:
+        case Format::rgba32_float:
+            return true;
+        default:
+            return false;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace
+
 namespace Gfx_lib {
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -50,6 +71,14 @@ void Mtl_image::init_texture_()
     descriptor.resourceOptions = MTLResourceStorageModePrivate;
     descriptor.usage = MTLTextureUsageShaderRead | MTLTextureUsageRenderTarget;
 
+    // a shader write disables a lossless compression, so it is only added on request.
+    if (storage_) {
+        if (!is_storage_format(format_) || Image_type::two_dim != type_ || 1 != samples_)
+            throw runtime_error("fail to create an image");
+
+        descriptor.usage |= MTLTextureUsageShaderWrite;
+    }
+
     // try to create a texture.
     texture_ = [device_->device() newTextureWithDescriptor:descriptor];
 
@@ -22,6 +22,8 @@ class Mtl_pipeline final : public Pipeline {
 public:
     Mtl_pipeline(const Pipeline_desc& desc, Mtl_device* device);
 
+    Mtl_pipeline(const Compute_pipeline_desc& desc, Mtl_device* device);
+
     Device* device() const override;
 
     inline auto render_pipeline_state() const noexcept
@@ -30,15 +32,21 @@ public:
     inline auto depth_stencil_state() const noexcept
     { return depth_stencil_state_; }
 
+    inline auto compute_pipeline_state() const noexcept
+    { return compute_pipeline_state_; }
+
 private:
     void init_render_pipeline_state_(Shader* vertex_shader, Shader* fragment_shader);
 
     void init_depth_stencil_state_();
 
+    void init_compute_pipeline_state_(Shader* compute_shader);
+
 private:
     Mtl_device* device_;
     id<MTLRenderPipelineState> render_pipeline_state_;
     id<MTLDepthStencilState> depth_stencil_state_;
+    id<MTLComputePipelineState> compute_pipeline_state_;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -45,7 +45,8 @@ Mtl_pipeline::Mtl_pipeline(const Pipeline_desc& desc, Mtl_device* device) :
     Pipeline {desc},
     device_ {device},
     render_pipeline_state_ {nil},
-    depth_stencil_state_ {nil}
+    depth_stencil_state_ {nil},
+    compute_pipeline_state_ {nil}
 {
     init_render_pipeline_state_(desc.vertex_shader, desc.fragment_shader);
     init_depth_stencil_state_();
@@ -53,6 +54,18 @@ Mtl_pipeline::Mtl_pipeline(const Pipeline_desc& desc, Mtl_device* device) :
 
 //----------------------------------------------------------------------------------------------------------------------
 
+Mtl_pipeline::Mtl_pipeline(const Compute_pipeline_desc& desc, Mtl_device* device) :
+    Pipeline {desc},
+    device_ {device},
+    render_pipeline_state_ {nil},
+    depth_stencil_state_ {nil},
+    compute_pipeline_state_ {nil}
+{
+    init_compute_pipeline_state_(desc.compute_shader);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 Device* Mtl_pipeline::device() const
 {
     return device_;
@@ -163,4 +176,18 @@ void Mtl_pipeline::init_depth_stencil_state_()
 
 //----------------------------------------------------------------------------------------------------------------------
 
+void Mtl_pipeline::init_compute_pipeline_state_(Shader* compute_shader)
+{
+    auto function = static_cast<Mtl_shader*>(compute_shader)->function();
+
+    // try to create a compute pipeline state.
+    compute_pipeline_state_ = [device_->device() newComputePipelineStateWithFunction:function
+                                                                               error:nil];
+
+    if (!compute_pipeline_state_)
+        throw runtime_error("fail to create the pipeline");
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 } // of namespace Gfx_lib
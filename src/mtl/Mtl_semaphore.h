@@ -0,0 +1,33 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_MTL_SEMAPHORE_GUARD
+#define GFX_MTL_SEMAPHORE_GUARD
+
+#include "Semaphore.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Mtl_device;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Mtl_semaphore final : public Semaphore {
+public:
+    Mtl_semaphore(const Semaphore_desc& desc, Mtl_device* device);
+
+    Device* device() const override;
+
+private:
+    Mtl_device* device_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_MTL_SEMAPHORE_GUARD
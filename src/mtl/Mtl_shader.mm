@@ -4,6 +4,7 @@
 //
 
 #include <sc/Msl_compiler.h>
+#include "spirv_lib.h"
 #include "mtl_lib.h"
 #include "Mtl_shader.h"
 #include "Mtl_device.h"
@@ -22,7 +23,8 @@ Mtl_shader::Mtl_shader(const Shader_desc& desc, Mtl_device* device) :
     function_ {nil}
 {
     init_signature_(desc.src);
-    init_function_(Msl_compiler().compile(desc.src));
+    // a push constant block is remapped to a uniform block, so it is placed at the index like other buffers.
+    init_function_(Msl_compiler().compile(remap_push_constants(desc.src, push_constant_index)));
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -17,6 +17,9 @@ namespace Gfx_lib {
 //----------------------------------------------------------------------------------------------------------------------
 
 constexpr auto vertex_buffer_index_offset = 31 - max_vertex_input_bindings;
+constexpr auto storage_buffer_index_offset = max_shader_buffers;
+constexpr auto storage_texture_index_offset = max_shader_textures;
+constexpr auto push_constant_index = max_shader_buffers;
 
 //----------------------------------------------------------------------------------------------------------------------
 
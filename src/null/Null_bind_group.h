@@ -0,0 +1,33 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_NULL_BIND_GROUP_GUARD
+#define GFX_NULL_BIND_GROUP_GUARD
+
+#include "Bind_group.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Null_device;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Null_bind_group final : public Bind_group {
+public:
+    Null_bind_group(const Bind_group_desc& desc, Null_device* device);
+
+    Device* device() const override;
+
+private:
+    Null_device* device_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_NULL_BIND_GROUP_GUARD
@@ -0,0 +1,64 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include <cstring>
+#include "std_lib.h"
+#include "Null_buffer.h"
+#include "Null_device.h"
+
+using namespace std;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Null_buffer::Null_buffer(const Buffer_desc& desc, Null_device* device) :
+    Buffer {desc},
+    device_ {device},
+    contents_ {}
+{
+    init_contents_(desc.data);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void* Null_buffer::map()
+{
+    device_->record(Null_call::buffer_map);
+
+    return contents_.get();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_buffer::unmap()
+{
+    device_->record(Null_call::buffer_unmap);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Device* Null_buffer::device() const
+{
+    return device_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_buffer::init_contents_(const void* data)
+{
+    // only host visible buffers need a storage for the front end to write into.
+    if (Heap_type::local == heap_type_)
+        return;
+
+    contents_ = make_unique<uint8_t[]>(size_);
+
+    if (data)
+        memcpy(contents_.get(), data, size_);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
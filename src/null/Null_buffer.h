@@ -0,0 +1,42 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_NULL_BUFFER_GUARD
+#define GFX_NULL_BUFFER_GUARD
+
+#include <memory>
+#include "Buffer.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Null_device;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Null_buffer final : public Buffer {
+public:
+    Null_buffer(const Buffer_desc& desc, Null_device* device);
+
+    void* map() override;
+
+    void unmap() override;
+
+    Device* device() const override;
+
+private:
+    void init_contents_(const void* data);
+
+private:
+    Null_device* device_;
+    std::unique_ptr<uint8_t[]> contents_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_NULL_BUFFER_GUARD
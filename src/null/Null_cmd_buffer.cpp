@@ -0,0 +1,357 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "std_lib.h"
+#include "Null_cmd_buffer.h"
+#include "Null_device.h"
+
+using namespace std;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Null_render_encoder::Null_render_encoder(const Render_encoder_desc& desc, Null_device* device,
+                                         Null_cmd_buffer* cmd_buffer) :
+    Render_encoder {},
+    device_ {device},
+    cmd_buffer_ {cmd_buffer}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_render_encoder::end()
+{
+    device_->record(Null_call::render_encoder_end);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_render_encoder::draw(uint32_t count, uint32_t first, uint32_t instance_count, uint32_t first_instance)
+{
+    device_->record(Null_call::render_encoder_draw);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_render_encoder::draw_indexed(uint32_t count, uint32_t first, uint32_t instance_count,
+                                       uint32_t first_instance, int32_t base_vertex)
+{
+    device_->record(Null_call::render_encoder_draw_indexed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_render_encoder::draw_indirect(Buffer* buffer, uint64_t offset, uint32_t draw_count, uint32_t stride)
+{
+    device_->record(Null_call::render_encoder_draw_indirect);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_render_encoder::draw_indexed_indirect(Buffer* buffer, uint64_t offset, uint32_t draw_count, uint32_t stride)
+{
+    device_->record(Null_call::render_encoder_draw_indexed_indirect);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_render_encoder::vertex_buffer(Buffer* buffer, uint64_t offset, uint32_t index)
+{
+    device_->record(Null_call::render_encoder_vertex_buffer);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_render_encoder::index_buffer(Buffer* buffer, uint64_t offset, Index_type index_type)
+{
+    device_->record(Null_call::render_encoder_index_buffer);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_render_encoder::shader_buffer(Buffer* buffer, uint32_t offset, uint32_t index)
+{
+    device_->record(Null_call::render_encoder_shader_buffer);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_render_encoder::shader_texture(Image* image, Sampler* sampler, uint32_t index)
+{
+    device_->record(Null_call::render_encoder_shader_texture);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_render_encoder::shader_bytes(Pipeline_stage stage, uint32_t offset, const void* data, uint32_t size)
+{
+    device_->record(Null_call::render_encoder_shader_bytes);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_render_encoder::bind_group(uint32_t index, Bind_group* bind_group, const vector<uint32_t>& dynamic_offsets)
+{
+    bind_group->validate_binding(index, dynamic_offsets);
+
+    device_->record(Null_call::render_encoder_bind_group);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_render_encoder::pipeline(Pipeline* pipeline)
+{
+    device_->record(Null_call::render_encoder_pipeline);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_render_encoder::viewport(const Viewport& viewport)
+{
+    device_->record(Null_call::render_encoder_viewport);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_render_encoder::scissor(const Scissor& scissor)
+{
+    device_->record(Null_call::render_encoder_scissor);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cmd_buffer* Null_render_encoder::cmd_buffer() const
+{
+    return cmd_buffer_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Null_parallel_render_encoder::Null_parallel_render_encoder(const Parallel_render_encoder_desc& desc,
+                                                           Null_device* device, Null_cmd_buffer* cmd_buffer) :
+    Parallel_render_encoder {},
+    device_ {device},
+    cmd_buffer_ {cmd_buffer},
+    desc_ {desc},
+    encoders_ {},
+    mutex_ {}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Render_encoder* Null_parallel_render_encoder::render_encoder()
+{
+    device_->record(Null_call::parallel_render_encoder_render_encoder);
+
+    lock_guard<mutex> lock {mutex_};
+
+    encoders_.push_back(make_unique<Null_render_encoder>(desc_.render_encoder, device_, cmd_buffer_));
+
+    return encoders_.back().get();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_parallel_render_encoder::end()
+{
+    device_->record(Null_call::parallel_render_encoder_end);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cmd_buffer* Null_parallel_render_encoder::cmd_buffer() const
+{
+    return cmd_buffer_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Null_blit_encoder::Null_blit_encoder(const Blit_encoder_desc& desc, Null_device* device,
+                                     Null_cmd_buffer* cmd_buffer) :
+    Blit_encoder {},
+    device_ {device},
+    cmd_buffer_ {cmd_buffer}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_blit_encoder::copy(Buffer* src_buffer, Buffer* dst_buffer, const Buffer_copy_region& region)
+{
+    device_->record(Null_call::blit_encoder_copy);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_blit_encoder::copy(Buffer* src_buffer, Image* dst_image, const Buffer_image_copy_region& region)
+{
+    device_->record(Null_call::blit_encoder_copy);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_blit_encoder::copy(Image* src_image, Buffer* dst_buffer, const Buffer_image_copy_region& region)
+{
+    device_->record(Null_call::blit_encoder_copy);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_blit_encoder::end()
+{
+    device_->record(Null_call::blit_encoder_end);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cmd_buffer* Null_blit_encoder::cmd_buffer() const
+{
+    return cmd_buffer_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Null_compute_encoder::Null_compute_encoder(const Compute_encoder_desc& desc, Null_device* device,
+                                           Null_cmd_buffer* cmd_buffer) :
+    Compute_encoder {},
+    device_ {device},
+    cmd_buffer_ {cmd_buffer}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_compute_encoder::end()
+{
+    device_->record(Null_call::compute_encoder_end);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_compute_encoder::dispatch(uint32_t x, uint32_t y, uint32_t z)
+{
+    device_->record(Null_call::compute_encoder_dispatch);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_compute_encoder::dispatch_indirect(Buffer* buffer, uint64_t offset)
+{
+    device_->record(Null_call::compute_encoder_dispatch_indirect);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_compute_encoder::shader_buffer(Buffer* buffer, uint32_t offset, uint32_t index)
+{
+    device_->record(Null_call::compute_encoder_shader_buffer);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_compute_encoder::shader_texture(Image* image, Sampler* sampler, uint32_t index)
+{
+    device_->record(Null_call::compute_encoder_shader_texture);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_compute_encoder::storage_buffer(Buffer* buffer, uint32_t offset, uint32_t index)
+{
+    device_->record(Null_call::compute_encoder_storage_buffer);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_compute_encoder::storage_image(Image* image, uint32_t index)
+{
+    device_->record(Null_call::compute_encoder_storage_image);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_compute_encoder::pipeline(Pipeline* pipeline)
+{
+    device_->record(Null_call::compute_encoder_pipeline);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cmd_buffer* Null_compute_encoder::cmd_buffer() const
+{
+    return cmd_buffer_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Null_cmd_buffer::Null_cmd_buffer(Null_device* device) :
+    Cmd_buffer {},
+    device_ {device}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Render_encoder> Null_cmd_buffer::create(const Render_encoder_desc& desc)
+{
+    device_->record(Null_call::cmd_buffer_create_render_encoder);
+
+    return make_unique<Null_render_encoder>(desc, device_, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Parallel_render_encoder> Null_cmd_buffer::create(const Parallel_render_encoder_desc& desc)
+{
+    device_->record(Null_call::cmd_buffer_create_parallel_render_encoder);
+
+    return make_unique<Null_parallel_render_encoder>(desc, device_, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Blit_encoder> Null_cmd_buffer::create(const Blit_encoder_desc& desc)
+{
+    device_->record(Null_call::cmd_buffer_create_blit_encoder);
+
+    return make_unique<Null_blit_encoder>(desc, device_, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Compute_encoder> Null_cmd_buffer::create(const Compute_encoder_desc& desc)
+{
+    device_->record(Null_call::cmd_buffer_create_compute_encoder);
+
+    return make_unique<Null_compute_encoder>(desc, device_, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_cmd_buffer::end()
+{
+    device_->record(Null_call::cmd_buffer_end);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_cmd_buffer::reset()
+{
+    device_->record(Null_call::cmd_buffer_reset);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Device* Null_cmd_buffer::device() const
+{
+    return device_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
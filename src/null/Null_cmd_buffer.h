@@ -0,0 +1,165 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_NULL_CMD_BUFFER_GUARD
+#define GFX_NULL_CMD_BUFFER_GUARD
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Cmd_buffer.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Null_device;
+class Null_cmd_buffer;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Null_render_encoder final : public Render_encoder {
+public:
+    Null_render_encoder(const Render_encoder_desc& desc, Null_device* device, Null_cmd_buffer* cmd_buffer);
+
+    void end() override;
+
+    void draw(uint32_t count, uint32_t first = 0, uint32_t instance_count = 1, uint32_t first_instance = 0) override;
+
+    void draw_indexed(uint32_t count, uint32_t first = 0, uint32_t instance_count = 1,
+                      uint32_t first_instance = 0, int32_t base_vertex = 0) override;
+
+    void draw_indirect(Buffer* buffer, uint64_t offset, uint32_t draw_count = 1,
+                       uint32_t stride = sizeof(Draw_indirect_args)) override;
+
+    void draw_indexed_indirect(Buffer* buffer, uint64_t offset, uint32_t draw_count = 1,
+                               uint32_t stride = sizeof(Draw_indexed_indirect_args)) override;
+
+    void vertex_buffer(Buffer* buffer, uint64_t offset, uint32_t index) override;
+
+    void index_buffer(Buffer* buffer, uint64_t offset, Index_type index_type) override;
+
+    void shader_buffer(Buffer* buffer, uint32_t offset, uint32_t index) override;
+
+    void shader_texture(Image* image, Sampler* sampler, uint32_t index) override;
+
+    void shader_bytes(Pipeline_stage stage, uint32_t offset, const void* data, uint32_t size) override;
+
+    void bind_group(uint32_t index, Bind_group* bind_group,
+                    const std::vector<uint32_t>& dynamic_offsets = {}) override;
+
+    void pipeline(Pipeline* pipeline) override;
+
+    void viewport(const Viewport& viewport) override;
+
+    void scissor(const Scissor& scissor) override;
+
+    Cmd_buffer* cmd_buffer() const override;
+
+private:
+    Null_device* device_;
+    Null_cmd_buffer* cmd_buffer_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Null_parallel_render_encoder final : public Parallel_render_encoder {
+public:
+    Null_parallel_render_encoder(const Parallel_render_encoder_desc& desc,
+                                 Null_device* device, Null_cmd_buffer* cmd_buffer);
+
+    Render_encoder* render_encoder() override;
+
+    void end() override;
+
+    Cmd_buffer* cmd_buffer() const override;
+
+private:
+    Null_device* device_;
+    Null_cmd_buffer* cmd_buffer_;
+    Parallel_render_encoder_desc desc_;
+    std::vector<std::unique_ptr<Null_render_encoder>> encoders_;
+    std::mutex mutex_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Null_blit_encoder final : public Blit_encoder {
+public:
+    Null_blit_encoder(const Blit_encoder_desc& desc, Null_device* device, Null_cmd_buffer* cmd_buffer);
+
+    void copy(Buffer* src_buffer, Buffer* dst_buffer, const Buffer_copy_region& region) override;
+
+    void copy(Buffer* src_buffer, Image* dst_image, const Buffer_image_copy_region& region) override;
+
+    void copy(Image* src_image, Buffer* dst_buffer, const Buffer_image_copy_region& region) override;
+
+    void end() override;
+
+    Cmd_buffer* cmd_buffer() const override;
+
+private:
+    Null_device* device_;
+    Null_cmd_buffer* cmd_buffer_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Null_compute_encoder final : public Compute_encoder {
+public:
+    Null_compute_encoder(const Compute_encoder_desc& desc, Null_device* device, Null_cmd_buffer* cmd_buffer);
+
+    void end() override;
+
+    void dispatch(uint32_t x, uint32_t y = 1, uint32_t z = 1) override;
+
+    void dispatch_indirect(Buffer* buffer, uint64_t offset = 0) override;
+
+    void shader_buffer(Buffer* buffer, uint32_t offset, uint32_t index) override;
+
+    void shader_texture(Image* image, Sampler* sampler, uint32_t index) override;
+
+    void storage_buffer(Buffer* buffer, uint32_t offset, uint32_t index) override;
+
+    void storage_image(Image* image, uint32_t index) override;
+
+    void pipeline(Pipeline* pipeline) override;
+
+    Cmd_buffer* cmd_buffer() const override;
+
+private:
+    Null_device* device_;
+    Null_cmd_buffer* cmd_buffer_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Null_cmd_buffer final : public Cmd_buffer {
+public:
+    Null_cmd_buffer(Null_device* device);
+
+    std::unique_ptr<Render_encoder> create(const Render_encoder_desc& desc) override;
+
+    std::unique_ptr<Parallel_render_encoder> create(const Parallel_render_encoder_desc& desc) override;
+
+    std::unique_ptr<Blit_encoder> create(const Blit_encoder_desc& desc) override;
+
+    std::unique_ptr<Compute_encoder> create(const Compute_encoder_desc& desc) override;
+
+    void end() override;
+
+    void reset() override;
+
+    Device* device() const override;
+
+private:
+    Null_device* device_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_NULL_CMD_BUFFER_GUARD
@@ -0,0 +1,247 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "std_lib.h"
+#include "Null_device.h"
+#include "Null_buffer.h"
+#include "Null_image.h"
+#include "Null_sampler.h"
+#include "Null_shader.h"
+#include "Null_pipeline.h"
+#include "Null_bind_group.h"
+#include "Null_swap_chain.h"
+#include "Null_cmd_buffer.h"
+#include "Null_fence.h"
+#include "Null_semaphore.h"
+#include "Host_timeline.h"
+
+using namespace std;
+using namespace std::chrono;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Null_device::Null_device(const Device_desc& desc) :
+    Device(),
+    epoch_ {steady_clock::now()},
+    counters_ {}
+{
+    init_adapter_(desc);
+    init_caps_();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::vector<Adapter> Null_device::enumerate()
+{
+    return {{0, "Null", Adapter_type::other, 0, 1}};
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Buffer> Null_device::create(const Buffer_desc& desc)
+{
+    record(Null_call::device_create_buffer);
+
+    return make_unique<Null_buffer>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Image> Null_device::create(const Image_desc& desc)
+{
+    record(Null_call::device_create_image);
+
+    return make_unique<Null_image>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Sampler> Null_device::create(const Sampler_desc& desc)
+{
+    record(Null_call::device_create_sampler);
+
+    return make_unique<Null_sampler>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Shader> Null_device::create(const Shader_desc& desc)
+{
+    record(Null_call::device_create_shader);
+
+    return make_unique<Null_shader>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Pipeline> Null_device::create(const Pipeline_desc& desc)
+{
+    record(Null_call::device_create_pipeline);
+
+    return make_unique<Null_pipeline>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Pipeline> Null_device::create(const Compute_pipeline_desc& desc)
+{
+    record(Null_call::device_create_compute_pipeline);
+
+    return make_unique<Null_pipeline>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Bind_group> Null_device::create(const Bind_group_desc& desc)
+{
+    record(Null_call::device_create_bind_group);
+
+    return make_unique<Null_bind_group>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Swap_chain> Null_device::create(const Swap_chain_desc& desc)
+{
+    record(Null_call::device_create_swap_chain);
+
+    return make_unique<Null_swap_chain>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Cmd_buffer> Null_device::create(const Cmd_buffer_desc& desc)
+{
+    record(Null_call::device_create_cmd_buffer);
+
+    return make_unique<Null_cmd_buffer>(this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Fence> Null_device::create(const Fence_desc& desc)
+{
+    record(Null_call::device_create_fence);
+
+    return make_unique<Null_fence>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Semaphore> Null_device::create(const Semaphore_desc& desc)
+{
+    record(Null_call::device_create_semaphore);
+
+    return make_unique<Null_semaphore>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Timeline> Null_device::create(const Timeline_desc& desc)
+{
+    record(Null_call::device_create_timeline);
+
+    return make_unique<Host_timeline>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_device::submit(Cmd_buffer* cmd_buffer, Fence* fence)
+{
+    record(Null_call::device_submit);
+
+    // there is no work to execute, so a submission completes immediately.
+    if (fence)
+        static_cast<Null_fence*>(fence)->signal();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_device::submit(const std::vector<Submit_desc>& descs, Fence* fence)
+{
+    record(Null_call::device_submit_batch);
+
+    // there is no work to execute, so a submission completes immediately.
+    for (auto& desc : descs) {
+        if (desc.timeline)
+            desc.timeline->signal(desc.timeline_value);
+    }
+
+    if (fence)
+        static_cast<Null_fence*>(fence)->signal();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+bool Null_device::wait(const std::vector<Fence*>& fences, bool wait_all, uint64_t timeout)
+{
+    record(Null_call::device_wait);
+
+    return Device::wait(fences, wait_all, timeout);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_device::wait_idle()
+{
+    record(Null_call::device_wait_idle);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_device::record(Null_call call) noexcept
+{
+    auto& counter = counters_[etoi(call)];
+    auto time = duration_cast<nanoseconds>(steady_clock::now() - epoch_).count();
+
+    if (!counter.count.fetch_add(1, memory_order_relaxed))
+        counter.first_time.store(time, memory_order_relaxed);
+
+    counter.last_time.store(time, memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Null_counter Null_device::counter(Null_call call) const noexcept
+{
+    auto& counter = counters_[etoi(call)];
+
+    return {counter.count.load(memory_order_relaxed),
+            counter.first_time.load(memory_order_relaxed),
+            counter.last_time.load(memory_order_relaxed)};
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_device::reset_counters() noexcept
+{
+    for (auto& counter : counters_) {
+        counter.count.store(0, memory_order_relaxed);
+        counter.first_time.store(0, memory_order_relaxed);
+        counter.last_time.store(0, memory_order_relaxed);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_device::init_adapter_(const Device_desc& desc)
+{
+    backend_ = Backend::null;
+    adapter_ = select(enumerate(), desc);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_device::init_caps_()
+{
+    caps_.window_coords = Coords::origin_upper_left;
+    caps_.texture_coords = Coords::origin_upper_left;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
@@ -0,0 +1,63 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "Null_fence.h"
+#include "Null_device.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Null_fence::Null_fence(const Fence_desc& desc, Null_device* device) :
+    Fence {},
+    device_ {device},
+    signaled_ {desc.signaled}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+bool Null_fence::wait_signal(uint64_t timeout)
+{
+    device_->record(Null_call::fence_wait_signal);
+
+    return signaled_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_fence::reset()
+{
+    device_->record(Null_call::fence_reset);
+
+    signaled_ = false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Device* Null_fence::device() const
+{
+    return device_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+bool Null_fence::signaled() const
+{
+    device_->record(Null_call::fence_signaled);
+
+    return signaled_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_fence::signal() noexcept
+{
+    signaled_ = true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
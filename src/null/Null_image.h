@@ -0,0 +1,33 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_NULL_IMAGE_GUARD
+#define GFX_NULL_IMAGE_GUARD
+
+#include "Image.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Null_device;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Null_image final : public Image {
+public:
+    Null_image(const Image_desc& desc, Null_device* device);
+
+    Device* device() const override;
+
+private:
+    Null_device* device_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_NULL_IMAGE_GUARD
@@ -0,0 +1,36 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "Null_pipeline.h"
+#include "Null_device.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Null_pipeline::Null_pipeline(const Pipeline_desc& desc, Null_device* device) :
+    Pipeline {desc},
+    device_ {device}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Null_pipeline::Null_pipeline(const Compute_pipeline_desc& desc, Null_device* device) :
+    Pipeline {desc},
+    device_ {device}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Device* Null_pipeline::device() const
+{
+    return device_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
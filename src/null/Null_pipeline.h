@@ -0,0 +1,35 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_NULL_PIPELINE_GUARD
+#define GFX_NULL_PIPELINE_GUARD
+
+#include "Pipeline.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Null_device;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Null_pipeline final : public Pipeline {
+public:
+    Null_pipeline(const Pipeline_desc& desc, Null_device* device);
+
+    Null_pipeline(const Compute_pipeline_desc& desc, Null_device* device);
+
+    Device* device() const override;
+
+private:
+    Null_device* device_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_NULL_PIPELINE_GUARD
@@ -0,0 +1,33 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_NULL_SAMPLER_GUARD
+#define GFX_NULL_SAMPLER_GUARD
+
+#include "Sampler.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Null_device;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Null_sampler final : public Sampler {
+public:
+    Null_sampler(const Sampler_desc& desc, Null_device* device);
+
+    Device* device() const override;
+
+private:
+    Null_device* device_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_NULL_SAMPLER_GUARD
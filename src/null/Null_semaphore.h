@@ -0,0 +1,33 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_NULL_SEMAPHORE_GUARD
+#define GFX_NULL_SEMAPHORE_GUARD
+
+#include "Semaphore.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Null_device;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Null_semaphore final : public Semaphore {
+public:
+    Null_semaphore(const Semaphore_desc& desc, Null_device* device);
+
+    Device* device() const override;
+
+private:
+    Null_device* device_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_NULL_SEMAPHORE_GUARD
@@ -0,0 +1,48 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "std_lib.h"
+#include "Null_shader.h"
+#include "Null_device.h"
+
+using namespace std;
+using namespace Sc_lib;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Null_shader::Null_shader(const Shader_desc& desc, Null_device* device) :
+    Shader {desc},
+    device_ {device},
+    signature_ {}
+{
+    init_signature_(desc.src);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Device* Null_shader::device() const
+{
+    return device_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Sc_lib::Signature Null_shader::reflect() const noexcept
+{
+    return signature_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_shader::init_signature_(const std::vector<uint32_t>& src)
+{
+    signature_ = Spirv_reflector().reflect(src);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
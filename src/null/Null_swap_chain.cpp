@@ -0,0 +1,74 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "std_lib.h"
+#include "Null_swap_chain.h"
+#include "Null_device.h"
+#include "Null_image.h"
+
+using namespace std;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Null_swap_chain::Null_swap_chain(const Swap_chain_desc& desc, Null_device* device) :
+    Swap_chain {desc},
+    device_ {device},
+    images_ {}
+{
+    init_images_(desc.image_count);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Null_swap_chain::~Null_swap_chain()
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Image* Null_swap_chain::acquire()
+{
+    device_->record(Null_call::swap_chain_acquire);
+
+    return images_[frame_count_ % images_.size()].get();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_swap_chain::present()
+{
+    device_->record(Null_call::swap_chain_present);
+
+    ++frame_count_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Device* Null_swap_chain::device() const
+{
+    return device_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Null_swap_chain::init_images_(uint32_t count)
+{
+    // configure an image desc.
+    Image_desc desc;
+
+    desc.type = Image_type::swap_chain;
+    desc.format = image_format_;
+    desc.extent = image_extent_;
+
+    // create images.
+    for (auto i = 0; i != count; ++i)
+        images_.push_back(make_unique<Null_image>(desc, device_));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
@@ -0,0 +1,46 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_NULL_SWAP_CHAIN_GUARD
+#define GFX_NULL_SWAP_CHAIN_GUARD
+
+#include <memory>
+#include <vector>
+#include "Swap_chain.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Null_device;
+class Null_image;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Null_swap_chain final : public Swap_chain {
+public:
+    Null_swap_chain(const Swap_chain_desc& desc, Null_device* device);
+
+    ~Null_swap_chain() override;
+
+    Image* acquire() override;
+
+    void present() override;
+
+    Device* device() const override;
+
+private:
+    void init_images_(uint32_t count);
+
+private:
+    Null_device* device_;
+    std::vector<std::unique_ptr<Null_image>> images_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_NULL_SWAP_CHAIN_GUARD
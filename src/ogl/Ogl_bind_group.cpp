@@ -0,0 +1,77 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "std_lib.h"
+#include "ogl_lib.h"
+#include "Ogl_bind_group.h"
+#include "Ogl_device.h"
+#include "Ogl_buffer.h"
+#include "Ogl_image.h"
+#include "Ogl_sampler.h"
+
+using namespace std;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Ogl_bind_group::Ogl_bind_group(const Bind_group_desc& desc, Ogl_device* device) :
+    Bind_group {desc},
+    device_ {device},
+    buffers_ {},
+    textures_ {}
+{
+    init_bindings_();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Device* Ogl_bind_group::device() const
+{
+    return device_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_bind_group::bind(const vector<uint32_t>& dynamic_offsets) const
+{
+    for (auto i = 0; i != buffers_.size(); ++i) {
+        auto& buffer = buffers_[i];
+        auto offset = dynamic_offsets.empty() ? 0 : dynamic_offsets[i];
+
+        glBindBufferRange(GL_UNIFORM_BUFFER, buffer.index, buffer.buffer, offset, buffer.size - offset);
+    }
+
+    for (auto& texture : textures_) {
+        glActiveTexture(GL_TEXTURE0 + texture.index);
+        glBindTexture(texture.target, texture.texture);
+        glBindSampler(texture.index, texture.sampler);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_bind_group::init_bindings_()
+{
+    // names are resolved once, so a bind only issues gl calls.
+    for (auto& entry : entries_) {
+        if (entry.buffer) {
+            auto buffer_impl = static_cast<Ogl_buffer*>(entry.buffer);
+
+            buffers_.push_back({entry.index, buffer_impl->buffer(), static_cast<GLsizeiptr>(buffer_impl->size())});
+        }
+        else {
+            auto image_impl = static_cast<Ogl_image*>(entry.image);
+            auto sampler_impl = static_cast<Ogl_sampler*>(entry.sampler);
+
+            textures_.push_back({entry.index, to_GLTextureTarget(image_impl->type()), image_impl->texture(),
+                                 sampler_impl->sampler()});
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
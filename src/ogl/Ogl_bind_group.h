@@ -0,0 +1,59 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_OGL_BIND_GROUP_GUARD
+#define GFX_OGL_BIND_GROUP_GUARD
+
+#include <vector>
+#include <GLES3/gl31.h>
+#include "Bind_group.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Ogl_device;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Ogl_bind_buffer final {
+    GLuint index;
+    GLuint buffer;
+    GLsizeiptr size;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Ogl_bind_texture final {
+    GLuint index;
+    GLenum target;
+    GLuint texture;
+    GLuint sampler;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Ogl_bind_group final : public Bind_group {
+public:
+    Ogl_bind_group(const Bind_group_desc& desc, Ogl_device* device);
+
+    Device* device() const override;
+
+    void bind(const std::vector<uint32_t>& dynamic_offsets) const;
+
+private:
+    void init_bindings_();
+
+private:
+    Ogl_device* device_;
+    std::vector<Ogl_bind_buffer> buffers_;
+    std::vector<Ogl_bind_texture> textures_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_OGL_BIND_GROUP_GUARD
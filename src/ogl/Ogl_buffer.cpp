@@ -7,6 +7,8 @@
 #include "Ogl_buffer.h"
 #include "Ogl_device.h"
 
+using namespace std;
+
 namespace Gfx_lib {
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -15,7 +17,8 @@ Ogl_buffer::Ogl_buffer(const Buffer_desc& desc, Ogl_device* device) :
     Buffer {desc},
     device_ {device},
     buffer_ {0},
-    contents_ {nullptr}
+    contents_ {nullptr},
+    persistent_ {false}
 {
     init_buffer_(desc.data);
 }
@@ -31,8 +34,11 @@ Ogl_buffer::~Ogl_buffer()
 
 void* Ogl_buffer::map()
 {
-    if (!contents_)
-        contents_ = glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, size_, GL_MAP_WRITE_BIT | GL_MAP_READ_BIT);
+    // an upload buffer is mapped without a sync, a caller doesn't overwrite contents in flight like other backends.
+    if (!contents_) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer_);
+        contents_ = glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, size_, to_GLMapAccess(heap_type_));
+    }
 
     return contents_;
 }
@@ -41,6 +47,11 @@ void* Ogl_buffer::map()
 
 void Ogl_buffer::unmap()
 {
+    // a persistent mapping is coherent, so it stays mapped until a buffer is deleted.
+    if (persistent_ || !contents_)
+        return;
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer_);
     glUnmapBuffer(GL_COPY_WRITE_BUFFER);
     contents_ = nullptr;
 }
@@ -58,18 +69,35 @@ void Ogl_buffer::init_buffer_(const void* data)
 {
     glGenBuffers(1, &buffer_);
     glBindBuffer(GL_COPY_WRITE_BUFFER, buffer_);
-    glBufferData(GL_COPY_WRITE_BUFFER, size_, data, to_GLDataUsage(heap_type_));
 
-    if (Heap_type::local != heap_type_) {
-        contents_ = glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, size_, GL_MAP_READ_BIT | GL_MAP_WRITE_BIT);
-        unmap();
-    }
+    if (Heap_type::local != heap_type_ && glBufferStorage)
+        init_storage_(data);
+    else
+        glBufferData(GL_COPY_WRITE_BUFFER, size_, data, to_GLDataUsage(heap_type_));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_buffer::init_storage_(const void* data)
+{
+    constexpr GLbitfield access {GL_MAP_READ_BIT | GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT_EXT |
+                                 GL_MAP_COHERENT_BIT_EXT};
+
+    // a storage stays writable by gl calls, a buffer can be a destination of a copy.
+    glBufferStorage(GL_COPY_WRITE_BUFFER, size_, data, access | GL_DYNAMIC_STORAGE_BIT_EXT);
+    contents_ = glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, size_, access);
+
+    if (!contents_)
+        throw runtime_error("fail to create a buffer");
+
+    persistent_ = true;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
 void Ogl_buffer::fini_buffer_()
 {
+    device_->release_vertex_arrays(buffer_);
     glDeleteBuffers(1, &buffer_);
 }
 
@@ -6,7 +6,7 @@
 #ifndef GFX_OGL_BUFFER_GUARD
 #define GFX_OGL_BUFFER_GUARD
 
-#include <GLES3/gl3.h>
+#include <GLES3/gl31.h>
 #include "Buffer.h"
 
 namespace Gfx_lib {
@@ -35,12 +35,15 @@ public:
 private:
     void init_buffer_(const void* data);
 
+    void init_storage_(const void* data);
+
     void fini_buffer_();
 
 private:
     Ogl_device* device_;
     GLuint buffer_;
     void* contents_;
+    bool persistent_;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
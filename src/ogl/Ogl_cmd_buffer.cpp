@@ -11,6 +11,7 @@
 #include "Ogl_image.h"
 #include "Ogl_sampler.h"
 #include "Ogl_pipeline.h"
+#include "Ogl_bind_group.h"
 
 using namespace std;
 using namespace Gfx_lib;
@@ -19,6 +20,18 @@ namespace {
 
 //----------------------------------------------------------------------------------------------------------------------
 
+inline auto is_depth_stencil_format(Format format)
+{
+    switch (format) {
+        case Format::d24_unorm_s8_uint:
+            return true;
+        default:
+            return false;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 inline auto component_count(Format format)
 {
     switch (format) {
@@ -112,11 +125,16 @@ Ogl_render_encoder::Ogl_render_encoder(const Render_encoder_desc& desc, Ogl_devi
     Render_encoder {},
     device_ {device},
     cmd_buffer_ {cmd_buffer},
+    primary_encoder_ {nullptr},
     framebuffer_ {nullptr},
     vertex_streams_ {},
     index_stream_ {},
     index_type_ {Index_type::invalid},
     arg_table_ {},
+    push_constants_ {},
+    push_constants_dirty_ {false},
+    vertex_array_desc_ {},
+    vertex_array_dirty_ {true},
     pipeline_ {nullptr},
     viewport_ {},
     scissor_ {},
@@ -128,8 +146,35 @@ Ogl_render_encoder::Ogl_render_encoder(const Render_encoder_desc& desc, Ogl_devi
 
 //----------------------------------------------------------------------------------------------------------------------
 
+Ogl_render_encoder::Ogl_render_encoder(Ogl_render_encoder* primary_encoder) :
+    Render_encoder {},
+    device_ {primary_encoder->device_},
+    cmd_buffer_ {primary_encoder->cmd_buffer_},
+    primary_encoder_ {primary_encoder},
+    framebuffer_ {primary_encoder->framebuffer_},
+    vertex_streams_ {},
+    index_stream_ {},
+    index_type_ {Index_type::invalid},
+    arg_table_ {},
+    push_constants_ {},
+    push_constants_dirty_ {false},
+    vertex_array_desc_ {},
+    vertex_array_dirty_ {true},
+    pipeline_ {nullptr},
+    viewport_ {},
+    scissor_ {},
+    discards_ {}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 void Ogl_render_encoder::end()
 {
+    // a context is current on one thread, so the parallel render encoder executes recorded commands.
+    if (primary_encoder_)
+        return;
+
     end_render_pass_();
 
     for_each(cmds_, execute);
@@ -137,26 +182,103 @@ void Ogl_render_encoder::end()
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Ogl_render_encoder::draw(uint32_t count, uint32_t first)
+void Ogl_render_encoder::draw(uint32_t count, uint32_t first, uint32_t instance_count, uint32_t first_instance)
 {
+    if (first_instance && !glDrawArraysInstancedBaseInstance)
+        throw runtime_error("fail to draw with a first instance");
+
+    bind_vertex_array_();
+    bind_push_constants_();
+
     auto input_assembly = pipeline_->input_assembly();
 
     cmds_.emplace_back([=]() {
-        glDrawArrays(to_GLPrimitiveMode(input_assembly.topology), first, count);
+        auto mode = to_GLPrimitiveMode(input_assembly.topology);
+
+        if (first_instance)
+            glDrawArraysInstancedBaseInstance(mode, first, count, instance_count, first_instance);
+        else
+            glDrawArraysInstanced(mode, first, count, instance_count);
     });
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Ogl_render_encoder::draw_indexed(uint32_t count, uint32_t first)
+void Ogl_render_encoder::draw_indexed(uint32_t count, uint32_t first, uint32_t instance_count,
+                                      uint32_t first_instance, int32_t base_vertex)
 {
+    if (first_instance && !glDrawElementsInstancedBaseVertexBaseInstance)
+        throw runtime_error("fail to draw with a first instance");
+
+    if (base_vertex && !glDrawElementsInstancedBaseVertex)
+        throw runtime_error("fail to draw with a base vertex");
+
+    bind_vertex_array_();
+    bind_push_constants_();
+
     auto input_assembly = pipeline_->input_assembly();
+    auto index_stream = index_stream_;
 
     cmds_.emplace_back([=]() {
-        auto offset = index_stream_.offset + first * byte_size(index_stream_.index_type);
+        auto mode = to_GLPrimitiveMode(input_assembly.topology);
+        auto type = to_GLIndexType(index_stream.index_type);
+        auto offset = index_stream.offset + first * byte_size(index_stream.index_type);
+        auto indices = reinterpret_cast<void*>(offset);
+
+        if (first_instance)
+            glDrawElementsInstancedBaseVertexBaseInstance(mode, count, type, indices,
+                                                          instance_count, base_vertex, first_instance);
+        else if (base_vertex)
+            glDrawElementsInstancedBaseVertex(mode, count, type, indices, instance_count, base_vertex);
+        else
+            glDrawElementsInstanced(mode, count, type, indices, instance_count);
+    });
+}
 
-        glDrawElements(to_GLPrimitiveMode(input_assembly.topology),
-                count, to_GLIndexType(index_type_), reinterpret_cast<void*>(offset));
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_render_encoder::draw_indirect(Buffer* buffer, uint64_t offset, uint32_t draw_count, uint32_t stride)
+{
+    bind_vertex_array_();
+    bind_push_constants_();
+
+    auto input_assembly = pipeline_->input_assembly();
+    auto buffer_impl = static_cast<Ogl_buffer*>(buffer);
+
+    cmds_.emplace_back([=]() {
+        auto mode = to_GLPrimitiveMode(input_assembly.topology);
+
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffer_impl->buffer());
+
+        // OpenGL ES reads a single draw from an indirect buffer.
+        for (uint32_t i = 0; i != draw_count; ++i)
+            glDrawArraysIndirect(mode, reinterpret_cast<void*>(offset + i * stride));
+    });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_render_encoder::draw_indexed_indirect(Buffer* buffer, uint64_t offset, uint32_t draw_count, uint32_t stride)
+{
+    // the first index of an indirect draw is relative to the start of an index buffer.
+    if (index_stream_.offset)
+        throw runtime_error("fail to draw indirect with an index buffer offset");
+
+    bind_vertex_array_();
+    bind_push_constants_();
+
+    auto input_assembly = pipeline_->input_assembly();
+    auto index_type = index_stream_.index_type;
+    auto buffer_impl = static_cast<Ogl_buffer*>(buffer);
+
+    cmds_.emplace_back([=]() {
+        auto mode = to_GLPrimitiveMode(input_assembly.topology);
+
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffer_impl->buffer());
+
+        // OpenGL ES reads a single draw from an indirect buffer.
+        for (uint32_t i = 0; i != draw_count; ++i)
+            glDrawElementsIndirect(mode, to_GLIndexType(index_type), reinterpret_cast<void*>(offset + i * stride));
     });
 }
 
@@ -170,16 +292,7 @@ void Ogl_render_encoder::vertex_buffer(Buffer* buffer, uint64_t offset, uint32_t
         return;
 
     vertex_streams_[index] = vertex_stream;
-
-    if (!pipeline_)
-        return;
-
-    auto vertex_streams = vertex_streams_;
-    auto vertex_input = pipeline_->vertex_input();
-
-    cmds_.emplace_back([=]() {
-        set_up_vertex_input_(vertex_streams, vertex_input);
-    });
+    vertex_array_dirty_ = true;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -192,10 +305,7 @@ void Ogl_render_encoder::index_buffer(Buffer* buffer, uint64_t offset, Index_typ
         return;
 
     index_stream_ = index_stream;
-
-    cmds_.emplace_back([=]() {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_stream.buffer->buffer());
-    });
+    vertex_array_dirty_ = true;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -242,6 +352,46 @@ void Ogl_render_encoder::shader_texture(Image* image, Sampler* sampler, uint32_t
 
 //----------------------------------------------------------------------------------------------------------------------
 
+void Ogl_render_encoder::shader_bytes(Pipeline_stage stage, uint32_t offset, const void* data, uint32_t size)
+{
+    if (max_push_constant_size < offset + size)
+        throw runtime_error("fail to set shader bytes");
+
+    // bytes are uploaded at a draw, one block is shared by stages, so a stage is ignored like other backends.
+    copy_n(static_cast<const uint8_t*>(data), size, push_constants_.begin() + offset);
+    push_constants_dirty_ = true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_render_encoder::bind_group(uint32_t index, Bind_group* bind_group, const vector<uint32_t>& dynamic_offsets)
+{
+    bind_group->validate_binding(index, dynamic_offsets);
+
+    auto bind_group_impl = static_cast<Ogl_bind_group*>(bind_group);
+
+    cmds_.emplace_back([=]() {
+        bind_group_impl->bind(dynamic_offsets);
+    });
+
+    auto offset_index = 0;
+
+    // update an arg tables, later shader buffers and textures are compared with a group.
+    for (auto& entry : bind_group_impl->entries()) {
+        if (entry.buffer) {
+            auto offset = dynamic_offsets.empty() ? 0 : dynamic_offsets[offset_index++];
+
+            arg_table_.arg_buffer({static_cast<Ogl_buffer*>(entry.buffer), offset}, entry.index);
+        }
+        else {
+            arg_table_.arg_texture({static_cast<Ogl_image*>(entry.image), static_cast<Ogl_sampler*>(entry.sampler)},
+                                   entry.index);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 void Ogl_render_encoder::pipeline(Pipeline* pipeline)
 {
     auto pipeline_impl = static_cast<Ogl_pipeline*>(pipeline);
@@ -250,15 +400,17 @@ void Ogl_render_encoder::pipeline(Pipeline* pipeline)
         return;
 
     pipeline_ = pipeline_impl;
+    push_constants_dirty_ = true;
+    vertex_array_dirty_ = true;
 
-    auto vertex_streams = vertex_streams_;
+    auto state_cache = device_->state_cache();
 
+    // a shadow of a context filters out states which a previous pipeline already set.
     cmds_.emplace_back([=]() {
-        glUseProgram(pipeline_impl->program());
-        set_up_vertex_input_(vertex_streams, pipeline_impl->vertex_input());
-        set_up_rasterization_(pipeline_impl->rasterization());
-        set_up_depth_stencil_(pipeline_impl->depth_stencil());
-        set_up_color_blend_(pipeline_impl->color_blend());
+        state_cache->program(pipeline_impl->program());
+        state_cache->rasterization(pipeline_impl->rasterization());
+        state_cache->depth_stencil(pipeline_impl->depth_stencil());
+        state_cache->color_blend(pipeline_impl->color_blend());
     });
 }
 
@@ -338,8 +490,11 @@ void Ogl_render_encoder::begin_render_pass_(const Render_encoder_desc& desc)
                 clear_color[3] = color.clear_value.a;
             }
 
-            if (Load_op::dont_care != color.load_op)
+            // a clear is masked by a write mask, so all channels are written.
+            if (Load_op::dont_care != color.load_op) {
+                device_->state_cache()->color_mask(i, 0xF);
                 glClearBufferfv(GL_COLOR, i, &clear_color[0]);
+            }
 
             if (Store_op::dont_care == desc.colors[i].store_op)
                 discards_.push_back(GL_COLOR_ATTACHMENT0 + i);
@@ -355,8 +510,10 @@ void Ogl_render_encoder::begin_render_pass_(const Render_encoder_desc& desc)
                 s = depth_stencil.clear_value.s;
             }
 
-            if (Load_op::dont_care != depth_stencil.load_op)
+            if (Load_op::dont_care != depth_stencil.load_op) {
+                device_->state_cache()->depth_mask(true);
                 glClearBufferfi(GL_DEPTH_STENCIL, 0, d, s);
+            }
 
             if (Store_op::dont_care == depth_stencil.store_op)
                 discards_.push_back(GL_DEPTH_STENCIL_ATTACHMENT);
@@ -379,99 +536,116 @@ void Ogl_render_encoder::end_render_pass_()
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Ogl_render_encoder::set_up_vertex_input_(const std::array<Ogl_vertex_stream, 2>& vertex_streams,
-                                              const Vertex_input& vertex_input)
+void Ogl_render_encoder::bind_vertex_array_()
 {
-    for (auto i = 0; i != 2; ++i) {
-        auto& vertex_stream = vertex_streams[i];
+    if (!vertex_array_dirty_)
+        return;
+
+    vertex_array_dirty_ = false;
+
+    // a description mirrors states of a vertex array, so it is built from a pipeline and streams.
+    Ogl_vertex_array_desc desc {};
+    auto vertex_input = pipeline_->vertex_input();
+
+    for (GLuint i = 0; i != max_vertex_input_attributes; ++i) {
+        auto& attribute = vertex_input.attributes[i];
+
+        if (Format::invalid == attribute.format || vertex_streams_.size() <= attribute.binding)
+            continue;
+
+        auto& vertex_stream = vertex_streams_[attribute.binding];
 
         if (!vertex_stream.buffer)
             continue;
 
-        auto& binding = vertex_input.bindings[i];
+        auto& binding = vertex_input.bindings[attribute.binding];
 
-        glBindBuffer(GL_ARRAY_BUFFER, vertex_stream.buffer->buffer());
+        desc.attributes[i].offset = vertex_stream.offset + attribute.offset;
+        desc.attributes[i].buffer = vertex_stream.buffer->buffer();
+        desc.attributes[i].size = component_count(attribute.format);
+        desc.attributes[i].type = to_GLDataType(attribute.format);
+        desc.attributes[i].stride = binding.stride;
+        desc.attributes[i].divisor = Step_rate::instance == binding.step_rate ? 1 : 0;
+        desc.attributes[i].enabled = GL_TRUE;
+    }
 
-        for (GLuint j = 0; j != 16; ++j) {
-            auto& attribute = vertex_input.attributes[j];
+    if (index_stream_.buffer)
+        desc.index_buffer = index_stream_.buffer->buffer();
 
-            if (i != attribute.binding)
-                continue;
+    // pipelines with a same vertex input and same streams share a bound vertex array.
+    if (vertex_array_desc_ == desc)
+        return;
 
-            if (Format::invalid == attribute.format) {
-                glDisableVertexAttribArray(j);
-            }
-            else {
-                glEnableVertexAttribArray(j);
-                glVertexAttribPointer(j,
-                                      component_count(attribute.format),
-                                      to_GLDataType(attribute.format),
-                                      GL_FALSE,
-                                      binding.stride,
-                                      reinterpret_cast<void*>(vertex_stream.offset + attribute.offset));
-            }
-        }
-    }
+    vertex_array_desc_ = desc;
+
+    auto device = device_;
+
+    cmds_.emplace_back([=]() {
+        glBindVertexArray(device->vertex_array(desc)->vertex_array());
+    });
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Ogl_render_encoder::set_up_rasterization_(const Rasterization& rasterization)
+void Ogl_render_encoder::bind_push_constants_()
 {
-    if (Cull_mode::none == rasterization.cull_mode) {
-        glDisable(GL_CULL_FACE);
-    }
-    else {
-        glEnable(GL_CULL_FACE);
-        glCullFace(to_GLCullMode(rasterization.cull_mode));
-    }
+    auto size = pipeline_->push_constants().size;
+
+    if (!push_constants_dirty_ || !size)
+        return;
+
+    push_constants_dirty_ = false;
+
+    auto push_constants = push_constants_;
+
+    // a block is written to a ring and bound as a uniform buffer, there is no buffer to map.
+    cmds_.emplace_back([=]() {
+        auto uniform_ring = device_->uniform_ring();
+        auto offset = uniform_ring->write(push_constants.data(), size);
+
+        glBindBufferRange(GL_UNIFORM_BUFFER, push_constant_binding, uniform_ring->buffer(), offset, size);
+    });
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Ogl_render_encoder::set_up_depth_stencil_(const Depth_stencil& depth_stencil)
+Ogl_parallel_render_encoder::Ogl_parallel_render_encoder(const Parallel_render_encoder_desc& desc,
+                                                         Ogl_device* device, Ogl_cmd_buffer* cmd_buffer) :
+    Parallel_render_encoder {},
+    cmd_buffer_ {cmd_buffer},
+    encoder_ {desc.render_encoder, device, cmd_buffer},
+    encoders_ {},
+    mutex_ {}
 {
-    if (depth_stencil.depth_test) {
-        glEnable(GL_DEPTH_TEST);
-        glDepthFunc(to_GLCompareFunc(depth_stencil.depth_compare_op));
-    }
-    else {
-        glDisable(GL_DEPTH_TEST);
-    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Render_encoder* Ogl_parallel_render_encoder::render_encoder()
+{
+    lock_guard<mutex> lock {mutex_};
 
-    glDepthMask(depth_stencil.write_mask);
+    encoders_.push_back(make_unique<Ogl_render_encoder>(&encoder_));
+
+    return encoders_.back().get();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Ogl_render_encoder::set_up_color_blend_(const Color_blend& color_blend)
+void Ogl_parallel_render_encoder::end()
 {
-    for (GLuint i = 0; i != 4; ++ i) {
-        auto& attachment = color_blend.attachments[i];
+    // commands of encoders are executed inside the primary's render pass in the order of their creation.
+    for (auto& encoder : encoders_)
+        move(encoder->cmds_.begin(), encoder->cmds_.end(), back_inserter(encoder_.cmds_));
 
-        if (attachment.blend) {
-            glEnablei(GL_BLEND, i);
-            glBlendFuncSeparatei(i,
-                                 to_GLBlendFactor(attachment.src_rgb_blend_factor),
-                                 to_GLBlendFactor(attachment.dst_rgb_blend_factor),
-                                 to_GLBlendFactor(attachment.src_a_blend_factor),
-                                 to_GLBlendFactor(attachment.dst_a_blend_factor));
-            glBlendEquationSeparatei(i,
-                                     to_GLBlendFunc(attachment.rgb_blend_op),
-                                     to_GLBlendFunc(attachment.a_blend_op));
-        }
-        else {
-            glDisablei(GL_BLEND, i);
-        }
+    encoder_.end();
+}
 
-        glColorMaski(i,
-                     attachment.write_mask & 0x8,
-                     attachment.write_mask & 0x4,
-                     attachment.write_mask & 0x2,
-                     attachment.write_mask & 0x1);
-    }
+//----------------------------------------------------------------------------------------------------------------------
 
-    glBlendColor(color_blend.constant[0], color_blend.constant[1], color_blend.constant[2], color_blend.constant[3]);
+Cmd_buffer* Ogl_parallel_render_encoder::cmd_buffer() const
+{
+    return cmd_buffer_;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -489,12 +663,12 @@ void Ogl_blit_encoder::copy(Buffer* src_buffer, Buffer* dst_buffer, const Buffer
     auto src_buffer_impl = static_cast<Ogl_buffer*>(src_buffer);
     auto dst_buffer_impl = static_cast<Ogl_buffer*>(dst_buffer);
 
+    // a copy is done on a gpu, a source isn't mapped and a driver doesn't wait previous commands.
     cmds_.emplace_back([=]() {
-        auto contents = static_cast<uint8_t*>(src_buffer_impl->map());
-
+        glBindBuffer(GL_COPY_READ_BUFFER, src_buffer_impl->buffer());
         glBindBuffer(GL_COPY_WRITE_BUFFER, dst_buffer_impl->buffer());
-        glBufferSubData(GL_COPY_WRITE_BUFFER, region.dst_offset, region.size, contents + region.src_offset);
-        src_buffer_impl->unmap();
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, region.src_offset, region.dst_offset,
+                            region.size);
     });
 }
 
@@ -505,9 +679,9 @@ void Ogl_blit_encoder::copy(Buffer* src_buffer, Image* dst_image, const Buffer_i
     auto src_buffer_impl = static_cast<Ogl_buffer*>(src_buffer);
     auto dst_image_impl = static_cast<Ogl_image*>(dst_image);
 
+    // pixels are unpacked from a bound buffer, a pointer is an offset in a buffer.
     cmds_.emplace_back([=]() {
-        auto contents = src_buffer_impl->map();
-
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, src_buffer_impl->buffer());
         glBindTexture(GL_TEXTURE_2D, dst_image_impl->texture());
         glTexSubImage2D(GL_TEXTURE_2D,
                         region.image_subresource.mip_level,
@@ -517,15 +691,72 @@ void Ogl_blit_encoder::copy(Buffer* src_buffer, Image* dst_image, const Buffer_i
                         region.image_extent.h,
                         to_GLFormat(dst_image_impl->format()),
                         to_GLDataType(dst_image_impl->format()),
-                        contents);
-        src_buffer_impl->unmap();
+                        reinterpret_cast<const void*>(static_cast<uintptr_t>(region.buffer_offset)));
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
     });
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Ogl_blit_encoder::copy(Image* src_buffer, Buffer* dst_image, const Buffer_image_copy_region& region)
+void Ogl_blit_encoder::copy(Image* src_image, Buffer* dst_buffer, const Buffer_image_copy_region& region)
 {
+    auto device = static_cast<Ogl_device*>(cmd_buffer_->device());
+    auto src_image_impl = static_cast<Ogl_image*>(src_image);
+    auto dst_buffer_impl = static_cast<Ogl_buffer*>(dst_buffer);
+
+    // gles reads only color attachments, a depth stencil image isn't readable with glReadPixels.
+    if (is_depth_stencil_format(src_image_impl->format()))
+        throw runtime_error("fail to copy an image to a buffer");
+
+    auto& subresource = region.image_subresource;
+
+    if (Image_type::cube != src_image_impl->type() && subresource.array_layer)
+        throw runtime_error("fail to copy an image to a buffer");
+
+    auto texture_target = Image_type::cube == src_image_impl->type() ?
+                          GL_TEXTURE_CUBE_MAP_POSITIVE_X + subresource.array_layer : GL_TEXTURE_2D;
+    auto format = to_GLFormat(src_image_impl->format());
+    auto data_type = to_GLDataType(src_image_impl->format());
+
+    // pixels are packed to a bound buffer, a caller waits a fence of a submit before it reads them.
+    cmds_.emplace_back([=]() {
+        GLint read_framebuffer;
+
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &read_framebuffer);
+
+        // a framebuffer of a device attaches a requested mip level and layer, cached ones attach only a base level.
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, device->read_framebuffer());
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER,
+                               GL_COLOR_ATTACHMENT0,
+                               texture_target,
+                               src_image_impl->texture(),
+                               subresource.mip_level);
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+
+        // only rgba and unsigned byte are guaranteed, other pairs must match ones of an implementation.
+        if (GL_RGBA != format || GL_UNSIGNED_BYTE != data_type) {
+            GLint read_format, read_data_type;
+
+            glGetIntegerv(GL_IMPLEMENTATION_COLOR_READ_FORMAT, &read_format);
+            glGetIntegerv(GL_IMPLEMENTATION_COLOR_READ_TYPE, &read_data_type);
+
+            if (static_cast<GLenum>(read_format) != format || static_cast<GLenum>(read_data_type) != data_type) {
+                glBindFramebuffer(GL_READ_FRAMEBUFFER, read_framebuffer);
+                throw runtime_error("fail to copy an image to a buffer");
+            }
+        }
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, dst_buffer_impl->buffer());
+        glReadPixels(region.image_offset.x,
+                     region.image_offset.y,
+                     region.image_extent.w,
+                     region.image_extent.h,
+                     format,
+                     data_type,
+                     reinterpret_cast<void*>(static_cast<uintptr_t>(region.buffer_offset)));
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, read_framebuffer);
+    });
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -544,6 +775,177 @@ Cmd_buffer* Ogl_blit_encoder::cmd_buffer() const
 
 //----------------------------------------------------------------------------------------------------------------------
 
+Ogl_compute_encoder::Ogl_compute_encoder(const Compute_encoder_desc& desc, Ogl_cmd_buffer* cmd_buffer) :
+    Compute_encoder {},
+    cmd_buffer_ {cmd_buffer},
+    cmds_ {},
+    arg_table_ {},
+    storage_buffers_ {},
+    storage_images_ {},
+    pipeline_ {nullptr},
+    dispatched_ {false}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_compute_encoder::end()
+{
+    // make writes of dispatches visible to following passes.
+    if (dispatched_) {
+        cmds_.emplace_back([=]() {
+            glMemoryBarrier(GL_ALL_BARRIER_BITS);
+        });
+    }
+
+    for_each(cmds_, execute);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_compute_encoder::dispatch(uint32_t x, uint32_t y, uint32_t z)
+{
+    memory_barrier_();
+
+    cmds_.emplace_back([=]() {
+        glDispatchCompute(x, y, z);
+    });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_compute_encoder::dispatch_indirect(Buffer* buffer, uint64_t offset)
+{
+    auto buffer_impl = static_cast<Ogl_buffer*>(buffer);
+
+    memory_barrier_();
+
+    cmds_.emplace_back([=]() {
+        glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, buffer_impl->buffer());
+        glDispatchComputeIndirect(static_cast<GLintptr>(offset));
+    });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_compute_encoder::shader_buffer(Buffer* buffer, uint32_t offset, uint32_t index)
+{
+    auto buffer_impl = static_cast<Ogl_buffer*>(buffer);
+    auto arg_buffer = arg_table_.arg_buffer(index);
+
+    // skip if a shader buffer and offset are same.
+    if (buffer_impl == arg_buffer.buffer && offset == arg_buffer.offset)
+        return;
+
+    cmds_.emplace_back([=] {
+        glBindBufferRange(GL_UNIFORM_BUFFER, index, buffer_impl->buffer(), offset, buffer_impl->size() - offset);
+    });
+
+    // update an arg tables.
+    arg_table_.arg_buffer({buffer_impl, offset}, index);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_compute_encoder::shader_texture(Image* image, Sampler* sampler, uint32_t index)
+{
+    auto image_impl = static_cast<Ogl_image*>(image);
+    auto sampler_impl = static_cast<Ogl_sampler*>(sampler);
+    auto arg_texture = arg_table_.arg_texture(index);
+
+    // skip if a shader image and shader sampler are same.
+    if (image_impl == arg_texture.image && sampler_impl == arg_texture.sampler)
+        return;
+
+    cmds_.emplace_back([=]() {
+        glActiveTexture(GL_TEXTURE0 + index);
+        glBindTexture(to_GLTextureTarget(image_impl->type()), image_impl->texture());
+        glBindSampler(index, sampler_impl->sampler());
+    });
+
+    // update an arg tables.
+    arg_table_.arg_texture({image_impl, sampler_impl}, index);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_compute_encoder::storage_buffer(Buffer* buffer, uint32_t offset, uint32_t index)
+{
+    auto buffer_impl = static_cast<Ogl_buffer*>(buffer);
+    auto& storage_buffer = storage_buffers_[index];
+
+    // skip if a storage buffer and offset are same.
+    if (buffer_impl == storage_buffer.buffer && offset == storage_buffer.offset)
+        return;
+
+    cmds_.emplace_back([=] {
+        glBindBufferRange(GL_SHADER_STORAGE_BUFFER, index,
+                          buffer_impl->buffer(), offset, buffer_impl->size() - offset);
+    });
+
+    storage_buffer = {buffer_impl, offset};
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_compute_encoder::storage_image(Image* image, uint32_t index)
+{
+    auto image_impl = static_cast<Ogl_image*>(image);
+
+    // skip if a storage image is same.
+    if (image_impl == storage_images_[index])
+        return;
+
+    cmds_.emplace_back([=] {
+        glBindImageTexture(index, image_impl->texture(), 0, GL_FALSE, 0, GL_READ_WRITE,
+                           to_GLInternalFormat(image_impl->format()));
+    });
+
+    storage_images_[index] = image_impl;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_compute_encoder::pipeline(Pipeline* pipeline)
+{
+    auto pipeline_impl = static_cast<Ogl_pipeline*>(pipeline);
+
+    if (pipeline_impl == pipeline_)
+        return;
+
+    pipeline_ = pipeline_impl;
+
+    auto state_cache = static_cast<Ogl_device*>(cmd_buffer_->device())->state_cache();
+
+    cmds_.emplace_back([=]() {
+        state_cache->program(pipeline_impl->program());
+    });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cmd_buffer* Ogl_compute_encoder::cmd_buffer() const
+{
+    return cmd_buffer_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_compute_encoder::memory_barrier_()
+{
+    // dispatches are serialized, a dispatch can read writes of a previous dispatch.
+    if (dispatched_) {
+        cmds_.emplace_back([=]() {
+            glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT |
+                            GL_COMMAND_BARRIER_BIT);
+        });
+    }
+
+    dispatched_ = true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 Ogl_cmd_buffer::Ogl_cmd_buffer(Ogl_device* device) :
     Cmd_buffer {},
     device_ {device}
@@ -565,6 +967,13 @@ std::unique_ptr<Render_encoder> Ogl_cmd_buffer::create(const Render_encoder_desc
 
 //----------------------------------------------------------------------------------------------------------------------
 
+std::unique_ptr<Parallel_render_encoder> Ogl_cmd_buffer::create(const Parallel_render_encoder_desc& desc)
+{
+    return make_unique<Ogl_parallel_render_encoder>(desc, device_, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 std::unique_ptr<Blit_encoder> Ogl_cmd_buffer::create(const Blit_encoder_desc& desc)
 {
     return make_unique<Ogl_blit_encoder>(desc, this);
@@ -572,6 +981,13 @@ std::unique_ptr<Blit_encoder> Ogl_cmd_buffer::create(const Blit_encoder_desc& de
 
 //----------------------------------------------------------------------------------------------------------------------
 
+std::unique_ptr<Compute_encoder> Ogl_cmd_buffer::create(const Compute_encoder_desc& desc)
+{
+    return make_unique<Ogl_compute_encoder>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 void Ogl_cmd_buffer::end()
 {
 }
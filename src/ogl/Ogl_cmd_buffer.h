@@ -8,9 +8,14 @@
 
 #include <deque>
 #include <functional>
-#include <GLES3/gl3.h>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+#include <GLES3/gl31.h>
 #include "Cmd_buffer.h"
 #include "Ogl_pipeline.h"
+#include "Ogl_vertex_array.h"
 
 namespace Gfx_lib {
 
@@ -100,11 +105,20 @@ class Ogl_render_encoder final : public Render_encoder {
 public:
     Ogl_render_encoder(const Render_encoder_desc& desc, Ogl_device* device, Ogl_cmd_buffer* cmd_buffer);
 
+    explicit Ogl_render_encoder(Ogl_render_encoder* primary_encoder);
+
     void end() override;
 
-    void draw(uint32_t count, uint32_t first = 0) override;
+    void draw(uint32_t count, uint32_t first = 0, uint32_t instance_count = 1, uint32_t first_instance = 0) override;
+
+    void draw_indexed(uint32_t count, uint32_t first = 0, uint32_t instance_count = 1,
+                      uint32_t first_instance = 0, int32_t base_vertex = 0) override;
 
-    void draw_indexed(uint32_t count, uint32_t first = 0) override;
+    void draw_indirect(Buffer* buffer, uint64_t offset, uint32_t draw_count = 1,
+                       uint32_t stride = sizeof(Draw_indirect_args)) override;
+
+    void draw_indexed_indirect(Buffer* buffer, uint64_t offset, uint32_t draw_count = 1,
+                               uint32_t stride = sizeof(Draw_indexed_indirect_args)) override;
 
     void vertex_buffer(Buffer* buffer, uint64_t offset, uint32_t index) override;
 
@@ -114,6 +128,11 @@ public:
 
     void shader_texture(Image* image, Sampler* sampler, uint32_t index) override;
 
+    void shader_bytes(Pipeline_stage stage, uint32_t offset, const void* data, uint32_t size) override;
+
+    void bind_group(uint32_t index, Bind_group* bind_group,
+                    const std::vector<uint32_t>& dynamic_offsets = {}) override;
+
     void pipeline(Pipeline* pipeline) override;
 
     void viewport(const Viewport& viewport) override;
@@ -129,29 +148,50 @@ private:
 
     void end_render_pass_();
 
-    void set_up_vertex_input_(const std::array<Ogl_vertex_stream, 2>& vertex_streams,
-                              const Vertex_input& vertex_input);
-
-    void set_up_rasterization_(const Rasterization& rasterization);
-
-    void set_up_depth_stencil_(const Depth_stencil& depth_stencil);
-
-    void set_up_color_blend_(const Color_blend& color_blend);
+    void bind_vertex_array_();
 
+    void bind_push_constants_();
 
 private:
     Ogl_device* device_;
     Ogl_cmd_buffer* cmd_buffer_;
+    Ogl_render_encoder* primary_encoder_;
     Ogl_framebuffer* framebuffer_;
     std::deque<std::function<void ()>> cmds_;
     std::array<Ogl_vertex_stream, 2> vertex_streams_;
     Ogl_index_stream index_stream_;
     Index_type index_type_;
     Ogl_arg_table arg_table_;
+    std::array<uint8_t, max_push_constant_size> push_constants_;
+    bool push_constants_dirty_;
+    std::optional<Ogl_vertex_array_desc> vertex_array_desc_;
+    bool vertex_array_dirty_;
     Ogl_pipeline* pipeline_;
     Viewport viewport_;
     Scissor scissor_;
     std::vector<GLenum> discards_;
+
+    friend class Ogl_parallel_render_encoder;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Ogl_parallel_render_encoder final : public Parallel_render_encoder {
+public:
+    Ogl_parallel_render_encoder(const Parallel_render_encoder_desc& desc,
+                                Ogl_device* device, Ogl_cmd_buffer* cmd_buffer);
+
+    Render_encoder* render_encoder() override;
+
+    void end() override;
+
+    Cmd_buffer* cmd_buffer() const override;
+
+private:
+    Ogl_cmd_buffer* cmd_buffer_;
+    Ogl_render_encoder encoder_;
+    std::vector<std::unique_ptr<Ogl_render_encoder>> encoders_;
+    std::mutex mutex_;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -164,7 +204,7 @@ public:
 
     void copy(Buffer* src_buffer, Image* dst_image, const Buffer_image_copy_region& region) override;
 
-    void copy(Image* src_buffer, Buffer* dst_image, const Buffer_image_copy_region& region) override;
+    void copy(Image* src_image, Buffer* dst_buffer, const Buffer_image_copy_region& region) override;
 
     void end() override;
 
@@ -177,6 +217,43 @@ private:
 
 //----------------------------------------------------------------------------------------------------------------------
 
+class Ogl_compute_encoder final : public Compute_encoder {
+public:
+    Ogl_compute_encoder(const Compute_encoder_desc& desc, Ogl_cmd_buffer* cmd_buffer);
+
+    void end() override;
+
+    void dispatch(uint32_t x, uint32_t y = 1, uint32_t z = 1) override;
+
+    void dispatch_indirect(Buffer* buffer, uint64_t offset = 0) override;
+
+    void shader_buffer(Buffer* buffer, uint32_t offset, uint32_t index) override;
+
+    void shader_texture(Image* image, Sampler* sampler, uint32_t index) override;
+
+    void storage_buffer(Buffer* buffer, uint32_t offset, uint32_t index) override;
+
+    void storage_image(Image* image, uint32_t index) override;
+
+    void pipeline(Pipeline* pipeline) override;
+
+    Cmd_buffer* cmd_buffer() const override;
+
+private:
+    void memory_barrier_();
+
+private:
+    Ogl_cmd_buffer* cmd_buffer_;
+    std::deque<std::function<void ()>> cmds_;
+    Ogl_arg_table arg_table_;
+    Ogl_arg_array<Ogl_arg_buffer> storage_buffers_;
+    Ogl_arg_array<Ogl_image*> storage_images_;
+    Ogl_pipeline* pipeline_;
+    bool dispatched_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
 class Ogl_cmd_buffer final : public Cmd_buffer {
 public:
     Ogl_cmd_buffer(Ogl_device* device);
@@ -185,8 +262,12 @@ public:
 
     std::unique_ptr<Render_encoder> create(const Render_encoder_desc& desc) override;
 
+    std::unique_ptr<Parallel_render_encoder> create(const Parallel_render_encoder_desc& desc) override;
+
     std::unique_ptr<Blit_encoder> create(const Blit_encoder_desc& desc) override;
 
+    std::unique_ptr<Compute_encoder> create(const Compute_encoder_desc& desc) override;
+
     void end() override;
 
     void reset() override;
@@ -3,6 +3,9 @@
 // See "LICENSE" for license information.
 //
 
+#include <cstring>
+#include <chrono>
+#include <thread>
 #include <metrohash.h>
 #include "ogl_lib.h"
 #include "Ogl_device.h"
@@ -11,43 +14,104 @@
 #include "Ogl_sampler.h"
 #include "Ogl_shader.h"
 #include "Ogl_pipeline.h"
+#include "Ogl_bind_group.h"
 #include "Ogl_swap_chain.h"
 #include "Ogl_cmd_buffer.h"
 #include "Ogl_fence.h"
+#include "Ogl_semaphore.h"
+#include "Ogl_timeline.h"
 
 using namespace std;
+using namespace std::chrono;
 
 #define DEFINE_OGL_SYMBOL(name) PFN_##name name;
 #define LOAD_OGL_CONTEXT_SYMBOL(name) name = reinterpret_cast<PFN_##name>(eglGetProcAddress(#name));
+#define LOAD_OGL_CONTEXT_EXT_SYMBOL(name) name = reinterpret_cast<PFN_##name>(eglGetProcAddress(#name "EXT"));
+#define LOAD_OGL_CONTEXT_OES_SYMBOL(name) name = reinterpret_cast<PFN_##name>(eglGetProcAddress(#name "OES"));
 
 namespace Gfx_lib {
 
 //----------------------------------------------------------------------------------------------------------------------
 
 APPLY_OGL_DRAW_BUFFERS_INDEXED_SYMBOLS(DEFINE_OGL_SYMBOL);
+APPLY_OGL_DRAW_ELEMENTS_BASE_VERTEX_SYMBOLS(DEFINE_OGL_SYMBOL);
+APPLY_OGL_BASE_INSTANCE_SYMBOLS(DEFINE_OGL_SYMBOL);
+APPLY_OGL_BUFFER_STORAGE_SYMBOLS(DEFINE_OGL_SYMBOL);
 
 //----------------------------------------------------------------------------------------------------------------------
 
-Ogl_device::Ogl_device()
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+bool has_version(GLint major, GLint minor)
+{
+    GLint context_major {0};
+    GLint context_minor {0};
+
+    glGetIntegerv(GL_MAJOR_VERSION, &context_major);
+    glGetIntegerv(GL_MINOR_VERSION, &context_minor);
+
+    return context_major > major || (context_major == major && context_minor >= minor);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+bool has_extension(const char* name)
+{
+    GLint count {0};
+
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+
+    for (auto i = 0; i != count; ++i) {
+        if (!strcmp(name, reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i))))
+            return true;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Ogl_device::Ogl_device(const Device_desc& desc)
     : Device {}
     , display_ {EGL_NO_DISPLAY}
     , context_ {EGL_NO_CONTEXT}
+    , read_framebuffer_ {0}
 {
     init_display_();
     init_context_();
     init_context_symbols_();
+    init_adapter_(desc);
     init_caps_();
+    init_uniform_ring_();
+    init_read_framebuffer_();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
 Ogl_device::~Ogl_device()
 {
+    fini_read_framebuffer_();
+    fini_uniform_ring_();
+    fini_vertex_array_pool_();
     fini_context_();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
+std::vector<Adapter> Ogl_device::enumerate()
+{
+    // egl exposes only the default display.
+    return {{0, "EGL default display", Adapter_type::other, 0, 1}};
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 std::unique_ptr<Buffer> Ogl_device::create(const Buffer_desc& desc)
 {
     return make_unique<Ogl_buffer>(desc, this);
@@ -83,6 +147,20 @@ std::unique_ptr<Pipeline> Ogl_device::create(const Pipeline_desc& desc)
 
 //----------------------------------------------------------------------------------------------------------------------
 
+std::unique_ptr<Pipeline> Ogl_device::create(const Compute_pipeline_desc& desc)
+{
+    return make_unique<Ogl_pipeline>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Bind_group> Ogl_device::create(const Bind_group_desc& desc)
+{
+    return make_unique<Ogl_bind_group>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 std::unique_ptr<Swap_chain> Ogl_device::create(const Swap_chain_desc& desc)
 {
     return make_unique<Ogl_swap_chain>(desc, this);
@@ -104,13 +182,88 @@ std::unique_ptr<Fence> Ogl_device::create(const Fence_desc& desc)
 
 //----------------------------------------------------------------------------------------------------------------------
 
+std::unique_ptr<Semaphore> Ogl_device::create(const Semaphore_desc& desc)
+{
+    return make_unique<Ogl_semaphore>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Timeline> Ogl_device::create(const Timeline_desc& desc)
+{
+    return make_unique<Ogl_timeline>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 void Ogl_device::submit(Cmd_buffer* cmd_buffer, Fence* fence)
 {
+    if (fence)
+        static_cast<Ogl_fence*>(fence)->insert();
+
+    glFlush();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_device::submit(const std::vector<Submit_desc>& descs, Fence* fence)
+{
+    // commands are already issued to a context in order, only syncs are inserted between descs.
+    for (auto& desc : descs) {
+        if (desc.timeline)
+            static_cast<Ogl_timeline*>(desc.timeline)->insert(desc.timeline_value);
+    }
+
+    if (fence)
+        static_cast<Ogl_fence*>(fence)->insert();
+
     glFlush();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
+bool Ogl_device::wait(const std::vector<Fence*>& fences, bool wait_all, uint64_t timeout)
+{
+    if (fences.empty())
+        return true;
+
+    if (wait_all)
+        return Device::wait(fences, true, timeout);
+
+    constexpr uint64_t slice {1000000};
+    auto start = steady_clock::now();
+
+    // gl can't wait several syncs at once, so syncs are waited in turn for a short slice instead of polling.
+    while (true) {
+        auto elapsed = uint64_t(duration_cast<nanoseconds>(steady_clock::now() - start).count());
+        auto time = (UINT64_MAX == timeout) ? slice : min(slice, timeout > elapsed ? timeout - elapsed : 0);
+        auto waited = false;
+
+        for (auto fence : fences) {
+            auto fence_impl = static_cast<Ogl_fence*>(fence);
+
+            if (fence_impl->signaled())
+                return true;
+
+            if (fence_impl->sync() && time) {
+                if (fence_impl->wait_signal(time / fences.size()))
+                    return true;
+
+                waited = true;
+            }
+        }
+
+        if (!time)
+            return false;
+
+        // fences without syncs aren't submitted yet, so a waiter sleeps until a submit of another thread.
+        if (!waited)
+            this_thread::sleep_for(nanoseconds(time));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 void Ogl_device::wait_idle()
 {
     glFinish();
@@ -135,6 +288,33 @@ Ogl_framebuffer* Ogl_device::framebuffer(const Ogl_framebuffer_desc& desc)
 
 //----------------------------------------------------------------------------------------------------------------------
 
+Ogl_vertex_array* Ogl_device::vertex_array(const Ogl_vertex_array_desc& desc)
+{
+    // calculate a hash value.
+    uint64_t key { 0 };
+
+    MetroHash64::Hash(reinterpret_cast<const uint8_t*>(&desc), sizeof(Ogl_vertex_array_desc),
+                      reinterpret_cast<uint8_t*>(&key));
+
+    // check a vertex array exists and if not then create it.
+    if (!vertex_array_pool_.contains(key))
+        vertex_array_pool_.emplace(key, desc);
+
+    return *vertex_array_pool_.find(key);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_device::release_vertex_arrays(GLuint buffer)
+{
+    // a name of a deleted buffer can be reused, so vertex arrays which reference it are deleted together.
+    vertex_array_pool_.erase_if([=](const Ogl_vertex_array& vertex_array) {
+        return vertex_array.references(buffer);
+    });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 void Ogl_device::init_display_()
 {
     display_ = eglGetDisplay(EGL_DEFAULT_DISPLAY);
@@ -169,6 +349,38 @@ void Ogl_device::init_context_()
 void Ogl_device::init_context_symbols_()
 {
     APPLY_OGL_DRAW_BUFFERS_INDEXED_SYMBOLS(LOAD_OGL_CONTEXT_SYMBOL);
+
+    // egl can return an address of an unsupported function, so a symbol is only loaded when it is supported.
+    if (has_version(3, 2)) {
+        APPLY_OGL_DRAW_ELEMENTS_BASE_VERTEX_SYMBOLS(LOAD_OGL_CONTEXT_SYMBOL);
+    }
+    else if (has_extension("GL_OES_draw_elements_base_vertex")) {
+        APPLY_OGL_DRAW_ELEMENTS_BASE_VERTEX_SYMBOLS(LOAD_OGL_CONTEXT_OES_SYMBOL);
+    }
+    else if (has_extension("GL_EXT_draw_elements_base_vertex")) {
+        APPLY_OGL_DRAW_ELEMENTS_BASE_VERTEX_SYMBOLS(LOAD_OGL_CONTEXT_EXT_SYMBOL);
+    }
+
+    // a base instance is only available by EXT_base_instance on OpenGL ES.
+    if (has_extension("GL_EXT_base_instance")) {
+        APPLY_OGL_BASE_INSTANCE_SYMBOLS(LOAD_OGL_CONTEXT_EXT_SYMBOL);
+    }
+
+    // a persistent mapping is only available by EXT_buffer_storage on OpenGL ES.
+    if (has_extension("GL_EXT_buffer_storage")) {
+        APPLY_OGL_BUFFER_STORAGE_SYMBOLS(LOAD_OGL_CONTEXT_EXT_SYMBOL);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_device::init_adapter_(const Device_desc& desc)
+{
+    backend_ = Backend::opengl;
+    adapter_ = select(enumerate(), desc);
+
+    if (auto renderer = glGetString(GL_RENDERER); renderer)
+        adapter_.name = reinterpret_cast<const char*>(renderer);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -181,6 +393,44 @@ void Ogl_device::init_caps_()
 
 //----------------------------------------------------------------------------------------------------------------------
 
+void Ogl_device::init_uniform_ring_()
+{
+    uniform_ring_ = make_unique<Ogl_uniform_ring>();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_device::init_read_framebuffer_()
+{
+    // a framebuffer is shared by readbacks, they attach a requested subresource on each copy.
+    glGenFramebuffers(1, &read_framebuffer_);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_device::fini_read_framebuffer_()
+{
+    glDeleteFramebuffers(1, &read_framebuffer_);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_device::fini_uniform_ring_()
+{
+    // a buffer of a ring is deleted while a context is alive.
+    uniform_ring_.reset();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_device::fini_vertex_array_pool_()
+{
+    // vertex arrays are deleted while a context is alive.
+    vertex_array_pool_.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 void Ogl_device::fini_context_()
 {
     eglDestroyContext(display_, context_);
@@ -6,10 +6,14 @@
 #ifndef GFX_OGL_DEVICE_GUARD
 #define GFX_OGL_DEVICE_GUARD
 
+#include <memory>
 #include <EGL/egl.h>
 #include "Device.h"
 #include "Lru_cache.h"
 #include "Ogl_framebuffer.h"
+#include "Ogl_vertex_array.h"
+#include "Ogl_uniform_ring.h"
+#include "Ogl_state_cache.h"
 
 namespace Gfx_lib {
 
@@ -17,10 +21,12 @@ namespace Gfx_lib {
 
 class Ogl_device : public Device {
 public:
-    Ogl_device();
+    explicit Ogl_device(const Device_desc& desc = {});
 
     ~Ogl_device() override;
 
+    static std::vector<Adapter> enumerate();
+
     std::unique_ptr<Buffer> create(const Buffer_desc& desc) override;
 
     std::unique_ptr<Image> create(const Image_desc& desc) override;
@@ -31,14 +37,26 @@ public:
 
     std::unique_ptr<Pipeline> create(const Pipeline_desc& desc) override;
 
+    std::unique_ptr<Pipeline> create(const Compute_pipeline_desc& desc) override;
+
+    std::unique_ptr<Bind_group> create(const Bind_group_desc& desc) override;
+
     std::unique_ptr<Swap_chain> create(const Swap_chain_desc& desc) override;
 
     std::unique_ptr<Cmd_buffer> create(const Cmd_buffer_desc& desc) override;
 
     std::unique_ptr<Fence> create(const Fence_desc& desc) override;
 
+    std::unique_ptr<Semaphore> create(const Semaphore_desc& desc) override;
+
+    std::unique_ptr<Timeline> create(const Timeline_desc& desc) override;
+
     void submit(Cmd_buffer* cmd_buffer, Fence* fence = nullptr) override;
 
+    void submit(const std::vector<Submit_desc>& descs, Fence* fence = nullptr) override;
+
+    bool wait(const std::vector<Fence*>& fences, bool wait_all, uint64_t timeout = UINT64_MAX) override;
+
     void wait_idle() override;
 
     inline auto display() const noexcept
@@ -47,8 +65,21 @@ public:
     inline auto context() const noexcept
     { return context_; }
 
+    inline auto uniform_ring() const noexcept
+    { return uniform_ring_.get(); }
+
+    inline auto state_cache() noexcept
+    { return &state_cache_; }
+
+    inline auto read_framebuffer() const noexcept
+    { return read_framebuffer_; }
+
     Ogl_framebuffer* framebuffer(const Ogl_framebuffer_desc& desc);
 
+    Ogl_vertex_array* vertex_array(const Ogl_vertex_array_desc& desc);
+
+    void release_vertex_arrays(GLuint buffer);
+
 private:
     void init_display_();
 
@@ -56,14 +87,30 @@ private:
 
     void init_context_symbols_();
 
+    void init_adapter_(const Device_desc& desc);
+
     void init_caps_();
 
+    void init_uniform_ring_();
+
+    void init_read_framebuffer_();
+
+    void fini_read_framebuffer_();
+
+    void fini_uniform_ring_();
+
+    void fini_vertex_array_pool_();
+
     void fini_context_();
 
 private:
     EGLDisplay display_;
     EGLContext context_;
     Lru_cache<Ogl_framebuffer> framebuffer_pool_;
+    Lru_cache<Ogl_vertex_array> vertex_array_pool_;
+    std::unique_ptr<Ogl_uniform_ring> uniform_ring_;
+    GLuint read_framebuffer_;
+    Ogl_state_cache state_cache_;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -12,20 +12,38 @@ namespace Gfx_lib {
 
 Ogl_fence::Ogl_fence(const Fence_desc& desc, Ogl_device* device) :
     Fence {},
-    device_ {device}
+    device_ {device},
+    sync_ {nullptr},
+    signaled_ {desc.signaled}
 {
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Ogl_fence::wait_signal()
+Ogl_fence::~Ogl_fence()
 {
+    fini_sync_();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+bool Ogl_fence::wait_signal(uint64_t timeout)
+{
+    if (!signaled_ && sync_) {
+        auto result = glClientWaitSync(sync_, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+
+        signaled_ = (GL_ALREADY_SIGNALED == result) || (GL_CONDITION_SATISFIED == result);
+    }
+
+    return signaled_;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
 void Ogl_fence::reset()
 {
+    fini_sync_();
+    signaled_ = false;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -39,9 +57,37 @@ Device* Ogl_fence::device() const
 
 bool Ogl_fence::signaled() const
 {
-    return true;
+    if (!signaled_ && sync_) {
+        GLint status {GL_UNSIGNALED};
+
+        glGetSynciv(sync_, GL_SYNC_STATUS, 1, nullptr, &status);
+        signaled_ = GL_SIGNALED == status;
+    }
+
+    return signaled_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_fence::insert()
+{
+    fini_sync_();
+
+    // a fence is signaled when all previous commands are completed.
+    sync_ = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    signaled_ = false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_fence::fini_sync_()
+{
+    if (sync_) {
+        glDeleteSync(sync_);
+        sync_ = nullptr;
+    }
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-} // of namespace Gfx_lib
\ No newline at end of file
+} // of namespace Gfx_lib
@@ -6,7 +6,7 @@
 #ifndef GFX_OGL_FENCE_GUARD
 #define GFX_OGL_FENCE_GUARD
 
-#include <GLES3/gl3.h>
+#include <GLES3/gl31.h>
 #include "Fence.h"
 
 namespace Gfx_lib {
@@ -21,7 +21,9 @@ class Ogl_fence final : public Fence {
 public:
     Ogl_fence(const Fence_desc& desc, Ogl_device* device);
 
-    void wait_signal() override;
+    ~Ogl_fence() override;
+
+    bool wait_signal(uint64_t timeout = UINT64_MAX) override;
 
     void reset() override;
 
@@ -29,8 +31,18 @@ public:
 
     bool signaled() const override;
 
+    void insert();
+
+    inline auto sync() const noexcept
+    { return sync_; }
+
+private:
+    void fini_sync_();
+
 private:
     Ogl_device* device_;
+    GLsync sync_;
+    mutable bool signaled_;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -7,7 +7,7 @@
 #define GFX_OGL_FRAMEBUFFER_GUARD
 
 #include <array>
-#include <GLES3/gl3.h>
+#include <GLES3/gl31.h>
 #include "types.h"
 
 namespace Gfx_lib {
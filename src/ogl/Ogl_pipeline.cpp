@@ -24,6 +24,16 @@ Ogl_pipeline::Ogl_pipeline(const Pipeline_desc& desc, Ogl_device* device) :
 
 //----------------------------------------------------------------------------------------------------------------------
 
+Ogl_pipeline::Ogl_pipeline(const Compute_pipeline_desc& desc, Ogl_device* device) :
+    Pipeline {desc},
+    device_ {device},
+    program_ {0}
+{
+    init_program_(desc.compute_shader);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 Ogl_pipeline::~Ogl_pipeline()
 {
     fini_program_();
@@ -52,6 +62,19 @@ void Ogl_pipeline::init_program_(Shader* vertex_shader, Shader* fragment_shader)
 
 //----------------------------------------------------------------------------------------------------------------------
 
+void Ogl_pipeline::init_program_(Shader* compute_shader)
+{
+    program_ = glCreateProgram();
+
+    if (!program_)
+        throw runtime_error("fail to create a pipeline");
+
+    glAttachShader(program_, static_cast<Ogl_shader*>(compute_shader)->shader());
+    glLinkProgram(program_);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 void Ogl_pipeline::fini_program_()
 {
     glDeleteProgram(program_);
@@ -6,7 +6,7 @@
 #ifndef GFX_OGL_PIPELINE_GUARD
 #define GFX_OGL_PIPELINE_GUARD
 
-#include <GLES3/gl3.h>
+#include <GLES3/gl31.h>
 #include "Pipeline.h"
 
 namespace Gfx_lib {
@@ -21,6 +21,8 @@ class Ogl_pipeline final : public Pipeline {
 public:
     Ogl_pipeline(const Pipeline_desc& desc, Ogl_device* device);
 
+    Ogl_pipeline(const Compute_pipeline_desc& desc, Ogl_device* device);
+
     ~Ogl_pipeline() override;
 
     Device* device() const override;
@@ -31,6 +33,8 @@ public:
 private:
     void init_program_(Shader* vertex_shader, Shader* fragment_shader);
 
+    void init_program_(Shader* compute_shader);
+
     void fini_program_();
 
 private:
@@ -6,7 +6,7 @@
 #ifndef GFX_OGL_SAMPLER_GUARD
 #define GFX_OGL_SAMPLER_GUARD
 
-#include <GLES3/gl3.h>
+#include <GLES3/gl31.h>
 #include "Sampler.h"
 
 namespace Gfx_lib {
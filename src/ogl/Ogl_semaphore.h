@@ -0,0 +1,33 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_OGL_SEMAPHORE_GUARD
+#define GFX_OGL_SEMAPHORE_GUARD
+
+#include "Semaphore.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Ogl_device;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Ogl_semaphore final : public Semaphore {
+public:
+    Ogl_semaphore(const Semaphore_desc& desc, Ogl_device* device);
+
+    Device* device() const override;
+
+private:
+    Ogl_device* device_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_OGL_SEMAPHORE_GUARD
@@ -6,6 +6,7 @@
 #include <array>
 #include <sc/Spirv_reflector.h>
 #include <sc/Glsl_compiler.h>
+#include "spirv_lib.h"
 #include "ogl_lib.h"
 #include "Ogl_shader.h"
 #include "Ogl_device.h"
@@ -24,7 +25,8 @@ Ogl_shader::Ogl_shader(const Shader_desc& desc, Ogl_device* device) :
     shader_ {0}
 {
     init_signature_(desc.src);
-    init_shader_(Glsl_compiler().compile(desc.src));
+    // a push constant block is emitted as a plain uniform, so it is remapped to a uniform block of the binding.
+    init_shader_(Glsl_compiler().compile(remap_push_constants(desc.src, push_constant_binding)));
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -6,7 +6,7 @@
 #ifndef GFX_OGL_SHADER_GUARD
 #define GFX_OGL_SHADER_GUARD
 
-#include <GLES3/gl3.h>
+#include <GLES3/gl31.h>
 #include "Shader.h"
 
 namespace Gfx_lib {
@@ -0,0 +1,168 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "std_lib.h"
+#include "ogl_lib.h"
+#include "Ogl_state_cache.h"
+
+using namespace std;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Ogl_state_cache::Ogl_state_cache() noexcept :
+    program_ {0},
+    cull_face_ {false},
+    cull_mode_ {GL_BACK},
+    depth_test_ {false},
+    depth_func_ {GL_LESS},
+    depth_mask_ {true},
+    blend_states_ {},
+    blend_color_ {0.0f, 0.0f, 0.0f, 0.0f}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_state_cache::program(GLuint program)
+{
+    if (program_ == program)
+        return;
+
+    glUseProgram(program);
+    program_ = program;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_state_cache::rasterization(const Rasterization& rasterization)
+{
+    enable_(GL_CULL_FACE, Cull_mode::none != rasterization.cull_mode, cull_face_);
+
+    if (!cull_face_)
+        return;
+
+    auto cull_mode = to_GLCullMode(rasterization.cull_mode);
+
+    if (cull_mode_ != cull_mode) {
+        glCullFace(cull_mode);
+        cull_mode_ = cull_mode;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_state_cache::depth_stencil(const Depth_stencil& depth_stencil)
+{
+    enable_(GL_DEPTH_TEST, depth_stencil.depth_test, depth_test_);
+
+    if (depth_test_) {
+        auto depth_func = to_GLCompareFunc(depth_stencil.depth_compare_op);
+
+        if (depth_func_ != depth_func) {
+            glDepthFunc(depth_func);
+            depth_func_ = depth_func;
+        }
+    }
+
+    depth_mask(depth_stencil.write_mask);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_state_cache::color_blend(const Color_blend& color_blend)
+{
+    for (GLuint i = 0; i != max_color_attachments; ++i) {
+        auto& attachment = color_blend.attachments[i];
+        auto& blend_state = blend_states_[i];
+
+        if (blend_state.blend != attachment.blend) {
+            if (attachment.blend)
+                glEnablei(GL_BLEND, i);
+            else
+                glDisablei(GL_BLEND, i);
+
+            blend_state.blend = attachment.blend;
+        }
+
+        // factors and equations don't matter while blending is disabled, they are set when it is enabled.
+        if (attachment.blend) {
+            array<GLenum, 4> factors {
+                to_GLBlendFactor(attachment.src_rgb_blend_factor),
+                to_GLBlendFactor(attachment.dst_rgb_blend_factor),
+                to_GLBlendFactor(attachment.src_a_blend_factor),
+                to_GLBlendFactor(attachment.dst_a_blend_factor)
+            };
+
+            if (blend_state.factors != factors) {
+                glBlendFuncSeparatei(i, factors[0], factors[1], factors[2], factors[3]);
+                blend_state.factors = factors;
+            }
+
+            array<GLenum, 2> equations {
+                to_GLBlendFunc(attachment.rgb_blend_op),
+                to_GLBlendFunc(attachment.a_blend_op)
+            };
+
+            if (blend_state.equations != equations) {
+                glBlendEquationSeparatei(i, equations[0], equations[1]);
+                blend_state.equations = equations;
+            }
+        }
+
+        color_mask(i, attachment.write_mask);
+    }
+
+    if (blend_color_ != color_blend.constant) {
+        auto& constant = color_blend.constant;
+
+        glBlendColor(constant[0], constant[1], constant[2], constant[3]);
+        blend_color_ = color_blend.constant;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_state_cache::depth_mask(bool write_mask)
+{
+    if (depth_mask_ == write_mask)
+        return;
+
+    glDepthMask(write_mask);
+    depth_mask_ = write_mask;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_state_cache::color_mask(GLuint index, uint32_t write_mask)
+{
+    auto& blend_state = blend_states_[index];
+
+    if (blend_state.write_mask == write_mask)
+        return;
+
+    glColorMaski(index, write_mask & 0x8, write_mask & 0x4, write_mask & 0x2, write_mask & 0x1);
+    blend_state.write_mask = write_mask;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_state_cache::enable_(GLenum cap, bool enable, bool& state)
+{
+    if (state == enable)
+        return;
+
+    if (enable)
+        glEnable(cap);
+    else
+        glDisable(cap);
+
+    state = enable;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
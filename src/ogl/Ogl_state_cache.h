@@ -0,0 +1,59 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_OGL_STATE_CACHE_GUARD
+#define GFX_OGL_STATE_CACHE_GUARD
+
+#include <array>
+#include <GLES3/gl31.h>
+#include "limitations.h"
+#include "Pipeline.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Ogl_state_cache final {
+public:
+    Ogl_state_cache() noexcept;
+
+    void program(GLuint program);
+
+    void rasterization(const Rasterization& rasterization);
+
+    void depth_stencil(const Depth_stencil& depth_stencil);
+
+    void color_blend(const Color_blend& color_blend);
+
+    void depth_mask(bool write_mask);
+
+    void color_mask(GLuint index, uint32_t write_mask);
+
+private:
+    struct Blend_state final {
+        bool blend {false};
+        std::array<GLenum, 4> factors {GL_ONE, GL_ZERO, GL_ONE, GL_ZERO};
+        std::array<GLenum, 2> equations {GL_FUNC_ADD, GL_FUNC_ADD};
+        uint32_t write_mask {0xF};
+    };
+
+    void enable_(GLenum cap, bool enable, bool& state);
+
+private:
+    GLuint program_;
+    bool cull_face_;
+    GLenum cull_mode_;
+    bool depth_test_;
+    GLenum depth_func_;
+    bool depth_mask_;
+    std::array<Blend_state, max_color_attachments> blend_states_;
+    std::array<float, max_color_attachments> blend_color_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_OGL_STATE_CACHE_GUARD
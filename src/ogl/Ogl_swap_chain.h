@@ -9,7 +9,7 @@
 #include <memory>
 #include <vector>
 #include <EGL/egl.h>
-#include <GLES3/gl3.h>
+#include <GLES3/gl31.h>
 #include "Swap_chain.h"
 
 namespace Gfx_lib {
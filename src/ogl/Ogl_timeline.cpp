@@ -0,0 +1,156 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include <chrono>
+#include "std_lib.h"
+#include "Ogl_timeline.h"
+#include "Ogl_device.h"
+
+using namespace std;
+using namespace std::chrono;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Ogl_timeline::Ogl_timeline(const Timeline_desc& desc, Ogl_device* device) :
+    Timeline {},
+    device_ {device},
+    mutex_ {},
+    signal_ {},
+    syncs_ {},
+    value_ {desc.value}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Ogl_timeline::~Ogl_timeline()
+{
+    for (auto& [value, sync] : syncs_)
+        glDeleteSync(sync);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+bool Ogl_timeline::wait(uint64_t value, uint64_t timeout)
+{
+    auto start = steady_clock::now();
+    auto remaining = [=]() -> uint64_t {
+        if (UINT64_MAX == timeout)
+            return UINT64_MAX;
+
+        auto elapsed = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+
+        return timeout > uint64_t(elapsed) ? timeout - elapsed : 0;
+    };
+
+    unique_lock<mutex> lock {mutex_};
+
+    while (value_ < value) {
+        // commands are completed in order, so it is enough to wait the first sync reaching a value.
+        auto iter = find_if(syncs_, [value](auto& sync) {
+            return sync.first >= value;
+        });
+
+        // a value isn't submitted yet, so a waiter sleeps until a submit or a signal of a host.
+        if (syncs_.end() == iter) {
+            auto time = remaining();
+
+            if (!time)
+                return false;
+
+            if (UINT64_MAX == time)
+                signal_.wait(lock);
+            else
+                signal_.wait_for(lock, nanoseconds(min(time, uint64_t(INT64_MAX))));
+
+            continue;
+        }
+
+        auto [sync_value, sync] = *iter;
+
+        lock.unlock();
+        auto result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, remaining());
+        lock.lock();
+
+        if ((GL_ALREADY_SIGNALED != result) && (GL_CONDITION_SATISFIED != result))
+            return value_ >= value;
+
+        retire_(sync_value);
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_timeline::signal(uint64_t value)
+{
+    {
+        lock_guard<mutex> lock {mutex_};
+
+        value_ = max(value_, value);
+    }
+
+    signal_.notify_all();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Device* Ogl_timeline::device() const
+{
+    return device_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+uint64_t Ogl_timeline::value() const
+{
+    lock_guard<mutex> lock {mutex_};
+
+    // poll syncs without blocking.
+    while (!syncs_.empty()) {
+        GLint status {GL_UNSIGNALED};
+
+        glGetSynciv(syncs_.front().second, GL_SYNC_STATUS, 1, nullptr, &status);
+
+        if (GL_SIGNALED != status)
+            break;
+
+        retire_(syncs_.front().first);
+    }
+
+    return value_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_timeline::insert(uint64_t value)
+{
+    {
+        lock_guard<mutex> lock {mutex_};
+
+        syncs_.emplace_back(value, glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    }
+
+    signal_.notify_all();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_timeline::retire_(uint64_t value) const
+{
+    while (!syncs_.empty() && syncs_.front().first <= value) {
+        glDeleteSync(syncs_.front().second);
+        syncs_.pop_front();
+    }
+
+    value_ = max(value_, value);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
@@ -0,0 +1,55 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_OGL_TIMELINE_GUARD
+#define GFX_OGL_TIMELINE_GUARD
+
+#include <deque>
+#include <utility>
+#include <mutex>
+#include <condition_variable>
+#include <GLES3/gl31.h>
+#include "Timeline.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Ogl_device;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Ogl_timeline final : public Timeline {
+public:
+    Ogl_timeline(const Timeline_desc& desc, Ogl_device* device);
+
+    ~Ogl_timeline() override;
+
+    bool wait(uint64_t value, uint64_t timeout = UINT64_MAX) override;
+
+    void signal(uint64_t value) override;
+
+    Device* device() const override;
+
+    uint64_t value() const override;
+
+    void insert(uint64_t value);
+
+private:
+    void retire_(uint64_t value) const;
+
+private:
+    Ogl_device* device_;
+    mutable std::mutex mutex_;
+    std::condition_variable signal_;
+    mutable std::deque<std::pair<uint64_t, GLsync>> syncs_;
+    mutable uint64_t value_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_OGL_TIMELINE_GUARD
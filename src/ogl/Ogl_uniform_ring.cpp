@@ -0,0 +1,130 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include <cstring>
+#include "ogl_lib.h"
+#include "Ogl_uniform_ring.h"
+
+using namespace std;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Ogl_uniform_ring::Ogl_uniform_ring(GLsizeiptr size) :
+    buffer_ {0},
+    size_ {size},
+    alignment_ {0},
+    offset_ {0},
+    contents_ {nullptr},
+    segment_ {0},
+    syncs_ {}
+{
+    init_alignment_();
+    init_buffer_();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Ogl_uniform_ring::~Ogl_uniform_ring()
+{
+    fini_buffer_();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+GLintptr Ogl_uniform_ring::write(const void* data, GLsizeiptr size)
+{
+    auto offset = (offset_ + alignment_ - 1) / alignment_ * alignment_;
+
+    if (offset + size > size_)
+        offset = 0;
+
+    // a segment is entered by the last byte, a write never overlaps a segment which draws may read.
+    if (auto segment = static_cast<uint32_t>((offset + size - 1) * segment_count / size_); segment != segment_)
+        enter_segment_(segment);
+
+    if (contents_) {
+        memcpy(contents_ + offset, data, size);
+    }
+    else {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer_);
+
+        auto contents = glMapBufferRange(GL_COPY_WRITE_BUFFER, offset, size,
+                                         GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+
+        memcpy(contents, data, size);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    }
+
+    offset_ = offset + size;
+
+    return offset;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_uniform_ring::init_alignment_()
+{
+    GLint alignment;
+
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+
+    alignment_ = alignment;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_uniform_ring::init_buffer_()
+{
+    glGenBuffers(1, &buffer_);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer_);
+
+    if (glBufferStorage) {
+        constexpr GLbitfield access {GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT_EXT | GL_MAP_COHERENT_BIT_EXT};
+
+        glBufferStorage(GL_COPY_WRITE_BUFFER, size_, nullptr, access);
+        contents_ = static_cast<uint8_t*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, size_, access));
+
+        if (!contents_)
+            throw runtime_error("fail to create a uniform ring");
+    }
+    else {
+        glBufferData(GL_COPY_WRITE_BUFFER, size_, nullptr, GL_STREAM_DRAW);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_uniform_ring::fini_buffer_()
+{
+    for (auto sync : syncs_) {
+        if (sync)
+            glDeleteSync(sync);
+    }
+
+    glDeleteBuffers(1, &buffer_);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_uniform_ring::enter_segment_(uint32_t segment)
+{
+    // draws which read a current segment are already issued, so a sync is signaled when they are completed.
+    syncs_[segment_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    // a next segment is written after draws of a previous lap are completed.
+    if (auto& sync = syncs_[segment]; sync) {
+        glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX);
+        glDeleteSync(sync);
+        sync = nullptr;
+    }
+
+    segment_ = segment;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
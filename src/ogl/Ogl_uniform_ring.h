@@ -0,0 +1,53 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_OGL_UNIFORM_RING_GUARD
+#define GFX_OGL_UNIFORM_RING_GUARD
+
+#include <cstdint>
+#include <array>
+#include <GLES3/gl31.h>
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Ogl_uniform_ring final {
+public:
+    explicit Ogl_uniform_ring(GLsizeiptr size = 64 * 1024);
+
+    ~Ogl_uniform_ring();
+
+    GLintptr write(const void* data, GLsizeiptr size);
+
+    inline auto buffer() const noexcept
+    { return buffer_; }
+
+private:
+    static constexpr uint32_t segment_count = 4;
+
+    void init_alignment_();
+
+    void init_buffer_();
+
+    void fini_buffer_();
+
+    void enter_segment_(uint32_t segment);
+
+private:
+    GLuint buffer_;
+    GLsizeiptr size_;
+    GLintptr alignment_;
+    GLintptr offset_;
+    uint8_t* contents_;
+    uint32_t segment_;
+    std::array<GLsync, segment_count> syncs_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_OGL_UNIFORM_RING_GUARD
@@ -0,0 +1,80 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "ogl_lib.h"
+#include "Ogl_vertex_array.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Ogl_vertex_array::Ogl_vertex_array(const Ogl_vertex_array_desc& desc) :
+    desc_ {desc},
+    vertex_array_ {0}
+{
+    init_vertex_array_();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Ogl_vertex_array::~Ogl_vertex_array()
+{
+    fini_vertex_array_();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+bool Ogl_vertex_array::references(GLuint buffer) const noexcept
+{
+    if (desc_.index_buffer == buffer)
+        return true;
+
+    for (auto& attribute : desc_.attributes) {
+        if (attribute.enabled && attribute.buffer == buffer)
+            return true;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_vertex_array::init_vertex_array_()
+{
+    glGenVertexArrays(1, &vertex_array_);
+
+    // attributes and an index buffer are recorded in a vertex array, so they are set only once.
+    glBindVertexArray(vertex_array_);
+
+    for (GLuint i = 0; i != max_vertex_input_attributes; ++i) {
+        auto& attribute = desc_.attributes[i];
+
+        if (!attribute.enabled)
+            continue;
+
+        glBindBuffer(GL_ARRAY_BUFFER, attribute.buffer);
+        glEnableVertexAttribArray(i);
+        glVertexAttribPointer(i,
+                              attribute.size,
+                              attribute.type,
+                              GL_FALSE,
+                              attribute.stride,
+                              reinterpret_cast<void*>(attribute.offset));
+        glVertexAttribDivisor(i, attribute.divisor);
+    }
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLuint>(desc_.index_buffer));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Ogl_vertex_array::fini_vertex_array_()
+{
+    glDeleteVertexArrays(1, &vertex_array_);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
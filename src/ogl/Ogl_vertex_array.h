@@ -0,0 +1,85 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_OGL_VERTEX_ARRAY_GUARD
+#define GFX_OGL_VERTEX_ARRAY_GUARD
+
+#include <cstdint>
+#include <array>
+#include <GLES3/gl31.h>
+#include "limitations.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Ogl_vertex_attribute final {
+    uint64_t offset {0};
+    GLuint buffer {0};
+    GLint size {0};
+    GLenum type {0};
+    GLsizei stride {0};
+    GLuint divisor {0};
+    GLuint enabled {GL_FALSE};
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline auto operator==(const Ogl_vertex_attribute& lhs, const Ogl_vertex_attribute& rhs)
+{
+    return (lhs.offset == rhs.offset) && (lhs.buffer == rhs.buffer) && (lhs.size == rhs.size) &&
+           (lhs.type == rhs.type) && (lhs.stride == rhs.stride) && (lhs.divisor == rhs.divisor) &&
+           (lhs.enabled == rhs.enabled);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Ogl_vertex_array_desc final {
+    std::array<Ogl_vertex_attribute, max_vertex_input_attributes> attributes;
+    uint64_t index_buffer {0};
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline auto operator==(const Ogl_vertex_array_desc& lhs, const Ogl_vertex_array_desc& rhs)
+{
+    return (lhs.attributes == rhs.attributes) && (lhs.index_buffer == rhs.index_buffer);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline auto operator!=(const Ogl_vertex_array_desc& lhs, const Ogl_vertex_array_desc& rhs)
+{
+    return !(lhs == rhs);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Ogl_vertex_array final {
+public:
+    explicit Ogl_vertex_array(const Ogl_vertex_array_desc& desc);
+
+    ~Ogl_vertex_array();
+
+    bool references(GLuint buffer) const noexcept;
+
+    inline auto vertex_array() const noexcept
+    { return vertex_array_; }
+
+private:
+    void init_vertex_array_();
+
+    void fini_vertex_array_();
+
+private:
+    Ogl_vertex_array_desc desc_;
+    GLuint vertex_array_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_OGL_VERTEX_ARRAY_GUARD
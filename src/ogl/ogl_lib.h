@@ -7,9 +7,10 @@
 #define GFX_OGL_LIB_GUARD
 
 #include <stdexcept>
-#include <GLES3/gl3.h>
+#include <GLES3/gl31.h>
 #include <GLES2/gl2ext.h>
 #include <sc/enums.h>
+#include "limitations.h"
 #include "enums.h"
 
 #define APPLY_OGL_DRAW_BUFFERS_INDEXED_SYMBOLS(macro) \
@@ -22,6 +23,16 @@
     macro(glColorMaski) \
     macro(glIsEnabledi)
 
+#define APPLY_OGL_DRAW_ELEMENTS_BASE_VERTEX_SYMBOLS(macro) \
+    macro(glDrawElementsInstancedBaseVertex)
+
+#define APPLY_OGL_BASE_INSTANCE_SYMBOLS(macro) \
+    macro(glDrawArraysInstancedBaseInstance) \
+    macro(glDrawElementsInstancedBaseVertexBaseInstance)
+
+#define APPLY_OGL_BUFFER_STORAGE_SYMBOLS(macro) \
+    macro(glBufferStorage)
+
 using PFN_glEnablei = PFNGLENABLEIOESPROC;
 using PFN_glDisablei = PFNGLDISABLEIOESPROC;
 using PFN_glBlendEquationi = PFNGLBLENDEQUATIONIOESPROC;
@@ -30,6 +41,10 @@ using PFN_glBlendFunci = PFNGLBLENDFUNCIOESPROC;
 using PFN_glBlendFuncSeparatei = PFNGLBLENDFUNCSEPARATEIOESPROC;
 using PFN_glColorMaski = PFNGLCOLORMASKIOESPROC;
 using PFN_glIsEnabledi = PFNGLISENABLEDIOESPROC;
+using PFN_glDrawElementsInstancedBaseVertex = PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXOESPROC;
+using PFN_glDrawArraysInstancedBaseInstance = PFNGLDRAWARRAYSINSTANCEDBASEINSTANCEEXTPROC;
+using PFN_glDrawElementsInstancedBaseVertexBaseInstance = PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEEXTPROC;
+using PFN_glBufferStorage = PFNGLBUFFERSTORAGEEXTPROC;
 
 #define DECLARE_OGL_SYMBOL(name) extern PFN_##name name;
 
@@ -38,6 +53,13 @@ namespace Gfx_lib {
 //----------------------------------------------------------------------------------------------------------------------
 
 APPLY_OGL_DRAW_BUFFERS_INDEXED_SYMBOLS(DECLARE_OGL_SYMBOL);
+APPLY_OGL_DRAW_ELEMENTS_BASE_VERTEX_SYMBOLS(DECLARE_OGL_SYMBOL);
+APPLY_OGL_BASE_INSTANCE_SYMBOLS(DECLARE_OGL_SYMBOL);
+APPLY_OGL_BUFFER_STORAGE_SYMBOLS(DECLARE_OGL_SYMBOL);
+
+//----------------------------------------------------------------------------------------------------------------------
+
+constexpr auto push_constant_binding = max_shader_buffers;
 
 //----------------------------------------------------------------------------------------------------------------------
 
@@ -57,6 +79,22 @@ inline GLenum to_GLDataUsage(Heap_type type)
 
 //----------------------------------------------------------------------------------------------------------------------
 
+inline GLbitfield to_GLMapAccess(Heap_type type)
+{
+    switch (type) {
+        case Heap_type::local:
+            return GL_MAP_READ_BIT | GL_MAP_WRITE_BIT;
+        case Heap_type::upload:
+            return GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+        case Heap_type::readback:
+            return GL_MAP_READ_BIT;
+        default:
+            throw std::runtime_error("invalid heap type");
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 inline GLenum to_GLTextureTarget(Image_type type)
 {
     switch (type) {
@@ -187,6 +225,8 @@ inline GLenum to_GLShaderType(Sc_lib::Shader_type type)
             return GL_VERTEX_SHADER;
         case Sc_lib::Shader_type ::fragment:
             return GL_FRAGMENT_SHADER;
+        case Sc_lib::Shader_type::compute:
+            return GL_COMPUTE_SHADER;
         default:
             throw std::runtime_error("invalid shader type");
     }
@@ -0,0 +1,264 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_SPIRV_LIB_GUARD
+#define GFX_SPIRV_LIB_GUARD
+
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+constexpr uint32_t spirv_header_size {5};
+constexpr uint32_t spirv_op_type_bool {20};
+constexpr uint32_t spirv_op_type_int {21};
+constexpr uint32_t spirv_op_type_float {22};
+constexpr uint32_t spirv_op_type_vector {23};
+constexpr uint32_t spirv_op_type_matrix {24};
+constexpr uint32_t spirv_op_type_array {28};
+constexpr uint32_t spirv_op_type_struct {30};
+constexpr uint32_t spirv_op_type_pointer {32};
+constexpr uint32_t spirv_op_constant {43};
+constexpr uint32_t spirv_op_variable {59};
+constexpr uint32_t spirv_op_decorate {71};
+constexpr uint32_t spirv_op_member_decorate {72};
+constexpr uint32_t spirv_op_group_member_decorate {75};
+constexpr uint32_t spirv_op_decorate_id {332};
+constexpr uint32_t spirv_op_decorate_string {5632};
+constexpr uint32_t spirv_op_member_decorate_string {5633};
+constexpr uint32_t spirv_decoration_block {2};
+constexpr uint32_t spirv_decoration_row_major {4};
+constexpr uint32_t spirv_decoration_array_stride {6};
+constexpr uint32_t spirv_decoration_matrix_stride {7};
+constexpr uint32_t spirv_decoration_binding {33};
+constexpr uint32_t spirv_decoration_desc_set {34};
+constexpr uint32_t spirv_decoration_offset {35};
+constexpr uint32_t spirv_storage_class_uniform {2};
+constexpr uint32_t spirv_storage_class_push_constant {9};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline bool is_spirv_annotation(uint32_t opcode) noexcept
+{
+    return (spirv_op_decorate <= opcode && spirv_op_group_member_decorate >= opcode) ||
+           spirv_op_decorate_id == opcode ||
+           spirv_op_decorate_string == opcode ||
+           spirv_op_member_decorate_string == opcode;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline std::vector<uint32_t> remap_push_constants(const std::vector<uint32_t>& src, uint32_t binding)
+{
+    if (spirv_header_size > src.size())
+        throw std::runtime_error("fail to remap push constants");
+
+    std::vector<uint32_t> dst {src.begin(), src.begin() + spirv_header_size};
+    uint32_t variable {0};
+    size_t annotation {0};
+
+    // a push constant block becomes a uniform block, members keep offsets of a block.
+    for (size_t i = spirv_header_size; i < src.size();) {
+        auto word_count = src[i] >> 16;
+        auto opcode = src[i] & 0xffff;
+
+        if (!word_count || src.size() < i + word_count)
+            throw std::runtime_error("fail to remap push constants");
+
+        auto position = dst.size();
+
+        dst.insert(dst.end(), src.begin() + i, src.begin() + i + word_count);
+        i += word_count;
+
+        if (is_spirv_annotation(opcode) && !annotation)
+            annotation = position;
+
+        if (spirv_op_type_pointer == opcode && spirv_storage_class_push_constant == dst[position + 2])
+            dst[position + 2] = spirv_storage_class_uniform;
+
+        if (spirv_op_variable == opcode && spirv_storage_class_push_constant == dst[position + 3]) {
+            dst[position + 3] = spirv_storage_class_uniform;
+            variable = dst[position + 2];
+        }
+    }
+
+    if (!variable)
+        return dst;
+
+    // a block is always decorated, so decorations of a binding are placed in the annotation section.
+    if (!annotation)
+        throw std::runtime_error("fail to remap push constants");
+
+    const uint32_t decorations[] {
+        (4 << 16) | spirv_op_decorate, variable, spirv_decoration_desc_set, 0,
+        (4 << 16) | spirv_op_decorate, variable, spirv_decoration_binding, binding
+    };
+
+    dst.insert(dst.begin() + annotation, std::begin(decorations), std::end(decorations));
+
+    return dst;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline std::unordered_map<uint32_t, uint32_t> reflect_uniform_block_sizes(const std::vector<uint32_t>& src)
+{
+    if (spirv_header_size > src.size())
+        throw std::runtime_error("fail to reflect uniform blocks");
+
+    std::unordered_map<uint32_t, std::vector<uint32_t>> types;
+    std::unordered_map<uint32_t, uint32_t> constants;
+    std::unordered_map<uint32_t, uint32_t> bindings;
+    std::unordered_map<uint32_t, uint32_t> array_strides;
+    std::unordered_set<uint32_t> blocks;
+    std::unordered_map<uint64_t, uint32_t> member_offsets;
+    std::unordered_map<uint64_t, uint32_t> matrix_strides;
+    std::unordered_set<uint64_t> row_majors;
+    std::unordered_map<uint32_t, uint32_t> pointers;
+    std::vector<std::pair<uint32_t, uint32_t>> variables;
+
+    // decorations, types and uniform variables are collected, a size is computed from an explicit layout of a block.
+    for (size_t i = spirv_header_size; i < src.size();) {
+        auto word_count = src[i] >> 16;
+        auto opcode = src[i] & 0xffff;
+
+        if (!word_count || src.size() < i + word_count)
+            throw std::runtime_error("fail to reflect uniform blocks");
+
+        auto words = &src[i];
+
+        i += word_count;
+
+        switch (opcode) {
+            case spirv_op_decorate:
+                if (3 <= word_count && spirv_decoration_block == words[2])
+                    blocks.insert(words[1]);
+                else if (4 <= word_count && spirv_decoration_binding == words[2])
+                    bindings[words[1]] = words[3];
+                else if (4 <= word_count && spirv_decoration_array_stride == words[2])
+                    array_strides[words[1]] = words[3];
+                break;
+            case spirv_op_member_decorate:
+                if (4 <= word_count) {
+                    auto member = (uint64_t(words[1]) << 32) | words[2];
+
+                    if (5 <= word_count && spirv_decoration_offset == words[3])
+                        member_offsets[member] = words[4];
+                    else if (5 <= word_count && spirv_decoration_matrix_stride == words[3])
+                        matrix_strides[member] = words[4];
+                    else if (spirv_decoration_row_major == words[3])
+                        row_majors.insert(member);
+                }
+                break;
+            case spirv_op_type_bool:
+            case spirv_op_type_struct:
+                if (2 <= word_count)
+                    types[words[1]].assign(words, words + word_count);
+                break;
+            case spirv_op_type_int:
+            case spirv_op_type_float:
+                if (3 <= word_count)
+                    types[words[1]].assign(words, words + word_count);
+                break;
+            case spirv_op_type_vector:
+            case spirv_op_type_matrix:
+            case spirv_op_type_array:
+                if (4 <= word_count)
+                    types[words[1]].assign(words, words + word_count);
+                break;
+            case spirv_op_constant:
+                if (4 <= word_count)
+                    constants[words[2]] = words[3];
+                break;
+            case spirv_op_type_pointer:
+                if (4 <= word_count && spirv_storage_class_uniform == words[2])
+                    pointers[words[1]] = words[3];
+                break;
+            case spirv_op_variable:
+                if (4 <= word_count && spirv_storage_class_uniform == words[3])
+                    variables.emplace_back(words[1], words[2]);
+                break;
+            default:
+                break;
+        }
+    }
+
+    auto value = [](auto& values, auto key) -> decltype(auto) {
+        auto iter = values.find(key);
+
+        if (values.end() == iter)
+            throw std::runtime_error("fail to reflect uniform blocks");
+
+        return (iter->second);
+    };
+
+    std::function<uint32_t(uint32_t, uint32_t, bool)> size = [&](uint32_t type, uint32_t matrix_stride,
+                                                                 bool row_major) -> uint32_t {
+        auto& words = value(types, type);
+
+        switch (words[0] & 0xffff) {
+            case spirv_op_type_bool:
+                return 4;
+            case spirv_op_type_int:
+            case spirv_op_type_float:
+                return words[2] / 8;
+            case spirv_op_type_vector:
+                return words[3] * size(words[2], 0, false);
+            case spirv_op_type_matrix:
+                // a stride of a matrix is decorated on a member, a row major matrix is strided by rows.
+                if (!matrix_stride)
+                    throw std::runtime_error("fail to reflect uniform blocks");
+
+                return (row_major ? value(types, words[2])[3] : words[3]) * matrix_stride;
+            case spirv_op_type_array:
+                return value(constants, words[3]) * value(array_strides, type);
+            case spirv_op_type_struct: {
+                uint32_t struct_size {0};
+
+                // a struct ends at the end of a member with the largest offset, members can be declared out of order.
+                for (uint32_t i = 2; i != words.size(); ++i) {
+                    auto member = (uint64_t(type) << 32) | (i - 2);
+                    auto iter = matrix_strides.find(member);
+                    auto member_size = size(words[i],
+                                            matrix_strides.end() != iter ? iter->second : 0,
+                                            row_majors.count(member));
+
+                    struct_size = std::max(struct_size, value(member_offsets, member) + member_size);
+                }
+
+                return struct_size;
+            }
+            default:
+                throw std::runtime_error("fail to reflect uniform blocks");
+        }
+    };
+
+    std::unordered_map<uint32_t, uint32_t> sizes;
+
+    for (auto& [pointer, variable] : variables) {
+        auto type = value(pointers, pointer);
+
+        if (!blocks.count(type) || !bindings.count(variable))
+            continue;
+
+        sizes[bindings[variable]] = size(type, 0, false);
+    }
+
+    return sizes;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_SPIRV_LIB_GUARD
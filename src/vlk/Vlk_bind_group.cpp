@@ -0,0 +1,123 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "std_lib.h"
+#include "vlk_lib.h"
+#include "Vlk_bind_group.h"
+#include "Vlk_device.h"
+#include "Vlk_buffer.h"
+#include "Vlk_image.h"
+#include "Vlk_sampler.h"
+#include "Vlk_pipeline.h"
+#include "Vlk_set_layout.h"
+
+using namespace std;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Vlk_bind_group::Vlk_bind_group(const Bind_group_desc& desc, Vlk_device* device) :
+    Bind_group {desc},
+    device_ {device},
+    set_layout_ {static_cast<Vlk_pipeline*>(desc.pipeline)->set_layout(desc.index)},
+    desc_pool_ {VK_NULL_HANDLE},
+    desc_set_ {VK_NULL_HANDLE}
+{
+    init_desc_pool_();
+    init_desc_set_(static_cast<Vlk_pipeline*>(desc.pipeline));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Vlk_bind_group::~Vlk_bind_group()
+{
+    fini_desc_pool_();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Device* Vlk_bind_group::device() const
+{
+    return device_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_bind_group::init_desc_pool_()
+{
+    if (!set_layout_ || set_layout_->empty())
+        throw runtime_error("fail to create a bind group");
+
+    // a group of a push layout has no set, an encoder pushes its entries.
+    if (set_layout_->push_descriptor())
+        return;
+
+    // a set of a group lives as long as a group, so it has its own pool sized for the set.
+    vector<VkDescriptorPoolSize> pool_sizes;
+
+    for (auto& binding : set_layout_->bindings())
+        pool_sizes.push_back({binding.descriptorType, binding.descriptorCount});
+
+    VkDescriptorPoolCreateInfo create_info {};
+
+    create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    create_info.maxSets = 1;
+    create_info.poolSizeCount = static_cast<uint32_t>(pool_sizes.size());
+    create_info.pPoolSizes = pool_sizes.data();
+
+    if (vkCreateDescriptorPool(device_->device(), &create_info, nullptr, &desc_pool_))
+        throw runtime_error("fail to create a bind group");
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_bind_group::init_desc_set_(Vlk_pipeline* pipeline)
+{
+    if (!desc_pool_)
+        return;
+
+    // configure a descriptor set allocate info.
+    VkDescriptorSetAllocateInfo allocate_info {};
+
+    allocate_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocate_info.descriptorPool = desc_pool_;
+    allocate_info.descriptorSetCount = 1;
+    allocate_info.pSetLayouts = &set_layout_->desc_set_layout();
+
+    if (vkAllocateDescriptorSets(device_->device(), &allocate_info, &desc_set_)) {
+        fini_desc_pool_();
+        throw runtime_error("fail to create a bind group");
+    }
+
+    // a set is written once, it is only bound afterwards.
+    Vlk_desc_info_array infos {};
+
+    for (auto& entry : entries_) {
+        if (entry.buffer) {
+            infos[entry.index].buffer = {static_cast<Vlk_buffer*>(entry.buffer)->buffer(), 0,
+                                         pipeline->buffer_range(entry.index)};
+        }
+        else {
+            infos[entry.index].image = {static_cast<Vlk_sampler*>(entry.sampler)->sampler(),
+                                        static_cast<Vlk_image*>(entry.image)->image_view(),
+                                        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+        }
+    }
+
+    set_layout_->update(desc_set_, infos);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_bind_group::fini_desc_pool_()
+{
+    if (desc_pool_)
+        vkDestroyDescriptorPool(device_->device(), desc_pool_, nullptr);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
@@ -0,0 +1,54 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_VLK_BIND_GROUP_GUARD
+#define GFX_VLK_BIND_GROUP_GUARD
+
+#include <vulkan/vulkan.h>
+#include "Bind_group.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Vlk_device;
+class Vlk_set_layout;
+class Vlk_pipeline;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Vlk_bind_group final : public Bind_group {
+public:
+    Vlk_bind_group(const Bind_group_desc& desc, Vlk_device* device);
+
+    ~Vlk_bind_group() override;
+
+    Device* device() const override;
+
+    inline auto set_layout() const noexcept
+    { return set_layout_; }
+
+    inline auto desc_set() const noexcept
+    { return desc_set_; }
+
+private:
+    void init_desc_pool_();
+
+    void init_desc_set_(Vlk_pipeline* pipeline);
+
+    void fini_desc_pool_();
+
+private:
+    Vlk_device* device_;
+    Vlk_set_layout* set_layout_;
+    VkDescriptorPool desc_pool_;
+    VkDescriptorSet desc_set_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_VLK_BIND_GROUP_GUARD
@@ -14,6 +14,7 @@
 #include "Vlk_render_pass.h"
 #include "Vlk_framebuffer.h"
 #include "Vlk_set_layout.h"
+#include "Vlk_bind_group.h"
 
 using namespace std;
 using namespace Sc_lib;
@@ -99,6 +100,42 @@ inline auto to_framebuffer_desc(Vlk_render_pass* render_pass, const Render_encod
 
 //----------------------------------------------------------------------------------------------------------------------
 
+inline void to_desc_infos(const Vlk_pipeline* pipeline, const Vlk_arg_array<Vlk_arg>& args,
+                          Vlk_desc_info_array& infos)
+{
+    infos = {};
+
+    for (auto i = 0; i != args.size(); ++i) {
+        auto& arg = args[i];
+
+        // a range is a reflected block, so a dynamic offset plus a range stays in a buffer.
+        if (arg.buffer)
+            infos[i].buffer = {arg.buffer->buffer(), 0, pipeline->buffer_range(i)};
+        else if (arg.image && arg.sampler)
+            infos[i].image = {arg.sampler->sampler(), arg.image->image_view(),
+                              VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline uint32_t to_dynamic_offsets(const Vlk_set_layout* set_layout, const Vlk_arg_array<Vlk_arg>& args,
+                                   uint32_t* offsets)
+{
+    uint32_t offset_count = 0;
+
+    // dynamic offsets are ordered by bindings of a layout, an arg which a layout doesn't declare has no offset.
+    for (auto& binding : set_layout->bindings()) {
+        if (VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC == binding.descriptorType ||
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC == binding.descriptorType)
+            offsets[offset_count++] = args[binding.binding].offset;
+    }
+
+    return offset_count;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 }
 
 namespace Gfx_lib {
@@ -122,14 +159,22 @@ void Vlk_arg_table::clear()
 //----------------------------------------------------------------------------------------------------------------------
 
 Vlk_render_encoder::Vlk_render_encoder(const Render_encoder_desc& desc,
-                                       Vlk_device* device, Vlk_cmd_buffer* cmd_buffer) :
+                                       Vlk_device* device, Vlk_cmd_buffer* cmd_buffer,
+                                       VkSubpassContents contents) :
     Render_encoder(),
     device_ {device},
     cmd_buffer_ {cmd_buffer},
+    primary_encoder_ {nullptr},
+    command_buffer_ {cmd_buffer->command_buffer()},
+    contents_ {contents},
+    arena_ {&cmd_buffer->arena()},
+    desc_allocator_ {&cmd_buffer->desc_allocator()},
     cmds_ {},
     vertex_streams_ {},
     index_stream_ {},
     arg_table_ {},
+    push_constants_ {},
+    push_constants_dirty_ {false},
     pipeline_ {nullptr},
     render_pass_ {nullptr},
     framebuffer_ {nullptr},
@@ -137,6 +182,39 @@ Vlk_render_encoder::Vlk_render_encoder(const Render_encoder_desc& desc,
     scissor_ {0, 0, 0, 0}
 {
     begin_render_pass_(desc);
+
+    // only secondary command buffers can record commands inside the pass.
+    if (VK_SUBPASS_CONTENTS_INLINE != contents_)
+        return;
+
+    viewport(to_viewport(framebuffer_->extent()));
+    scissor(to_scissor(framebuffer_->extent()));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Vlk_render_encoder::Vlk_render_encoder(Vlk_render_encoder* primary_encoder, Vlk_secondary& secondary) :
+    Render_encoder(),
+    device_ {primary_encoder->device_},
+    cmd_buffer_ {primary_encoder->cmd_buffer_},
+    primary_encoder_ {primary_encoder},
+    command_buffer_ {secondary.command_buffer},
+    contents_ {VK_SUBPASS_CONTENTS_INLINE},
+    arena_ {&secondary.arena},
+    desc_allocator_ {&secondary.desc_allocator},
+    cmds_ {},
+    vertex_streams_ {},
+    index_stream_ {},
+    arg_table_ {},
+    push_constants_ {},
+    push_constants_dirty_ {false},
+    pipeline_ {nullptr},
+    render_pass_ {primary_encoder->render_pass_},
+    framebuffer_ {primary_encoder->framebuffer_},
+    viewport_ {0.0f, 0.0f, 0.0f, 0.0f},
+    scissor_ {0, 0, 0, 0}
+{
+    begin_secondary_();
     viewport(to_viewport(framebuffer_->extent()));
     scissor(to_scissor(framebuffer_->extent()));
 }
@@ -145,34 +223,84 @@ Vlk_render_encoder::Vlk_render_encoder(const Render_encoder_desc& desc,
 
 void Vlk_render_encoder::end()
 {
+    if (primary_encoder_) {
+        // barriers are recorded into the primary command buffer by the parallel render encoder.
+        cmds_[2].execute(command_buffer_);
+        vkEndCommandBuffer(command_buffer_);
+
+        return;
+    }
+
     end_render_pass_();
 
-    for (auto& [priority, cmds] : cmds_)
-        for_each(cmds, execute);
+    for (auto& cmds : cmds_)
+        cmds.execute(command_buffer_);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Vlk_render_encoder::draw(uint32_t count, uint32_t first)
+void Vlk_render_encoder::draw(uint32_t count, uint32_t first, uint32_t instance_count, uint32_t first_instance)
 {
     update_desc_sets_();
     bind_desc_sets_();
+    bind_push_constants_();
 
-    cmds_[2].push_back([=]() {
-        vkCmdDraw(cmd_buffer_->command_buffer(), count, 1, first, 0);
-    });
+    cmds_[2].record(arena_, Vlk_cmd_draw {count, first, instance_count, first_instance});
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Vlk_render_encoder::draw_indexed(uint32_t count, uint32_t first)
+void Vlk_render_encoder::draw_indexed(uint32_t count, uint32_t first, uint32_t instance_count,
+                                      uint32_t first_instance, int32_t base_vertex)
 {
     update_desc_sets_();
     bind_desc_sets_();
+    bind_push_constants_();
 
-    cmds_[2].push_back([=]() {
-        vkCmdDrawIndexed(cmd_buffer_->command_buffer(), count, 1, first, 0, 0);
-    });
+    cmds_[2].record(arena_, Vlk_cmd_draw_indexed {count, first, instance_count, first_instance, base_vertex});
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_render_encoder::draw_indirect(Buffer* buffer, uint64_t offset, uint32_t draw_count, uint32_t stride)
+{
+    update_desc_sets_();
+    bind_desc_sets_();
+    bind_push_constants_();
+
+    auto buffer_impl = static_cast<Vlk_buffer*>(buffer);
+
+    // draws are recorded one by one when a device can't read many draws from a buffer.
+    if (device_->multi_draw_indirect()) {
+        cmds_[2].record(arena_, Vlk_cmd_draw_indirect {buffer_impl->buffer(), offset, draw_count, stride});
+    }
+    else {
+        for (uint32_t i = 0; i != draw_count; ++i)
+            cmds_[2].record(arena_, Vlk_cmd_draw_indirect {buffer_impl->buffer(), offset + i * stride, 1, stride});
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_render_encoder::draw_indexed_indirect(Buffer* buffer, uint64_t offset, uint32_t draw_count, uint32_t stride)
+{
+    update_desc_sets_();
+    bind_desc_sets_();
+    bind_push_constants_();
+
+    auto buffer_impl = static_cast<Vlk_buffer*>(buffer);
+
+    // draws are recorded one by one when a device can't read many draws from a buffer.
+    if (device_->multi_draw_indirect()) {
+        cmds_[2].record(arena_, Vlk_cmd_draw_indexed_indirect {buffer_impl->buffer(), offset, draw_count, stride});
+    }
+    else {
+        for (uint32_t i = 0; i != draw_count; ++i) {
+            Vlk_cmd_draw_indexed_indirect cmd {buffer_impl->buffer(), offset + i * stride, 1, stride};
+
+            cmds_[2].record(arena_, cmd);
+        }
+    }
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -184,10 +312,7 @@ void Vlk_render_encoder::vertex_buffer(Buffer* buffer, uint64_t offset, uint32_t
     if (vertex_stream == vertex_streams_[index])
         return;
 
-    cmds_[2].push_back([=]() {
-        vkCmdBindVertexBuffers(cmd_buffer_->command_buffer(),
-                               index, 1, &vertex_stream.buffer->buffer(), &vertex_stream.offset);
-    });
+    cmds_[2].record(arena_, Vlk_cmd_bind_vertex_buffer {index, vertex_stream.buffer->buffer(), vertex_stream.offset});
 
     // update a vertex stream.
     vertex_streams_[index] = vertex_stream;
@@ -202,11 +327,8 @@ void Vlk_render_encoder::index_buffer(Buffer* buffer, uint64_t offset, Index_typ
     if (index_stream == index_stream_)
         return;
 
-    cmds_[2].push_back([=]() {
-        vkCmdBindIndexBuffer(cmd_buffer_->command_buffer(),
-                             index_stream.buffer->buffer(), index_stream.offset,
-                             to_VkIndexType(index_stream.index_type));
-    });
+    cmds_[2].record(arena_, Vlk_cmd_bind_index_buffer {index_stream.buffer->buffer(), index_stream.offset,
+                                                       to_VkIndexType(index_stream.index_type)});
 
     // update an index buffer.
     index_stream_ = index_stream;
@@ -220,12 +342,13 @@ void Vlk_render_encoder::shader_buffer(Buffer* buffer, uint32_t offset, uint32_t
     auto& args = arg_table_[0];
 
     if (buffer_impl != args[index].buffer) {
-        args.dirty_flags = 0x1;
+        args.dirty_flags |= 0x1;
         args[index].buffer = buffer_impl;
     }
 
+    // an offset is a dynamic offset, it only requires to rebind a desc set.
     if (offset != args[index].offset) {
-        args[index].dirty_flags = 0x1;
+        args.dirty_flags |= 0x4;
         args[index].offset = offset;
     }
 }
@@ -237,38 +360,7 @@ void Vlk_render_encoder::shader_texture(Image* image, Sampler* sampler, uint32_t
     auto image_impl = static_cast<Vlk_image*>(image);
     auto sampler_impl = static_cast<Vlk_sampler*>(sampler);
 
-    cmds_[0].push_back([=]() {
-        if (VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL == image_impl->layout())
-            return;
-
-        // configure an image barrier.
-        VkImageMemoryBarrier barrier {};
-
-        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        barrier.srcAccessMask = image_impl->access_mask();
-        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-        barrier.oldLayout = image_impl->layout();
-        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.image = image_impl->image();
-        barrier.subresourceRange.aspectMask = image_impl->aspect_mask();
-        barrier.subresourceRange.levelCount = image_impl->mip_levels();
-        barrier.subresourceRange.layerCount = image_impl->array_layers();
-
-        // update image meta data.
-        image_impl->access_mask_ = VK_ACCESS_SHADER_READ_BIT;
-        image_impl->layout_ = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-        // record barrier command.
-        vkCmdPipelineBarrier(cmd_buffer_->command_buffer(),
-                             VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
-                             VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-                             VK_DEPENDENCY_BY_REGION_BIT,
-                             0, nullptr,
-                             0, nullptr,
-                             1, &barrier);
-    });
+    cmds_[0].record(arena_, Vlk_cmd_shader_read_barrier {image_impl});
 
     auto& args = arg_table_[1];
 
@@ -285,6 +377,57 @@ void Vlk_render_encoder::shader_texture(Image* image, Sampler* sampler, uint32_t
 
 //----------------------------------------------------------------------------------------------------------------------
 
+void Vlk_render_encoder::shader_bytes(Pipeline_stage stage, uint32_t offset, const void* data, uint32_t size)
+{
+    if (max_push_constant_size < offset + size)
+        throw runtime_error("fail to set shader bytes");
+
+    // bytes are kept until a draw, stages come from a range of a pipeline, so a stage is ignored.
+    copy_n(static_cast<const uint8_t*>(data), size, push_constants_.begin() + offset);
+    push_constants_dirty_ = true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_render_encoder::bind_group(uint32_t index, Bind_group* bind_group, const vector<uint32_t>& dynamic_offsets)
+{
+    bind_group->validate_binding(index, dynamic_offsets);
+
+    auto bind_group_impl = static_cast<Vlk_bind_group*>(bind_group);
+    auto& args = arg_table_[index];
+    auto offset_index = 0;
+
+    // args mirror a group, so a set can be rebuilt from them when a pipeline is changed.
+    args.fill({});
+
+    for (auto& entry : bind_group_impl->entries()) {
+        auto& arg = args[entry.index];
+
+        if (entry.buffer) {
+            arg.buffer = static_cast<Vlk_buffer*>(entry.buffer);
+            arg.offset = dynamic_offsets.empty() ? 0 : dynamic_offsets[offset_index++];
+        }
+        else {
+            arg.image = static_cast<Vlk_image*>(entry.image);
+            arg.sampler = static_cast<Vlk_sampler*>(entry.sampler);
+
+            cmds_[0].record(arena_, Vlk_cmd_shader_read_barrier {arg.image});
+        }
+    }
+
+    // a set of a group is already written, it only needs to be bound when a set layout is same.
+    if (pipeline_ && pipeline_->set_layout(index) != bind_group_impl->set_layout()) {
+        args.dirty_flags = 0x1;
+        return;
+    }
+
+    args.desc_set = bind_group_impl->desc_set();
+    args.set_layout = bind_group_impl->set_layout();
+    args.dirty_flags = 0x4;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 void Vlk_render_encoder::pipeline(Pipeline* pipeline)
 {
     auto pipeline_impl = static_cast<Vlk_pipeline*>(pipeline);
@@ -292,10 +435,23 @@ void Vlk_render_encoder::pipeline(Pipeline* pipeline)
     if (pipeline_impl == pipeline_)
         return;
 
-    cmds_[2].push_back([=]() {
-        vkCmdBindPipeline(cmd_buffer_->command_buffer(),
-                          VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_impl->pipeline());
-    });
+    cmds_[2].record(arena_, Vlk_cmd_bind_pipeline {VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_impl->pipeline()});
+
+    // desc sets are allocated from set layouts of a pipeline, a set is reused when a set layout is same.
+    for (auto i = 0; i != 2; ++i) {
+        auto& args = arg_table_[i];
+
+        // a set of a group bound before a first pipeline is kept, it is already written for a same layout.
+        auto set_layout = pipeline_ ? pipeline_->set_layout(i) : args.set_layout;
+
+        if (set_layout != pipeline_impl->set_layout(i))
+            args.dirty_flags |= 0x1;
+        else
+            args.dirty_flags |= 0x4;
+    }
+
+    // push constants are pushed again, a range of a new pipeline can differ.
+    push_constants_dirty_ = true;
 
     // update a pipeline.
     pipeline_ = pipeline_impl;
@@ -308,11 +464,7 @@ void Vlk_render_encoder::viewport(const Viewport& viewport)
     if (viewport == viewport_)
         return;
 
-    cmds_[2].push_back([=]() {
-        auto vk_viewport = to_VkViewport(viewport);
-
-        vkCmdSetViewport(cmd_buffer_->command_buffer(), 0, 1, &vk_viewport);
-    });
+    cmds_[2].record(arena_, Vlk_cmd_set_viewport {to_VkViewport(viewport)});
 
     viewport_ = viewport;
 }
@@ -324,11 +476,7 @@ void Vlk_render_encoder::scissor(const Scissor& scissor)
     if (scissor == scissor_)
         return;
 
-    cmds_[2].push_back([=]() {
-        auto vk_scissor = to_VkRect2D(scissor);
-
-        vkCmdSetScissor(cmd_buffer_->command_buffer(), 0, 1, &vk_scissor);
-    });
+    cmds_[2].record(arena_, Vlk_cmd_set_scissor {to_VkRect2D(scissor)});
 
     scissor_ = scissor;
 }
@@ -347,268 +495,253 @@ void Vlk_render_encoder::begin_render_pass_(const Render_encoder_desc& desc)
     render_pass_ = device_->render_pass(to_render_pass_desc(desc));
     framebuffer_ = device_->framebuffer(to_framebuffer_desc(render_pass_, desc));
 
-    cmds_[0].push_back([=]() {
-        vector<VkImageMemoryBarrier> barriers;
-
-        for (auto& color : desc.colors) {
-            if (!color.image)
-                continue;
+    Vlk_cmd_begin_render_pass_barrier barrier_cmd {};
 
-            auto image_impl = static_cast<Vlk_image*>(color.image);
+    for (auto i = 0; i != max_color_attachments; ++i)
+        barrier_cmd.colors[i] = static_cast<Vlk_image*>(desc.colors[i].image);
 
-            if (VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL == image_impl->layout())
-                continue;
+    barrier_cmd.depth_stencil = static_cast<Vlk_image*>(desc.depth_stencil.image);
 
-            // configure an image barrier.
-            VkImageMemoryBarrier barrier {};
+    cmds_[0].record(arena_, barrier_cmd);
 
-            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-            barrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-            barrier.oldLayout = image_impl->layout();
-            barrier.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-            barrier.image = image_impl->image();
-            barrier.subresourceRange.aspectMask = image_impl->aspect_mask();
-            barrier.subresourceRange.levelCount = image_impl->mip_levels();
-            barrier.subresourceRange.layerCount = image_impl->array_layers();
+    Vlk_cmd_begin_render_pass begin_cmd {};
 
-            barriers.push_back(barrier);
+    begin_cmd.render_pass = render_pass_->render_pass();
+    begin_cmd.framebuffer = framebuffer_->framebuffer();
+    begin_cmd.extent = to_VkExtent2D(framebuffer_->extent());
+    begin_cmd.contents = contents_;
 
-            // update image meta data.
-            image_impl->access_mask_ = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-            image_impl->layout_ = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-        }
+    for (auto& color : desc.colors) {
+        if (!color.image)
+            break;
 
-        auto& depth_stencil = desc.depth_stencil;
+        if (Load_op::clear != color.load_op)
+            continue;
 
-        if (depth_stencil.image) {
-            auto image_impl = static_cast<Vlk_image*>(depth_stencil.image);
+        // configure clear value.
+        auto& clear_value = begin_cmd.clear_values[begin_cmd.clear_value_count++];
 
-            if (VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL != image_impl->layout()) {
-                // configure an image barrier.
-                VkImageMemoryBarrier barrier {};
+        clear_value.color.float32[0] = color.clear_value.r;
+        clear_value.color.float32[1] = color.clear_value.g;
+        clear_value.color.float32[2] = color.clear_value.b;
+        clear_value.color.float32[3] = color.clear_value.a;
+    }
 
-                barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-                barrier.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-                barrier.oldLayout = image_impl->layout();
-                barrier.newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-                barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-                barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-                barrier.image = image_impl->image();
-                barrier.subresourceRange.aspectMask = image_impl->aspect_mask();
-                barrier.subresourceRange.levelCount = image_impl->mip_levels();
-                barrier.subresourceRange.layerCount = image_impl->array_layers();
+    auto& depth_stencil = desc.depth_stencil;
 
-                barriers.push_back(barrier);
+    if (depth_stencil.image) {
+        if (Load_op::clear == depth_stencil.load_op) {
+            // configure clear value.
+            auto& clear_value = begin_cmd.clear_values[begin_cmd.clear_value_count++];
 
-                // update image meta data.
-                image_impl->access_mask_ = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-                image_impl->layout_ = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-            }
+            clear_value.depthStencil.depth = depth_stencil.clear_value.d;
+            clear_value.depthStencil.stencil = depth_stencil.clear_value.s;
         }
+    }
 
-        vkCmdPipelineBarrier(cmd_buffer_->command_buffer(),
-                             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-                             VK_DEPENDENCY_BY_REGION_BIT,
-                             0, nullptr,
-                             0, nullptr,
-                             barriers.size(), &barriers[0]);
-    });
+    cmds_[1].record(arena_, begin_cmd);
+}
 
-    cmds_[1].push_back([=]() {
-        vector<VkClearValue> clear_values;
+//----------------------------------------------------------------------------------------------------------------------
 
-        for (auto& color : desc.colors) {
-            if (!color.image)
-                break;
+void Vlk_render_encoder::end_render_pass_()
+{
+    cmds_[3].record(arena_, Vlk_cmd_end_render_pass {});
+}
 
-            if (Load_op::clear != color.load_op)
-                continue;
+//----------------------------------------------------------------------------------------------------------------------
 
-            // configure clear value.
-            VkClearValue clear_value;
+void Vlk_render_encoder::begin_secondary_()
+{
+    // configure the command buffer inheritance info, a secondary continues the primary's render pass.
+    VkCommandBufferInheritanceInfo inheritance_info {};
 
-            clear_value.color.float32[0] = color.clear_value.r;
-            clear_value.color.float32[1] = color.clear_value.g;
-            clear_value.color.float32[2] = color.clear_value.b;
-            clear_value.color.float32[3] = color.clear_value.a;
+    inheritance_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritance_info.renderPass = render_pass_->render_pass();
+    inheritance_info.subpass = 0;
+    inheritance_info.framebuffer = framebuffer_->framebuffer();
 
-            clear_values.push_back(clear_value);
-        }
+    // configure the command buffer begin info.
+    VkCommandBufferBeginInfo begin_info {};
+
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT |
+                       VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    begin_info.pInheritanceInfo = &inheritance_info;
 
-        auto& depth_stencil = desc.depth_stencil;
+    // start recording.
+    vkBeginCommandBuffer(command_buffer_, &begin_info);
+}
 
-        if (depth_stencil.image) {
-            if (Load_op::clear == depth_stencil.load_op) {
-                // configure clear value.
-                VkClearValue clear_value;
+//----------------------------------------------------------------------------------------------------------------------
 
-                clear_value.depthStencil.depth = depth_stencil.clear_value.d;
-                clear_value.depthStencil.stencil = depth_stencil.clear_value.s;
+void Vlk_render_encoder::update_desc_sets_()
+{
+    for (auto i = 0; i != 2; ++i) {
+        auto& args = arg_table_[i];
 
-                clear_values.push_back(clear_value);
-            }
-        }
+        // only a dynamic offset is changed, the bound set is rebound with new offsets.
+        if (!(args.dirty_flags & 0x3))
+            continue;
 
-        // configure a render pass begin info.
-        VkRenderPassBeginInfo begin_info {};
+        args.dirty_flags = 0x4;
 
-        begin_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        begin_info.renderPass = render_pass_->render_pass();
-        begin_info.framebuffer = framebuffer_->framebuffer();
-        begin_info.renderArea.extent = to_VkExtent2D(framebuffer_->extent());
-        begin_info.clearValueCount = clear_values.size();
-        begin_info.pClearValues = &clear_values[0];
+        auto set_layout = pipeline_->set_layout(i);
 
-        vkCmdBeginRenderPass(cmd_buffer_->command_buffer(), &begin_info, VK_SUBPASS_CONTENTS_INLINE);
-    });
-}
+        args.set_layout = set_layout;
 
-//----------------------------------------------------------------------------------------------------------------------
+        // a push layout has no set, descriptors are pushed when sets are bound.
+        if (!set_layout || set_layout->empty() || set_layout->push_descriptor()) {
+            args.desc_set = VK_NULL_HANDLE;
+            continue;
+        }
 
-void Vlk_render_encoder::end_render_pass_()
-{
-    cmds_[3].push_back([=]() {
-        vkCmdEndRenderPass(cmd_buffer_->command_buffer());
-    });
+        args.desc_set = desc_allocator_->allocate(set_layout);
+
+        Vlk_desc_info_array infos;
+
+        to_desc_infos(pipeline_, args, infos);
+        set_layout->update(args.desc_set, infos);
+    }
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Vlk_render_encoder::update_desc_sets_()
+void Vlk_render_encoder::bind_desc_sets_()
 {
-    unordered_map<uint32_t, VkDescriptorBufferInfo> buffer_infos;
+    if (!((arg_table_[0].dirty_flags | arg_table_[1].dirty_flags) & 0x4))
+        return;
 
-    if (arg_table_[0].dirty_flags) {
-        arg_table_[0].dirty_flags = 0;
+    auto push = arg_table_[1].dirty_flags & 0x4;
 
-        auto set_layout = pipeline_->set_layout(0);
+    arg_table_[0].dirty_flags &= ~0x4;
+    arg_table_[1].dirty_flags &= ~0x4;
 
-        arg_table_[0].desc_set = set_layout->desc_set();
+    array<VkDescriptorSet, 2> desc_sets;
+    array<uint32_t, 16> offsets;
+    uint32_t first_set = arg_table_[0].desc_set ? 0 : 1;
+    uint32_t desc_set_count = 0;
+    uint32_t offset_count = 0;
 
-        for (auto i = 0; i != 16; ++i) {
-            if (!arg_table_[0][i].buffer)
-                continue;
+    if (arg_table_[0].desc_set) {
+        desc_sets[desc_set_count++] = arg_table_[0].desc_set;
+        offset_count = to_dynamic_offsets(pipeline_->set_layout(0), arg_table_[0], offsets.data());
+    }
 
-            VkDescriptorBufferInfo buffer_info {};
+    if (arg_table_[1].desc_set) {
+        desc_sets[desc_set_count++] = arg_table_[1].desc_set;
+    }
 
-            buffer_info.buffer = arg_table_[0][i].buffer->buffer();
-            buffer_info.offset = 0;
-            buffer_info.range = VK_WHOLE_SIZE;
+    if (desc_set_count) {
+        // arrays are referenced by the command, so they are copied to the arena.
+        auto cmd_desc_sets = arena_->allocate<VkDescriptorSet>(desc_set_count);
+        auto cmd_offsets = arena_->allocate<uint32_t>(offset_count);
 
-            buffer_infos.insert({i, buffer_info});
-        }
+        copy_n(desc_sets.begin(), desc_set_count, cmd_desc_sets);
+        copy_n(offsets.begin(), offset_count, cmd_offsets);
+
+        cmds_[2].record(arena_, Vlk_cmd_bind_desc_sets {VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                                        pipeline_->pipeline_layout(),
+                                                        first_set,
+                                                        desc_set_count, cmd_desc_sets,
+                                                        offset_count, cmd_offsets});
     }
 
-    if (!buffer_infos.empty()) {
-        vector<VkWriteDescriptorSet> write_desc_sets;
+    auto set_layout = pipeline_->set_layout(1);
 
-        for (auto& [binding, buffer_info] : buffer_infos) {
-            VkWriteDescriptorSet write_desc_set {};
+    if (!push || !set_layout || !set_layout->push_descriptor())
+        return;
 
-            write_desc_set.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            write_desc_set.dstSet = arg_table_[0].desc_set;
-            write_desc_set.dstBinding = binding;
-            write_desc_set.descriptorCount = 1;
-            write_desc_set.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
-            write_desc_set.pBufferInfo = &buffer_info;
+    // textures are pushed after sets are bound, binding a lower set doesn't disturb pushed descriptors.
+    auto infos = arena_->allocate<Vlk_desc_info_array>(1);
 
-            write_desc_sets.push_back(write_desc_set);
-        }
+    to_desc_infos(pipeline_, arg_table_[1], *infos);
 
-        vkUpdateDescriptorSets(device_->device(),
-                               write_desc_sets.size(), &write_desc_sets[0],
-                               0, nullptr);
-    }
+    cmds_[2].record(arena_, Vlk_cmd_push_desc_set {VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_->pipeline_layout(),
+                                                   1, set_layout, infos});
+}
 
-    unordered_map<uint32_t, VkDescriptorImageInfo> image_infos;
+//----------------------------------------------------------------------------------------------------------------------
 
-    if (arg_table_[1].dirty_flags) {
-        arg_table_[1].dirty_flags = 0;
+void Vlk_render_encoder::bind_push_constants_()
+{
+    auto& push_constant_range = pipeline_->push_constant_range();
 
-        auto set_layout = pipeline_->set_layout(1);
+    if (!push_constants_dirty_ || !push_constant_range.size)
+        return;
 
-        arg_table_[1].desc_set = set_layout->desc_set();
+    push_constants_dirty_ = false;
 
-        for (auto i = 0; i != 16; ++i) {
-            if (!arg_table_[1][i].image && !arg_table_[1][i].sampler)
-                continue;
+    // values are referenced by the command, so they are copied to the arena.
+    auto values = arena_->allocate<uint8_t>(push_constant_range.size);
 
-            VkDescriptorImageInfo image_info {};
+    copy_n(push_constants_.begin(), push_constant_range.size, values);
 
-            image_info.sampler = arg_table_[1][i].sampler->sampler();
-            image_info.imageView = arg_table_[1][i].image->image_view();
-            image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    cmds_[2].record(arena_, Vlk_cmd_push_constants {pipeline_->pipeline_layout(), push_constant_range.stageFlags,
+                                                    push_constant_range.size, values});
+}
 
-            image_infos.insert({i, image_info});
-        }
-    }
+//----------------------------------------------------------------------------------------------------------------------
 
-    if (!image_infos.empty()) {
-        vector<VkWriteDescriptorSet> write_desc_sets;
+Vlk_parallel_render_encoder::Vlk_parallel_render_encoder(const Parallel_render_encoder_desc& desc,
+                                                         Vlk_device* device, Vlk_cmd_buffer* cmd_buffer) :
+    Parallel_render_encoder(),
+    cmd_buffer_ {cmd_buffer},
+    encoder_ {desc.render_encoder, device, cmd_buffer, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS},
+    encoders_ {},
+    mutex_ {}
+{
+}
 
-        for (auto& [binding, image_info] : image_infos) {
-            VkWriteDescriptorSet write_desc_set {};
+//----------------------------------------------------------------------------------------------------------------------
 
-            write_desc_set.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            write_desc_set.dstSet = arg_table_[1].desc_set;
-            write_desc_set.dstBinding = binding;
-            write_desc_set.descriptorCount = 1;
-            write_desc_set.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-            write_desc_set.pImageInfo = &image_info;
+Render_encoder* Vlk_parallel_render_encoder::render_encoder()
+{
+    lock_guard<mutex> lock {mutex_};
 
-            write_desc_sets.push_back(write_desc_set);
-        }
+    encoders_.push_back(make_unique<Vlk_render_encoder>(&encoder_, cmd_buffer_->secondary()));
 
-        vkUpdateDescriptorSets(device_->device(),
-                               write_desc_sets.size(), &write_desc_sets[0],
-                               0, nullptr);
-    }
+    return encoders_.back().get();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Vlk_render_encoder::bind_desc_sets_()
+void Vlk_parallel_render_encoder::end()
 {
-    vector<VkDescriptorSet> desc_sets;
-    vector<uint32_t> offsets;
-
-    if (arg_table_[0].desc_set) {
-        desc_sets.push_back(arg_table_[0].desc_set);
+    auto command_buffer_count = static_cast<uint32_t>(encoders_.size());
+    auto command_buffers = cmd_buffer_->arena().allocate<VkCommandBuffer>(command_buffer_count);
 
-        for (auto i = 0; i != 16; ++i) {
-            if (!arg_table_[0][i].buffer)
-                continue;
-
-            offsets.push_back(arg_table_[0][i].offset);
-        }
+    for (auto i = 0; i != command_buffer_count; ++i) {
+        // barriers can't be recorded inside a render pass, so they precede the primary's render pass.
+        encoder_.cmds_[0].splice(encoders_[i]->cmds_[0]);
+        command_buffers[i] = encoders_[i]->command_buffer_;
     }
 
-    if (arg_table_[1].desc_set) {
-        desc_sets.push_back(arg_table_[1].desc_set);
-    }
+    if (command_buffer_count)
+        encoder_.cmds_[2].record(&cmd_buffer_->arena(),
+                                 Vlk_cmd_execute_commands {command_buffer_count, command_buffers});
 
-    if (desc_sets.empty())
-        return;
+    encoder_.end();
+}
 
-    auto pipeline_layout = pipeline_->pipeline_layout();
+//----------------------------------------------------------------------------------------------------------------------
 
-    cmds_[2].push_back([=]() {
-        vkCmdBindDescriptorSets(cmd_buffer_->command_buffer(),
-                                VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout,
-                                0,
-                                static_cast<uint32_t>(desc_sets.size()), &desc_sets[0],
-                                static_cast<uint32_t>(offsets.size()), &offsets[0]);
-    });
+Cmd_buffer* Vlk_parallel_render_encoder::cmd_buffer() const
+{
+    return cmd_buffer_;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-Vlk_blit_encoder::Vlk_blit_encoder(const Blit_encoder_desc& desc, Vlk_cmd_buffer* cmd_buffer) :
+Vlk_blit_encoder::Vlk_blit_encoder(const Blit_encoder_desc& desc, Vlk_device* device, Vlk_cmd_buffer* cmd_buffer) :
     Blit_encoder(),
+    device_ {device},
     cmd_buffer_ {cmd_buffer},
-    cmds_ {}
+    arena_ {&cmd_buffer->arena()},
+    cmds_ {},
+    dst_buffers_ {},
+    dst_images_ {},
+    releasable_ {Queue_type::transfer == cmd_buffer->queue_type() && device->has_transfer_queue()}
 {
 }
 
@@ -619,18 +752,17 @@ void Vlk_blit_encoder::copy(Buffer* src_buffer, Buffer* dst_buffer, const Buffer
     auto src_buffer_impl = static_cast<Vlk_buffer*>(src_buffer);
     auto dst_buffer_impl = static_cast<Vlk_buffer*>(dst_buffer);
 
-    cmds_.push_back([=]() {
-        // configure buffer copy.
-        VkBufferCopy copy {};
+    if (releasable_ && dst_buffers_.end() == find(dst_buffers_.begin(), dst_buffers_.end(), dst_buffer_impl))
+        dst_buffers_.push_back(dst_buffer_impl);
 
-        copy.srcOffset = region.src_offset;
-        copy.dstOffset = region.dst_offset;
-        copy.size = region.size;
+    // configure buffer copy.
+    VkBufferCopy copy {};
 
-        // record a copy command.
-        vkCmdCopyBuffer(cmd_buffer_->command_buffer(),
-                        src_buffer_impl->buffer(), dst_buffer_impl->buffer(), 1, &copy);
-    });
+    copy.srcOffset = region.src_offset;
+    copy.dstOffset = region.dst_offset;
+    copy.size = region.size;
+
+    cmds_.record(arena_, Vlk_cmd_copy_buffer {src_buffer_impl->buffer(), dst_buffer_impl->buffer(), copy});
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -640,145 +772,466 @@ void Vlk_blit_encoder::copy(Buffer* src_buffer, Image* dst_image, const Buffer_i
     auto src_buffer_impl = static_cast<Vlk_buffer*>(src_buffer);
     auto dst_image_impl = static_cast<Vlk_image*>(dst_image);
 
-    cmds_.push_back([=]() {
-        if (VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL == dst_image_impl->layout())
-            return;
+    if (releasable_ && dst_images_.end() == find(dst_images_.begin(), dst_images_.end(), dst_image_impl))
+        dst_images_.push_back(dst_image_impl);
 
-        // configure an image barrier.
+    cmds_.record(arena_, Vlk_cmd_transfer_dst_barrier {dst_image_impl});
+
+    // configure a buffer image copy.
+    VkBufferImageCopy copy {};
+
+    copy.imageSubresource.aspectMask = dst_image_impl->aspect_mask();
+    copy.imageSubresource.mipLevel = region.image_subresource.mip_level;
+    copy.imageSubresource.baseArrayLayer = region.image_subresource.array_layer;
+    copy.imageSubresource.layerCount = 1;
+    copy.imageOffset.x = region.image_offset.x;
+    copy.imageOffset.y = region.image_offset.y;
+    copy.imageOffset.z = region.image_offset.z;
+    copy.imageExtent.width = region.image_extent.w;
+    copy.imageExtent.height = region.image_extent.h;
+    copy.imageExtent.depth = region.image_extent.d;
+
+    cmds_.record(arena_, Vlk_cmd_copy_buffer_to_image {src_buffer_impl->buffer(), dst_image_impl->image(), copy});
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_blit_encoder::copy(Image* src_image, Buffer* dst_buffer, const Buffer_image_copy_region& region)
+{
+    auto src_image_impl = static_cast<Vlk_image*>(src_image);
+    auto dst_buffer_impl = static_cast<Vlk_buffer*>(dst_buffer);
+
+    // an image is owned by the graphics queue, so a readback can't be recorded on the transfer queue.
+    if (releasable_)
+        throw runtime_error("fail to copy an image on the transfer queue");
+
+    cmds_.record(arena_, Vlk_cmd_transfer_src_barrier {src_image_impl});
+
+    // configure a buffer image copy.
+    VkBufferImageCopy copy {};
+
+    copy.bufferOffset = region.buffer_offset;
+    copy.bufferRowLength = region.buffer_row_size;
+    copy.bufferImageHeight = region.buffer_image_height;
+    copy.imageSubresource.aspectMask = src_image_impl->aspect_mask();
+    copy.imageSubresource.mipLevel = region.image_subresource.mip_level;
+    copy.imageSubresource.baseArrayLayer = region.image_subresource.array_layer;
+    copy.imageSubresource.layerCount = 1;
+    copy.imageOffset.x = region.image_offset.x;
+    copy.imageOffset.y = region.image_offset.y;
+    copy.imageOffset.z = region.image_offset.z;
+    copy.imageExtent.width = region.image_extent.w;
+    copy.imageExtent.height = region.image_extent.h;
+    copy.imageExtent.depth = region.image_extent.d;
+
+    cmds_.record(arena_, Vlk_cmd_copy_image_to_buffer {src_image_impl->image(), dst_buffer_impl->buffer(), copy});
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_blit_encoder::end()
+{
+    cmds_.execute(cmd_buffer_->command_buffer());
+
+    if (releasable_)
+        release_ownerships_();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cmd_buffer* Vlk_blit_encoder::cmd_buffer() const
+{
+    return cmd_buffer_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_blit_encoder::release_ownerships_()
+{
+    vector<VkBufferMemoryBarrier> buffer_barriers;
+
+    for (auto buffer_impl : dst_buffers_) {
+        // configure a buffer barrier releasing an ownership.
+        VkBufferMemoryBarrier barrier {};
+
+        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.srcQueueFamilyIndex = device_->transfer_queue_family_index();
+        barrier.dstQueueFamilyIndex = device_->queue_family_index();
+        barrier.buffer = buffer_impl->buffer();
+        barrier.size = VK_WHOLE_SIZE;
+
+        buffer_barriers.push_back(barrier);
+
+        // the graphics queue acquires an ownership with the same barrier.
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT |
+                                VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT;
+
+        cmd_buffer_->add_acquire_barrier(barrier);
+    }
+
+    vector<VkImageMemoryBarrier> image_barriers;
+
+    for (auto image_impl : dst_images_) {
+        // configure an image barrier releasing an ownership.
         VkImageMemoryBarrier barrier {};
 
         barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        barrier.oldLayout = dst_image_impl->layout();
-        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.image = dst_image_impl->image();
-        barrier.subresourceRange.aspectMask = dst_image_impl->aspect_mask();
-        barrier.subresourceRange.levelCount = dst_image_impl->mip_levels();
-        barrier.subresourceRange.layerCount = dst_image_impl->array_layers();
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        barrier.srcQueueFamilyIndex = device_->transfer_queue_family_index();
+        barrier.dstQueueFamilyIndex = device_->queue_family_index();
+        barrier.image = image_impl->image();
+        barrier.subresourceRange.aspectMask = image_impl->aspect_mask();
+        barrier.subresourceRange.levelCount = image_impl->mip_levels();
+        barrier.subresourceRange.layerCount = image_impl->array_layers();
+
+        image_barriers.push_back(barrier);
+
+        // the graphics queue acquires an ownership with the same barrier.
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+        cmd_buffer_->add_acquire_barrier(barrier);
 
         // update image meta data.
-        dst_image_impl->access_mask_ = VK_ACCESS_TRANSFER_WRITE_BIT;
-        dst_image_impl->layout_ = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        image_impl->access_mask_ = VK_ACCESS_SHADER_READ_BIT;
+        image_impl->layout_ = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    }
 
-        // recoard a barrier command.
-        vkCmdPipelineBarrier(cmd_buffer_->command_buffer(),
-                             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                             VK_DEPENDENCY_BY_REGION_BIT,
-                             0, nullptr,
-                             0, nullptr,
-                             1, &barrier);
+    // record release barriers.
+    vkCmdPipelineBarrier(cmd_buffer_->command_buffer(),
+                         VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                         0,
+                         0, nullptr,
+                         buffer_barriers.size(), buffer_barriers.data(),
+                         image_barriers.size(), image_barriers.data());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Vlk_compute_encoder::Vlk_compute_encoder(const Compute_encoder_desc& desc,
+                                         Vlk_device* device, Vlk_cmd_buffer* cmd_buffer) :
+    Compute_encoder(),
+    device_ {device},
+    cmd_buffer_ {cmd_buffer},
+    cmds_ {},
+    arg_table_ {},
+    pipeline_ {nullptr},
+    dispatched_ {false}
+{
+    // make writes of previous passes visible and wait reads of them before any dispatch.
+    memory_barrier_(VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+                    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                    VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                    VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                    VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT |
+                    VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_compute_encoder::end()
+{
+    // make writes of dispatches visible to following passes.
+    memory_barrier_(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                    VK_ACCESS_SHADER_WRITE_BIT,
+                    VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT |
+                    VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+                    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                    VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_INDEX_READ_BIT |
+                    VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT |
+                    VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT);
+
+    for_each(cmds_, execute);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_compute_encoder::dispatch(uint32_t x, uint32_t y, uint32_t z)
+{
+    prepare_dispatch_();
+
+    cmds_.push_back([=]() {
+        vkCmdDispatch(cmd_buffer_->command_buffer(), x, y, z);
     });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_compute_encoder::dispatch_indirect(Buffer* buffer, uint64_t offset)
+{
+    auto buffer_impl = static_cast<Vlk_buffer*>(buffer);
+
+    prepare_dispatch_();
 
     cmds_.push_back([=]() {
-        // configure a buffer image copy.
-        VkBufferImageCopy copy {};
-
-        copy.imageSubresource.aspectMask = dst_image_impl->aspect_mask();
-        copy.imageSubresource.mipLevel = region.image_subresource.mip_level;
-        copy.imageSubresource.baseArrayLayer = region.image_subresource.array_layer;
-        copy.imageSubresource.layerCount = 1;
-        copy.imageOffset.x = region.image_offset.x;
-        copy.imageOffset.y = region.image_offset.y;
-        copy.imageOffset.z = region.image_offset.z;
-        copy.imageExtent.width = region.image_extent.w;
-        copy.imageExtent.height = region.image_extent.h;
-        copy.imageExtent.depth = region.image_extent.d;
-
-        // record a copy command.
-        vkCmdCopyBufferToImage(cmd_buffer_->command_buffer(),
-                               src_buffer_impl->buffer(),
-                               dst_image_impl->image(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                               1, &copy);
+        vkCmdDispatchIndirect(cmd_buffer_->command_buffer(), buffer_impl->buffer(), offset);
     });
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Vlk_blit_encoder::copy(Image* src_image, Buffer* dst_buffer, const Buffer_image_copy_region& region)
+void Vlk_compute_encoder::shader_buffer(Buffer* buffer, uint32_t offset, uint32_t index)
 {
-    auto src_image_impl = static_cast<Vlk_image*>(src_image);
-    auto dst_buffer_impl = static_cast<Vlk_buffer*>(dst_buffer);
+    arg_buffer_(static_cast<Vlk_buffer*>(buffer), offset, 0, index);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_compute_encoder::shader_texture(Image* image, Sampler* sampler, uint32_t index)
+{
+    arg_image_(static_cast<Vlk_image*>(image), static_cast<Vlk_sampler*>(sampler),
+               VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_ACCESS_SHADER_READ_BIT, 1, index);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_compute_encoder::storage_buffer(Buffer* buffer, uint32_t offset, uint32_t index)
+{
+    arg_buffer_(static_cast<Vlk_buffer*>(buffer), offset, 2, index);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_compute_encoder::storage_image(Image* image, uint32_t index)
+{
+    if (!image->storage())
+        throw runtime_error("fail to bind a storage image");
+
+    arg_image_(static_cast<Vlk_image*>(image), nullptr,
+               VK_IMAGE_LAYOUT_GENERAL, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT, 3, index);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_compute_encoder::pipeline(Pipeline* pipeline)
+{
+    auto pipeline_impl = static_cast<Vlk_pipeline*>(pipeline);
+
+    if (pipeline_impl == pipeline_)
+        return;
+
+    cmds_.push_back([=]() {
+        vkCmdBindPipeline(cmd_buffer_->command_buffer(),
+                          VK_PIPELINE_BIND_POINT_COMPUTE, pipeline_impl->pipeline());
+    });
+
+    // desc sets are allocated from set layouts of a pipeline.
+    for (auto i = 0; i != 4; ++i)
+        arg_table_[i].dirty_flags |= 0x1;
+
+    // update a pipeline.
+    pipeline_ = pipeline_impl;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Cmd_buffer* Vlk_compute_encoder::cmd_buffer() const
+{
+    return cmd_buffer_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
 
+void Vlk_compute_encoder::arg_buffer_(Vlk_buffer* buffer, uint32_t offset, uint32_t set, uint32_t index)
+{
+    auto& args = arg_table_[set];
+
+    if (buffer != args[index].buffer) {
+        args.dirty_flags |= 0x1;
+        args[index].buffer = buffer;
+    }
+
+    // an offset is a dynamic offset, it doesn't require to update a desc set.
+    args[index].offset = offset;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_compute_encoder::arg_image_(Vlk_image* image, Vlk_sampler* sampler, VkImageLayout layout,
+                                     VkAccessFlags access_mask, uint32_t set, uint32_t index)
+{
     cmds_.push_back([=]() {
-        if (VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL == src_image_impl->layout())
+        if (layout == image->layout() && access_mask == image->access_mask())
             return;
 
         // configure an image barrier.
         VkImageMemoryBarrier barrier {};
 
         barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        barrier.srcAccessMask = src_image_impl->access_mask();
-        barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-        barrier.oldLayout = src_image_impl->layout();
-        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        barrier.srcAccessMask = image->access_mask();
+        barrier.dstAccessMask = access_mask;
+        barrier.oldLayout = image->layout();
+        barrier.newLayout = layout;
         barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
         barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.image = src_image_impl->image();
-        barrier.subresourceRange.aspectMask = src_image_impl->aspect_mask();
-        barrier.subresourceRange.levelCount = src_image_impl->mip_levels();
-        barrier.subresourceRange.layerCount = src_image_impl->array_layers();
+        barrier.image = image->image();
+        barrier.subresourceRange.aspectMask = image->aspect_mask();
+        barrier.subresourceRange.levelCount = image->mip_levels();
+        barrier.subresourceRange.layerCount = image->array_layers();
 
         // update image meta data.
-        src_image_impl->access_mask_ = VK_ACCESS_TRANSFER_READ_BIT;
-        src_image_impl->layout_ = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        image->access_mask_ = access_mask;
+        image->layout_ = layout;
 
         // record barrier command.
         vkCmdPipelineBarrier(cmd_buffer_->command_buffer(),
-                             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-                             VK_DEPENDENCY_BY_REGION_BIT,
+                             VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT |
+                             VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0,
                              0, nullptr,
                              0, nullptr,
                              1, &barrier);
     });
 
+    auto& args = arg_table_[set];
+
+    if (image != args[index].image) {
+        args.dirty_flags |= 0x1;
+        args[index].image = image;
+    }
+
+    if (sampler != args[index].sampler) {
+        args.dirty_flags |= 0x2;
+        args[index].sampler = sampler;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_compute_encoder::memory_barrier_(VkPipelineStageFlags src_stage_mask, VkAccessFlags src_access_mask,
+                                          VkPipelineStageFlags dst_stage_mask, VkAccessFlags dst_access_mask)
+{
     cmds_.push_back([=]() {
-        // configure a buffer image copy.
-        VkBufferImageCopy copy {};
-
-        copy.bufferOffset = region.buffer_offset;
-        copy.bufferRowLength = region.buffer_row_size;
-        copy.bufferImageHeight = region.buffer_image_height;
-        copy.imageSubresource.aspectMask = src_image_impl->aspect_mask();
-        copy.imageSubresource.mipLevel = region.image_subresource.mip_level;
-        copy.imageSubresource.baseArrayLayer = region.image_subresource.array_layer;
-        copy.imageSubresource.layerCount = 1;
-        copy.imageOffset.x = region.image_offset.x;
-        copy.imageOffset.y = region.image_offset.y;
-        copy.imageOffset.z = region.image_offset.z;
-        copy.imageExtent.width = region.image_extent.w;
-        copy.imageExtent.height = region.image_extent.h;
-        copy.imageExtent.depth = region.image_extent.d;
-
-        // record a copy command.
-        vkCmdCopyImageToBuffer(cmd_buffer_->command_buffer(),
-                               src_image_impl->image(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                               dst_buffer_impl->buffer(),
-                               1, &copy);
+        // configure a memory barrier.
+        VkMemoryBarrier barrier {};
+
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = src_access_mask;
+        barrier.dstAccessMask = dst_access_mask;
+
+        // record barrier command.
+        vkCmdPipelineBarrier(cmd_buffer_->command_buffer(),
+                             src_stage_mask, dst_stage_mask,
+                             0,
+                             1, &barrier,
+                             0, nullptr,
+                             0, nullptr);
     });
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Vlk_blit_encoder::end()
+void Vlk_compute_encoder::update_desc_sets_()
 {
-    for_each(cmds_, execute);
+    constexpr array<VkImageLayout, 4> image_layouts {
+        VK_IMAGE_LAYOUT_UNDEFINED,
+        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        VK_IMAGE_LAYOUT_UNDEFINED,
+        VK_IMAGE_LAYOUT_GENERAL
+    };
+
+    for (auto i = 0; i != 4; ++i) {
+        auto& args = arg_table_[i];
+
+        if (!args.dirty_flags)
+            continue;
+
+        args.dirty_flags = 0;
+
+        auto set_layout = pipeline_->set_layout(i);
+
+        if (!set_layout || set_layout->empty()) {
+            args.desc_set = VK_NULL_HANDLE;
+            continue;
+        }
+
+        args.desc_set = cmd_buffer_->desc_allocator().allocate(set_layout);
+
+        Vlk_desc_info_array infos {};
+
+        for (auto j = 0; j != args.size(); ++j) {
+            auto& arg = args[j];
+
+            if (arg.buffer) {
+                infos[j].buffer = {arg.buffer->buffer(), 0, pipeline_->buffer_range(j)};
+            }
+            else if (arg.image) {
+                auto sampler = arg.sampler ? arg.sampler->sampler() : VK_NULL_HANDLE;
+
+                infos[j].image = {sampler, arg.image->image_view(), image_layouts[i]};
+            }
+        }
+
+        set_layout->update(args.desc_set, infos);
+    }
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-Cmd_buffer* Vlk_blit_encoder::cmd_buffer() const
+void Vlk_compute_encoder::bind_desc_sets_()
 {
-    return cmd_buffer_;
+    auto pipeline_layout = pipeline_->pipeline_layout();
+
+    for (auto i = 0; i != 4; ++i) {
+        auto& args = arg_table_[i];
+
+        if (!args.desc_set)
+            continue;
+
+        vector<uint32_t> offsets(args.size());
+
+        offsets.resize(to_dynamic_offsets(pipeline_->set_layout(i), args, offsets.data()));
+
+        auto desc_set = args.desc_set;
+
+        cmds_.push_back([=]() {
+            vkCmdBindDescriptorSets(cmd_buffer_->command_buffer(),
+                                    VK_PIPELINE_BIND_POINT_COMPUTE, pipeline_layout,
+                                    i,
+                                    1, &desc_set,
+                                    static_cast<uint32_t>(offsets.size()), offsets.data());
+        });
+    }
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-Vlk_cmd_buffer::Vlk_cmd_buffer(Vlk_device* device) :
+void Vlk_compute_encoder::prepare_dispatch_()
+{
+    // dispatches are serialized, a dispatch can read writes of a previous dispatch.
+    if (dispatched_) {
+        memory_barrier_(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                        VK_ACCESS_SHADER_WRITE_BIT,
+                        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                        VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+    }
+
+    update_desc_sets_();
+    bind_desc_sets_();
+
+    dispatched_ = true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Vlk_cmd_buffer::Vlk_cmd_buffer(const Cmd_buffer_desc& desc, Vlk_device* device) :
     device_ {device},
-    command_buffer_ {VK_NULL_HANDLE}
+    queue_type_ {desc.queue_type},
+    command_pool_ {VK_NULL_HANDLE},
+    command_buffer_ {VK_NULL_HANDLE},
+    arena_ {},
+    desc_allocator_ {device},
+    secondaries_ {},
+    secondary_count_ {0},
+    acquire_buffer_barriers_ {},
+    acquire_image_barriers_ {}
 {
+    init_command_pool_();
     init_command_buffer_();
     begin_command_buffer_();
 }
@@ -787,21 +1240,46 @@ Vlk_cmd_buffer::Vlk_cmd_buffer(Vlk_device* device) :
 
 Vlk_cmd_buffer::~Vlk_cmd_buffer()
 {
+    fini_secondaries_();
     fini_command_buffer_();
+    fini_command_pool_();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
 std::unique_ptr<Render_encoder> Vlk_cmd_buffer::create(const Render_encoder_desc& desc)
 {
+    if (Queue_type::graphics != queue_type_)
+        throw runtime_error("fail to create a render encoder");
+
     return make_unique<Vlk_render_encoder>(desc, device_, this);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
+std::unique_ptr<Parallel_render_encoder> Vlk_cmd_buffer::create(const Parallel_render_encoder_desc& desc)
+{
+    if (Queue_type::graphics != queue_type_)
+        throw runtime_error("fail to create a parallel render encoder");
+
+    return make_unique<Vlk_parallel_render_encoder>(desc, device_, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 std::unique_ptr<Blit_encoder> Vlk_cmd_buffer::create(const Blit_encoder_desc& desc)
 {
-    return make_unique<Vlk_blit_encoder>(desc, this);
+    return make_unique<Vlk_blit_encoder>(desc, device_, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Compute_encoder> Vlk_cmd_buffer::create(const Compute_encoder_desc& desc)
+{
+    if (Queue_type::graphics != queue_type_)
+        throw runtime_error("fail to create a compute encoder");
+
+    return make_unique<Vlk_compute_encoder>(desc, device_, this);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -815,8 +1293,25 @@ void Vlk_cmd_buffer::end()
 
 void Vlk_cmd_buffer::reset()
 {
-    vkResetCommandBuffer(command_buffer_, 0);
+    acquire_buffer_barriers_.clear();
+    acquire_image_barriers_.clear();
+
+    // a pool is owned by a command buffer, so resetting a pool releases its memory at once.
+    vkResetCommandPool(device_->device(), command_pool_, 0);
     begin_command_buffer_();
+
+    // recorded commands are executed, so the arena memory and desc sets can be reused.
+    arena_.reset();
+    desc_allocator_.reset();
+
+    // secondaries are kept and handed out again after their pools are reset.
+    for (auto i = 0; i != secondary_count_; ++i) {
+        vkResetCommandPool(device_->device(), secondaries_[i].command_pool, 0);
+        secondaries_[i].arena.reset();
+        secondaries_[i].desc_allocator.reset();
+    }
+
+    secondary_count_ = 0;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -828,13 +1323,54 @@ Device* Vlk_cmd_buffer::device() const
 
 //----------------------------------------------------------------------------------------------------------------------
 
+Vlk_secondary& Vlk_cmd_buffer::secondary()
+{
+    if (secondary_count_ == secondaries_.size())
+        init_secondary_();
+
+    return secondaries_[secondary_count_++];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_cmd_buffer::add_acquire_barrier(const VkBufferMemoryBarrier& barrier)
+{
+    acquire_buffer_barriers_.push_back(barrier);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_cmd_buffer::add_acquire_barrier(const VkImageMemoryBarrier& barrier)
+{
+    acquire_image_barriers_.push_back(barrier);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_cmd_buffer::init_command_pool_()
+{
+    // configure the command pool create info.
+    VkCommandPoolCreateInfo create_info {};
+
+    create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    create_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    create_info.queueFamilyIndex = (Queue_type::transfer == queue_type_) ?
+                                   device_->transfer_queue_family_index() : device_->queue_family_index();
+
+    // try to create a command pool, a pool per command buffer allows recording without synchronization.
+    if (vkCreateCommandPool(device_->device(), &create_info, nullptr, &command_pool_))
+        throw runtime_error("fail to create a cmd buffer");
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 void Vlk_cmd_buffer::init_command_buffer_()
 {
     // configure a command buffer allocate info.
     VkCommandBufferAllocateInfo allocateInfo {};
 
     allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocateInfo.commandPool = device_->command_pool();
+    allocateInfo.commandPool = command_pool_;
     allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
     allocateInfo.commandBufferCount = 1;
 
@@ -845,9 +1381,64 @@ void Vlk_cmd_buffer::init_command_buffer_()
 
 //----------------------------------------------------------------------------------------------------------------------
 
+void Vlk_cmd_buffer::init_secondary_()
+{
+    VkCommandPool command_pool {VK_NULL_HANDLE};
+    VkCommandBuffer command_buffer {VK_NULL_HANDLE};
+
+    // configure the command pool create info.
+    VkCommandPoolCreateInfo create_info {};
+
+    create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    create_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    create_info.queueFamilyIndex = device_->queue_family_index();
+
+    // try to create a command pool, each secondary is recorded on its own thread.
+    if (vkCreateCommandPool(device_->device(), &create_info, nullptr, &command_pool))
+        throw runtime_error("fail to create a cmd buffer");
+
+    // configure a command buffer allocate info.
+    VkCommandBufferAllocateInfo allocate_info {};
+
+    allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocate_info.commandPool = command_pool;
+    allocate_info.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+    allocate_info.commandBufferCount = 1;
+
+    // try to create a command buffer.
+    if (vkAllocateCommandBuffers(device_->device(), &allocate_info, &command_buffer)) {
+        vkDestroyCommandPool(device_->device(), command_pool, nullptr);
+        throw runtime_error("fail to create a cmd buffer");
+    }
+
+    // a deque keeps references to secondaries valid while encoders record into them.
+    auto& secondary = secondaries_.emplace_back(device_);
+
+    secondary.command_pool = command_pool;
+    secondary.command_buffer = command_buffer;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_cmd_buffer::fini_command_pool_()
+{
+    vkDestroyCommandPool(device_->device(), command_pool_, nullptr);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 void Vlk_cmd_buffer::fini_command_buffer_()
 {
-    vkFreeCommandBuffers(device_->device(), device_->command_pool(), 1, &command_buffer_);
+    vkFreeCommandBuffers(device_->device(), command_pool_, 1, &command_buffer_);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_cmd_buffer::fini_secondaries_()
+{
+    // destroying a pool frees its command buffers.
+    for (auto& secondary : secondaries_)
+        vkDestroyCommandPool(device_->device(), secondary.command_pool, nullptr);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -6,12 +6,16 @@
 #ifndef GFX_VLK_CMD_BUFFER_GUARD
 #define GFX_VLK_CMD_BUFFER_GUARD
 
-#include <map>
 #include <unordered_map>
 #include <deque>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include <vulkan/vulkan.h>
 #include "Cmd_buffer.h"
+#include "Vlk_cmd_list.h"
+#include "Vlk_desc_allocator.h"
 
 namespace Gfx_lib {
 
@@ -22,9 +26,11 @@ class Vlk_buffer;
 class Vlk_image;
 class Vlk_sampler;
 class Vlk_pipeline;
+class Vlk_set_layout;
 class Vlk_cmd_buffer;
 class Vlk_render_pass;
 class Vlk_framebuffer;
+struct Vlk_secondary;
 
 //----------------------------------------------------------------------------------------------------------------------
 
@@ -61,6 +67,7 @@ template<typename T>
 class Vlk_arg_array : public std::array<T, 16> {
 public:
     VkDescriptorSet desc_set {VK_NULL_HANDLE};
+    Vlk_set_layout* set_layout {nullptr};
     uint32_t dirty_flags {0};
 };
 
@@ -86,20 +93,30 @@ public:
     { return args_[index]; }
 
 private:
-    std::array<Vlk_arg_array<Vlk_arg>, 2> args_;
+    std::array<Vlk_arg_array<Vlk_arg>, 4> args_;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
 
 class Vlk_render_encoder final : public Render_encoder {
 public:
-    Vlk_render_encoder(const Render_encoder_desc& desc, Vlk_device* device, Vlk_cmd_buffer* cmd_buffer);
+    Vlk_render_encoder(const Render_encoder_desc& desc, Vlk_device* device, Vlk_cmd_buffer* cmd_buffer,
+                       VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);
+
+    Vlk_render_encoder(Vlk_render_encoder* primary_encoder, Vlk_secondary& secondary);
 
     void end() override;
 
-    void draw(uint32_t count, uint32_t first = 0) override;
+    void draw(uint32_t count, uint32_t first = 0, uint32_t instance_count = 1, uint32_t first_instance = 0) override;
+
+    void draw_indexed(uint32_t count, uint32_t first = 0, uint32_t instance_count = 1,
+                      uint32_t first_instance = 0, int32_t base_vertex = 0) override;
+
+    void draw_indirect(Buffer* buffer, uint64_t offset, uint32_t draw_count = 1,
+                       uint32_t stride = sizeof(Draw_indirect_args)) override;
 
-    void draw_indexed(uint32_t count, uint32_t first = 0) override;
+    void draw_indexed_indirect(Buffer* buffer, uint64_t offset, uint32_t draw_count = 1,
+                               uint32_t stride = sizeof(Draw_indexed_indirect_args)) override;
 
     void vertex_buffer(Buffer* buffer, uint64_t offset, uint32_t index) override;
 
@@ -109,6 +126,11 @@ public:
 
     void shader_texture(Image* image, Sampler* sampler, uint32_t index) override;
 
+    void shader_bytes(Pipeline_stage stage, uint32_t offset, const void* data, uint32_t size) override;
+
+    void bind_group(uint32_t index, Bind_group* bind_group,
+                    const std::vector<uint32_t>& dynamic_offsets = {}) override;
+
     void pipeline(Pipeline* pipeline) override;
 
     void viewport(const Viewport& viewport) override;
@@ -122,29 +144,62 @@ private:
 
     void end_render_pass_();
 
+    void begin_secondary_();
+
     void update_desc_sets_();
 
     void bind_desc_sets_();
 
+    void bind_push_constants_();
+
 private:
     Vlk_device* device_;
     Vlk_cmd_buffer* cmd_buffer_;
-    std::map<uint32_t, std::deque<std::function<void ()>>> cmds_;
+    Vlk_render_encoder* primary_encoder_;
+    VkCommandBuffer command_buffer_;
+    VkSubpassContents contents_;
+    Vlk_cmd_arena* arena_;
+    Vlk_desc_allocator* desc_allocator_;
+    std::array<Vlk_cmd_list, 4> cmds_;
     std::array<Vlk_vertex_stream, 2> vertex_streams_;
     Vlk_index_stream index_stream_;
     Vlk_arg_table arg_table_;
+    std::array<uint8_t, max_push_constant_size> push_constants_;
+    bool push_constants_dirty_;
     Vlk_pipeline* pipeline_;
     Vlk_render_pass* render_pass_;
     Vlk_framebuffer* framebuffer_;
     Viewport viewport_;
     Scissor scissor_;
+
+    friend class Vlk_parallel_render_encoder;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Vlk_parallel_render_encoder final : public Parallel_render_encoder {
+public:
+    Vlk_parallel_render_encoder(const Parallel_render_encoder_desc& desc,
+                                Vlk_device* device, Vlk_cmd_buffer* cmd_buffer);
+
+    Render_encoder* render_encoder() override;
+
+    void end() override;
+
+    Cmd_buffer* cmd_buffer() const override;
+
+private:
+    Vlk_cmd_buffer* cmd_buffer_;
+    Vlk_render_encoder encoder_;
+    std::vector<std::unique_ptr<Vlk_render_encoder>> encoders_;
+    std::mutex mutex_;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
 
 class Vlk_blit_encoder final : public Blit_encoder {
 public:
-    Vlk_blit_encoder(const Blit_encoder_desc& desc, Vlk_cmd_buffer* cmd_buffer);
+    Vlk_blit_encoder(const Blit_encoder_desc& desc, Vlk_device* device, Vlk_cmd_buffer* cmd_buffer);
 
     void copy(Buffer* src_buffer, Buffer* dst_buffer, const Buffer_copy_region& region) override;
 
@@ -157,41 +212,154 @@ public:
     Cmd_buffer* cmd_buffer() const override;
 
 private:
+    void release_ownerships_();
+
+private:
+    Vlk_device* device_;
+    Vlk_cmd_buffer* cmd_buffer_;
+    Vlk_cmd_arena* arena_;
+    Vlk_cmd_list cmds_;
+    std::vector<Vlk_buffer*> dst_buffers_;
+    std::vector<Vlk_image*> dst_images_;
+    bool releasable_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Vlk_compute_encoder final : public Compute_encoder {
+public:
+    Vlk_compute_encoder(const Compute_encoder_desc& desc, Vlk_device* device, Vlk_cmd_buffer* cmd_buffer);
+
+    void end() override;
+
+    void dispatch(uint32_t x, uint32_t y = 1, uint32_t z = 1) override;
+
+    void dispatch_indirect(Buffer* buffer, uint64_t offset = 0) override;
+
+    void shader_buffer(Buffer* buffer, uint32_t offset, uint32_t index) override;
+
+    void shader_texture(Image* image, Sampler* sampler, uint32_t index) override;
+
+    void storage_buffer(Buffer* buffer, uint32_t offset, uint32_t index) override;
+
+    void storage_image(Image* image, uint32_t index) override;
+
+    void pipeline(Pipeline* pipeline) override;
+
+    Cmd_buffer* cmd_buffer() const override;
+
+private:
+    void arg_buffer_(Vlk_buffer* buffer, uint32_t offset, uint32_t set, uint32_t index);
+
+    void arg_image_(Vlk_image* image, Vlk_sampler* sampler, VkImageLayout layout, VkAccessFlags access_mask,
+                    uint32_t set, uint32_t index);
+
+    void memory_barrier_(VkPipelineStageFlags src_stage_mask, VkAccessFlags src_access_mask,
+                         VkPipelineStageFlags dst_stage_mask, VkAccessFlags dst_access_mask);
+
+    void update_desc_sets_();
+
+    void bind_desc_sets_();
+
+    void prepare_dispatch_();
+
+private:
+    Vlk_device* device_;
     Vlk_cmd_buffer* cmd_buffer_;
     std::deque<std::function<void ()>> cmds_;
+    Vlk_arg_table arg_table_;
+    Vlk_pipeline* pipeline_;
+    bool dispatched_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Vlk_secondary final {
+    explicit Vlk_secondary(Vlk_device* device) :
+        command_pool {VK_NULL_HANDLE}, command_buffer {VK_NULL_HANDLE}, arena {}, desc_allocator {device}
+    {}
+
+    VkCommandPool command_pool;
+    VkCommandBuffer command_buffer;
+    Vlk_cmd_arena arena;
+    Vlk_desc_allocator desc_allocator;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
 
 class Vlk_cmd_buffer final : public Cmd_buffer {
 public:
-    Vlk_cmd_buffer(Vlk_device* device);
+    Vlk_cmd_buffer(const Cmd_buffer_desc& desc, Vlk_device* device);
 
     ~Vlk_cmd_buffer() override;
 
     std::unique_ptr<Render_encoder> create(const Render_encoder_desc& desc) override;
 
+    std::unique_ptr<Parallel_render_encoder> create(const Parallel_render_encoder_desc& desc) override;
+
     std::unique_ptr<Blit_encoder> create(const Blit_encoder_desc& desc) override;
 
+    std::unique_ptr<Compute_encoder> create(const Compute_encoder_desc& desc) override;
+
     void end() override;
 
     void reset() override;
 
     Device* device() const override;
 
+    Vlk_secondary& secondary();
+
+    inline auto& arena() noexcept
+    { return arena_; }
+
+    inline auto& desc_allocator() noexcept
+    { return desc_allocator_; }
+
     inline auto& command_buffer() const noexcept
     { return command_buffer_; }
 
+    inline auto queue_type() const noexcept
+    { return queue_type_; }
+
+    inline auto has_acquire_barriers() const noexcept
+    { return !acquire_buffer_barriers_.empty() || !acquire_image_barriers_.empty(); }
+
+    inline auto& acquire_buffer_barriers() const noexcept
+    { return acquire_buffer_barriers_; }
+
+    inline auto& acquire_image_barriers() const noexcept
+    { return acquire_image_barriers_; }
+
+    void add_acquire_barrier(const VkBufferMemoryBarrier& barrier);
+
+    void add_acquire_barrier(const VkImageMemoryBarrier& barrier);
+
 private:
+    void init_command_pool_();
+
     void init_command_buffer_();
 
+    void init_secondary_();
+
+    void fini_command_pool_();
+
     void fini_command_buffer_();
 
+    void fini_secondaries_();
+
     void begin_command_buffer_();
 
 private:
     Vlk_device* device_;
+    Queue_type queue_type_;
+    VkCommandPool command_pool_;
     VkCommandBuffer command_buffer_;
+    Vlk_cmd_arena arena_;
+    Vlk_desc_allocator desc_allocator_;
+    std::deque<Vlk_secondary> secondaries_;
+    uint32_t secondary_count_;
+    std::vector<VkBufferMemoryBarrier> acquire_buffer_barriers_;
+    std::vector<VkImageMemoryBarrier> acquire_image_barriers_;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,372 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "std_lib.h"
+#include "Vlk_cmd_list.h"
+#include "Vlk_image.h"
+
+using namespace std;
+
+namespace Gfx_lib {
+
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+inline auto& to_cmd(const Vlk_cmd_node* node) noexcept
+{
+    return reinterpret_cast<const Vlk_cmd_packet<T>*>(node)->cmd;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline auto to_image_barrier(Vlk_image* image, VkAccessFlags src_access_mask, VkAccessFlags dst_access_mask,
+                             VkImageLayout layout)
+{
+    VkImageMemoryBarrier barrier {};
+
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = src_access_mask;
+    barrier.dstAccessMask = dst_access_mask;
+    barrier.oldLayout = image->layout();
+    barrier.newLayout = layout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image->image();
+    barrier.subresourceRange.aspectMask = image->aspect_mask();
+    barrier.subresourceRange.levelCount = image->mip_levels();
+    barrier.subresourceRange.layerCount = image->array_layers();
+
+    return barrier;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Vlk_cmd_arena::Vlk_cmd_arena(size_t block_size) :
+    block_size_ {block_size},
+    blocks_ {},
+    block_index_ {0},
+    offset_ {0}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void* Vlk_cmd_arena::allocate(size_t size, size_t alignment)
+{
+    // blocks are kept over resets, so the steady state doesn't allocate from the heap.
+    for (; block_index_ != blocks_.size(); ++block_index_, offset_ = 0) {
+        auto& block = blocks_[block_index_];
+        auto base = reinterpret_cast<uintptr_t>(block.data.get());
+        auto address = (base + offset_ + alignment - 1) & ~(alignment - 1);
+
+        if (address + size <= base + block.size) {
+            offset_ = address + size - base;
+
+            return reinterpret_cast<void*>(address);
+        }
+    }
+
+    auto block_size = max(block_size_, size + alignment);
+
+    blocks_.push_back({make_unique<uint8_t[]>(block_size), block_size});
+    offset_ = 0;
+
+    return allocate(size, alignment);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_cmd_arena::reset() noexcept
+{
+    block_index_ = 0;
+    offset_ = 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Vlk_cmd_list::Vlk_cmd_list() noexcept :
+    head_ {nullptr},
+    tail_ {nullptr}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_cmd_list::splice(Vlk_cmd_list& list) noexcept
+{
+    if (list.empty())
+        return;
+
+    if (tail_)
+        tail_->next = list.head_;
+    else
+        head_ = list.head_;
+
+    tail_ = list.tail_;
+    list.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_cmd_list::execute(VkCommandBuffer command_buffer) const
+{
+    for (auto node = head_; node; node = node->next) {
+        switch (node->type) {
+            case Vlk_cmd_type::begin_render_pass_barrier: {
+                auto& cmd = to_cmd<Vlk_cmd_begin_render_pass_barrier>(node);
+                array<VkImageMemoryBarrier, max_color_attachments + 1> barriers;
+                uint32_t barrier_count = 0;
+
+                for (auto image : cmd.colors) {
+                    if (!image || VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL == image->layout())
+                        continue;
+
+                    barriers[barrier_count++] = to_image_barrier(image, 0, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                                                                 VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+
+                    // update image meta data.
+                    image->access_mask_ = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+                    image->layout_ = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+                }
+
+                if (auto image = cmd.depth_stencil;
+                    image && VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL != image->layout()) {
+                    barriers[barrier_count++] = to_image_barrier(image, 0,
+                                                                 VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                                                                 VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+
+                    // update image meta data.
+                    image->access_mask_ = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+                    image->layout_ = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+                }
+
+                if (!barrier_count)
+                    break;
+
+                vkCmdPipelineBarrier(command_buffer,
+                                     VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                     VK_DEPENDENCY_BY_REGION_BIT,
+                                     0, nullptr,
+                                     0, nullptr,
+                                     barrier_count, &barriers[0]);
+                break;
+            }
+            case Vlk_cmd_type::shader_read_barrier: {
+                auto image = to_cmd<Vlk_cmd_shader_read_barrier>(node).image;
+
+                if (VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL == image->layout())
+                    break;
+
+                auto barrier = to_image_barrier(image, image->access_mask(), VK_ACCESS_SHADER_READ_BIT,
+                                                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+                // update image meta data.
+                image->access_mask_ = VK_ACCESS_SHADER_READ_BIT;
+                image->layout_ = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+                vkCmdPipelineBarrier(command_buffer,
+                                     VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                     VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                                     VK_DEPENDENCY_BY_REGION_BIT,
+                                     0, nullptr,
+                                     0, nullptr,
+                                     1, &barrier);
+                break;
+            }
+            case Vlk_cmd_type::transfer_dst_barrier: {
+                auto image = to_cmd<Vlk_cmd_transfer_dst_barrier>(node).image;
+
+                if (VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL == image->layout())
+                    break;
+
+                auto barrier = to_image_barrier(image, 0, VK_ACCESS_TRANSFER_WRITE_BIT,
+                                                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+                // update image meta data.
+                image->access_mask_ = VK_ACCESS_TRANSFER_WRITE_BIT;
+                image->layout_ = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+
+                vkCmdPipelineBarrier(command_buffer,
+                                     VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                     VK_DEPENDENCY_BY_REGION_BIT,
+                                     0, nullptr,
+                                     0, nullptr,
+                                     1, &barrier);
+                break;
+            }
+            case Vlk_cmd_type::transfer_src_barrier: {
+                auto image = to_cmd<Vlk_cmd_transfer_src_barrier>(node).image;
+
+                if (VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL == image->layout())
+                    break;
+
+                auto barrier = to_image_barrier(image, image->access_mask(), VK_ACCESS_TRANSFER_READ_BIT,
+                                                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+
+                // update image meta data.
+                image->access_mask_ = VK_ACCESS_TRANSFER_READ_BIT;
+                image->layout_ = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+                vkCmdPipelineBarrier(command_buffer,
+                                     VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                                     VK_DEPENDENCY_BY_REGION_BIT,
+                                     0, nullptr,
+                                     0, nullptr,
+                                     1, &barrier);
+                break;
+            }
+            case Vlk_cmd_type::begin_render_pass: {
+                auto& cmd = to_cmd<Vlk_cmd_begin_render_pass>(node);
+
+                // configure a render pass begin info.
+                VkRenderPassBeginInfo begin_info {};
+
+                begin_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+                begin_info.renderPass = cmd.render_pass;
+                begin_info.framebuffer = cmd.framebuffer;
+                begin_info.renderArea.extent = cmd.extent;
+                begin_info.clearValueCount = cmd.clear_value_count;
+                begin_info.pClearValues = &cmd.clear_values[0];
+
+                vkCmdBeginRenderPass(command_buffer, &begin_info, cmd.contents);
+                break;
+            }
+            case Vlk_cmd_type::end_render_pass:
+                vkCmdEndRenderPass(command_buffer);
+                break;
+            case Vlk_cmd_type::bind_pipeline: {
+                auto& cmd = to_cmd<Vlk_cmd_bind_pipeline>(node);
+
+                vkCmdBindPipeline(command_buffer, cmd.bind_point, cmd.pipeline);
+                break;
+            }
+            case Vlk_cmd_type::bind_vertex_buffer: {
+                auto& cmd = to_cmd<Vlk_cmd_bind_vertex_buffer>(node);
+
+                vkCmdBindVertexBuffers(command_buffer, cmd.binding, 1, &cmd.buffer, &cmd.offset);
+                break;
+            }
+            case Vlk_cmd_type::bind_index_buffer: {
+                auto& cmd = to_cmd<Vlk_cmd_bind_index_buffer>(node);
+
+                vkCmdBindIndexBuffer(command_buffer, cmd.buffer, cmd.offset, cmd.index_type);
+                break;
+            }
+            case Vlk_cmd_type::bind_desc_sets: {
+                auto& cmd = to_cmd<Vlk_cmd_bind_desc_sets>(node);
+
+                vkCmdBindDescriptorSets(command_buffer,
+                                        cmd.bind_point, cmd.pipeline_layout,
+                                        cmd.first_set,
+                                        cmd.desc_set_count, cmd.desc_sets,
+                                        cmd.offset_count, cmd.offsets);
+                break;
+            }
+            case Vlk_cmd_type::push_desc_set: {
+                auto& cmd = to_cmd<Vlk_cmd_push_desc_set>(node);
+
+                cmd.set_layout->push(command_buffer, cmd.bind_point, cmd.pipeline_layout, cmd.set, *cmd.infos);
+                break;
+            }
+            case Vlk_cmd_type::push_constants: {
+                auto& cmd = to_cmd<Vlk_cmd_push_constants>(node);
+
+                vkCmdPushConstants(command_buffer, cmd.pipeline_layout, cmd.stage_flags, 0, cmd.size, cmd.values);
+                break;
+            }
+            case Vlk_cmd_type::set_viewport:
+                vkCmdSetViewport(command_buffer, 0, 1, &to_cmd<Vlk_cmd_set_viewport>(node).viewport);
+                break;
+            case Vlk_cmd_type::set_scissor:
+                vkCmdSetScissor(command_buffer, 0, 1, &to_cmd<Vlk_cmd_set_scissor>(node).scissor);
+                break;
+            case Vlk_cmd_type::draw: {
+                auto& cmd = to_cmd<Vlk_cmd_draw>(node);
+
+                vkCmdDraw(command_buffer, cmd.count, cmd.instance_count, cmd.first, cmd.first_instance);
+                break;
+            }
+            case Vlk_cmd_type::draw_indexed: {
+                auto& cmd = to_cmd<Vlk_cmd_draw_indexed>(node);
+
+                vkCmdDrawIndexed(command_buffer,
+                                 cmd.count, cmd.instance_count, cmd.first, cmd.base_vertex, cmd.first_instance);
+                break;
+            }
+            case Vlk_cmd_type::draw_indirect: {
+                auto& cmd = to_cmd<Vlk_cmd_draw_indirect>(node);
+
+                vkCmdDrawIndirect(command_buffer, cmd.buffer, cmd.offset, cmd.draw_count, cmd.stride);
+                break;
+            }
+            case Vlk_cmd_type::draw_indexed_indirect: {
+                auto& cmd = to_cmd<Vlk_cmd_draw_indexed_indirect>(node);
+
+                vkCmdDrawIndexedIndirect(command_buffer, cmd.buffer, cmd.offset, cmd.draw_count, cmd.stride);
+                break;
+            }
+            case Vlk_cmd_type::execute_commands: {
+                auto& cmd = to_cmd<Vlk_cmd_execute_commands>(node);
+
+                vkCmdExecuteCommands(command_buffer, cmd.command_buffer_count, cmd.command_buffers);
+                break;
+            }
+            case Vlk_cmd_type::copy_buffer: {
+                auto& cmd = to_cmd<Vlk_cmd_copy_buffer>(node);
+
+                vkCmdCopyBuffer(command_buffer, cmd.src_buffer, cmd.dst_buffer, 1, &cmd.region);
+                break;
+            }
+            case Vlk_cmd_type::copy_buffer_to_image: {
+                auto& cmd = to_cmd<Vlk_cmd_copy_buffer_to_image>(node);
+
+                vkCmdCopyBufferToImage(command_buffer,
+                                       cmd.src_buffer,
+                                       cmd.dst_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                       1, &cmd.region);
+                break;
+            }
+            case Vlk_cmd_type::copy_image_to_buffer: {
+                auto& cmd = to_cmd<Vlk_cmd_copy_image_to_buffer>(node);
+
+                vkCmdCopyImageToBuffer(command_buffer,
+                                       cmd.src_image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                       cmd.dst_buffer,
+                                       1, &cmd.region);
+                break;
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_cmd_list::clear() noexcept
+{
+    head_ = nullptr;
+    tail_ = nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_cmd_list::append_(Vlk_cmd_node* node) noexcept
+{
+    if (tail_)
+        tail_->next = node;
+    else
+        head_ = node;
+
+    tail_ = node;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
@@ -0,0 +1,347 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_VLK_CMD_LIST_GUARD
+#define GFX_VLK_CMD_LIST_GUARD
+
+#include <cstdint>
+#include <array>
+#include <memory>
+#include <new>
+#include <vector>
+#include <vulkan/vulkan.h>
+#include "gfx/limitations.h"
+#include "Vlk_set_layout.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Vlk_image;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Vlk_cmd_arena final {
+public:
+    explicit Vlk_cmd_arena(size_t block_size = 64 * 1024);
+
+    void* allocate(size_t size, size_t alignment);
+
+    void reset() noexcept;
+
+    template<typename T>
+    inline T* allocate(size_t count)
+    { return static_cast<T*>(allocate(sizeof(T) * count, alignof(T))); }
+
+private:
+    struct Block final {
+        std::unique_ptr<uint8_t[]> data;
+        size_t size;
+    };
+
+private:
+    size_t block_size_;
+    std::vector<Block> blocks_;
+    size_t block_index_;
+    size_t offset_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+enum class Vlk_cmd_type : uint32_t {
+    begin_render_pass_barrier = 0,
+    shader_read_barrier,
+    transfer_dst_barrier,
+    transfer_src_barrier,
+    begin_render_pass,
+    end_render_pass,
+    bind_pipeline,
+    bind_vertex_buffer,
+    bind_index_buffer,
+    bind_desc_sets,
+    push_desc_set,
+    push_constants,
+    set_viewport,
+    set_scissor,
+    draw,
+    draw_indexed,
+    draw_indirect,
+    draw_indexed_indirect,
+    execute_commands,
+    copy_buffer,
+    copy_buffer_to_image,
+    copy_image_to_buffer
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Vlk_cmd_begin_render_pass_barrier final {
+    static constexpr auto type = Vlk_cmd_type::begin_render_pass_barrier;
+
+    std::array<Vlk_image*, max_color_attachments> colors;
+    Vlk_image* depth_stencil;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Vlk_cmd_shader_read_barrier final {
+    static constexpr auto type = Vlk_cmd_type::shader_read_barrier;
+
+    Vlk_image* image;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Vlk_cmd_transfer_dst_barrier final {
+    static constexpr auto type = Vlk_cmd_type::transfer_dst_barrier;
+
+    Vlk_image* image;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Vlk_cmd_transfer_src_barrier final {
+    static constexpr auto type = Vlk_cmd_type::transfer_src_barrier;
+
+    Vlk_image* image;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Vlk_cmd_begin_render_pass final {
+    static constexpr auto type = Vlk_cmd_type::begin_render_pass;
+
+    VkRenderPass render_pass;
+    VkFramebuffer framebuffer;
+    VkExtent2D extent;
+    VkSubpassContents contents;
+    uint32_t clear_value_count;
+    std::array<VkClearValue, max_color_attachments + 1> clear_values;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Vlk_cmd_end_render_pass final {
+    static constexpr auto type = Vlk_cmd_type::end_render_pass;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Vlk_cmd_bind_pipeline final {
+    static constexpr auto type = Vlk_cmd_type::bind_pipeline;
+
+    VkPipelineBindPoint bind_point;
+    VkPipeline pipeline;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Vlk_cmd_bind_vertex_buffer final {
+    static constexpr auto type = Vlk_cmd_type::bind_vertex_buffer;
+
+    uint32_t binding;
+    VkBuffer buffer;
+    VkDeviceSize offset;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Vlk_cmd_bind_index_buffer final {
+    static constexpr auto type = Vlk_cmd_type::bind_index_buffer;
+
+    VkBuffer buffer;
+    VkDeviceSize offset;
+    VkIndexType index_type;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Vlk_cmd_bind_desc_sets final {
+    static constexpr auto type = Vlk_cmd_type::bind_desc_sets;
+
+    VkPipelineBindPoint bind_point;
+    VkPipelineLayout pipeline_layout;
+    uint32_t first_set;
+    uint32_t desc_set_count;
+    const VkDescriptorSet* desc_sets;
+    uint32_t offset_count;
+    const uint32_t* offsets;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Vlk_cmd_push_desc_set final {
+    static constexpr auto type = Vlk_cmd_type::push_desc_set;
+
+    VkPipelineBindPoint bind_point;
+    VkPipelineLayout pipeline_layout;
+    uint32_t set;
+    const Vlk_set_layout* set_layout;
+    const Vlk_desc_info_array* infos;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Vlk_cmd_push_constants final {
+    static constexpr auto type = Vlk_cmd_type::push_constants;
+
+    VkPipelineLayout pipeline_layout;
+    VkShaderStageFlags stage_flags;
+    uint32_t size;
+    const void* values;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Vlk_cmd_set_viewport final {
+    static constexpr auto type = Vlk_cmd_type::set_viewport;
+
+    VkViewport viewport;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Vlk_cmd_set_scissor final {
+    static constexpr auto type = Vlk_cmd_type::set_scissor;
+
+    VkRect2D scissor;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Vlk_cmd_draw final {
+    static constexpr auto type = Vlk_cmd_type::draw;
+
+    uint32_t count;
+    uint32_t first;
+    uint32_t instance_count;
+    uint32_t first_instance;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Vlk_cmd_draw_indexed final {
+    static constexpr auto type = Vlk_cmd_type::draw_indexed;
+
+    uint32_t count;
+    uint32_t first;
+    uint32_t instance_count;
+    uint32_t first_instance;
+    int32_t base_vertex;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Vlk_cmd_draw_indirect final {
+    static constexpr auto type = Vlk_cmd_type::draw_indirect;
+
+    VkBuffer buffer;
+    VkDeviceSize offset;
+    uint32_t draw_count;
+    uint32_t stride;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Vlk_cmd_draw_indexed_indirect final {
+    static constexpr auto type = Vlk_cmd_type::draw_indexed_indirect;
+
+    VkBuffer buffer;
+    VkDeviceSize offset;
+    uint32_t draw_count;
+    uint32_t stride;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Vlk_cmd_execute_commands final {
+    static constexpr auto type = Vlk_cmd_type::execute_commands;
+
+    uint32_t command_buffer_count;
+    const VkCommandBuffer* command_buffers;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Vlk_cmd_copy_buffer final {
+    static constexpr auto type = Vlk_cmd_type::copy_buffer;
+
+    VkBuffer src_buffer;
+    VkBuffer dst_buffer;
+    VkBufferCopy region;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Vlk_cmd_copy_buffer_to_image final {
+    static constexpr auto type = Vlk_cmd_type::copy_buffer_to_image;
+
+    VkBuffer src_buffer;
+    VkImage dst_image;
+    VkBufferImageCopy region;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Vlk_cmd_copy_image_to_buffer final {
+    static constexpr auto type = Vlk_cmd_type::copy_image_to_buffer;
+
+    VkImage src_image;
+    VkBuffer dst_buffer;
+    VkBufferImageCopy region;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Vlk_cmd_node final {
+    Vlk_cmd_node* next;
+    Vlk_cmd_type type;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+struct Vlk_cmd_packet final {
+    Vlk_cmd_node node;
+    T cmd;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Vlk_cmd_list final {
+public:
+    Vlk_cmd_list() noexcept;
+
+    void splice(Vlk_cmd_list& list) noexcept;
+
+    void execute(VkCommandBuffer command_buffer) const;
+
+    void clear() noexcept;
+
+    template<typename T>
+    inline void record(Vlk_cmd_arena* arena, const T& cmd)
+    {
+        auto memory = arena->allocate(sizeof(Vlk_cmd_packet<T>), alignof(Vlk_cmd_packet<T>));
+        auto packet = new (memory) Vlk_cmd_packet<T> {{nullptr, T::type}, cmd};
+
+        append_(&packet->node);
+    }
+
+    inline auto empty() const noexcept
+    { return !head_; }
+
+private:
+    void append_(Vlk_cmd_node* node) noexcept;
+
+private:
+    Vlk_cmd_node* head_;
+    Vlk_cmd_node* tail_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_VLK_CMD_LIST_GUARD
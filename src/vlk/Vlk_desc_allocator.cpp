@@ -0,0 +1,74 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "std_lib.h"
+#include "vlk_lib.h"
+#include "Vlk_desc_allocator.h"
+#include "Vlk_device.h"
+#include "Vlk_set_layout.h"
+
+using namespace std;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Vlk_desc_allocator::Vlk_desc_allocator(Vlk_device* device) :
+    device_ {device},
+    desc_pools_ {}
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Vlk_desc_allocator::~Vlk_desc_allocator()
+{
+    reset();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+VkDescriptorSet Vlk_desc_allocator::allocate(Vlk_set_layout* set_layout)
+{
+    // configure a descriptor set allocate info.
+    VkDescriptorSetAllocateInfo allocate_info {};
+
+    allocate_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocate_info.descriptorSetCount = 1;
+    allocate_info.pSetLayouts = &set_layout->desc_set_layout();
+
+    VkDescriptorSet desc_set {VK_NULL_HANDLE};
+
+    if (!desc_pools_.empty()) {
+        allocate_info.descriptorPool = desc_pools_.back();
+
+        if (VK_SUCCESS == vkAllocateDescriptorSets(device_->device(), &allocate_info, &desc_set))
+            return desc_set;
+    }
+
+    // the current pool is exhausted, so the allocator grows with another shared pool.
+    desc_pools_.push_back(device_->acquire_desc_pool());
+    allocate_info.descriptorPool = desc_pools_.back();
+
+    if (vkAllocateDescriptorSets(device_->device(), &allocate_info, &desc_set))
+        throw runtime_error("fail to allocate a descriptor set");
+
+    return desc_set;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_desc_allocator::reset()
+{
+    // pools go back to a device, they are reused by any command buffer.
+    for (auto desc_pool : desc_pools_)
+        device_->release_desc_pool(desc_pool);
+
+    desc_pools_.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
@@ -0,0 +1,40 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_VLK_DESC_ALLOCATOR_GUARD
+#define GFX_VLK_DESC_ALLOCATOR_GUARD
+
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Vlk_device;
+class Vlk_set_layout;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Vlk_desc_allocator final {
+public:
+    explicit Vlk_desc_allocator(Vlk_device* device);
+
+    ~Vlk_desc_allocator();
+
+    VkDescriptorSet allocate(Vlk_set_layout* set_layout);
+
+    void reset();
+
+private:
+    Vlk_device* device_;
+    std::vector<VkDescriptorPool> desc_pools_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_VLK_DESC_ALLOCATOR_GUARD
@@ -5,6 +5,7 @@
 
 #define VMA_IMPLEMENTATION
 
+#include <cstring>
 #include <metrohash.h>
 #include "std_lib.h"
 #include "vlk_lib.h"
@@ -14,9 +15,12 @@
 #include "Vlk_sampler.h"
 #include "Vlk_shader.h"
 #include "Vlk_pipeline.h"
+#include "Vlk_bind_group.h"
 #include "Vlk_swap_chain.h"
 #include "Vlk_cmd_buffer.h"
 #include "Vlk_fence.h"
+#include "Vlk_semaphore.h"
+#include "Vlk_timeline.h"
 #include "Vlk_render_pass.h"
 #include "Vlk_framebuffer.h"
 
@@ -44,6 +48,154 @@ inline constexpr auto all_flags(uint32_t src, uint32_t test) noexcept
 
 //----------------------------------------------------------------------------------------------------------------------
 
+inline auto has_extension(const vector<VkExtensionProperties>& properties, const char* name) noexcept
+{
+    for (auto& property : properties) {
+        if (!strcmp(property.extensionName, name))
+            return true;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+#if defined(__ANDROID__)
+constexpr auto library_name = "libvulkan.so";
+#elif defined(__linux__)
+constexpr auto library_name = "libvulkan.so.1";
+#elif defined(_WIN32)
+constexpr auto library_name = "vulkan-1.dll";
+#elif defined(VK_USE_PLATFORM_MACOS_MVK)
+constexpr auto library_name = "libvulkan.dylib";
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline auto to_Adapter_type(VkPhysicalDeviceType type) noexcept
+{
+    switch (type) {
+        case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:
+            return Adapter_type::discrete;
+        case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:
+            return Adapter_type::integrated;
+        case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:
+            return Adapter_type::virtual_gpu;
+        case VK_PHYSICAL_DEVICE_TYPE_CPU:
+            return Adapter_type::cpu;
+        default:
+            return Adapter_type::other;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline auto find_transfer_queue_family_index(const vector<VkQueueFamilyProperties>& properties) noexcept
+{
+    // find the queue family index supporting only the transfer, which runs on a dma engine.
+    constexpr auto queue_flags = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT;
+
+    for (auto i = 0; i != properties.size(); ++i) {
+        auto& granularity = properties[i].minImageTransferGranularity;
+
+        if (!(properties[i].queueFlags & VK_QUEUE_TRANSFER_BIT) || (properties[i].queueFlags & queue_flags))
+            continue;
+
+        // copies of an arbitrary region are required.
+        if (1 == granularity.width && 1 == granularity.height && 1 == granularity.depth)
+            return static_cast<uint32_t>(i);
+    }
+
+    return UINT32_MAX;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+inline auto find_queue_family_index(const vector<VkQueueFamilyProperties>& properties) noexcept
+{
+    // find the queue family index supporting the graphics and the compute.
+    constexpr auto queue_flags = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT;
+
+    for (auto i = 0; i != properties.size(); ++i) {
+        if (all_flags(properties[i].queueFlags, queue_flags))
+            return static_cast<uint32_t>(i);
+    }
+
+    return UINT32_MAX;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+vector<VkPhysicalDevice> query_physical_devices(VkInstance instance,
+                                                PFN_vkEnumeratePhysicalDevices enumerate_physical_devices)
+{
+    // query the physical device count.
+    uint32_t count;
+
+    enumerate_physical_devices(instance, &count, nullptr);
+
+    // query physical devices.
+    vector<VkPhysicalDevice> physical_devices(count);
+
+    if (count)
+        enumerate_physical_devices(instance, &count, &physical_devices[0]);
+
+    return physical_devices;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+vector<Adapter> query_adapters(const vector<VkPhysicalDevice>& physical_devices,
+                               PFN_vkGetPhysicalDeviceProperties get_properties,
+                               PFN_vkGetPhysicalDeviceMemoryProperties get_memory_properties,
+                               PFN_vkGetPhysicalDeviceQueueFamilyProperties get_queue_family_properties)
+{
+    vector<Adapter> adapters;
+
+    for (auto i = 0; i != physical_devices.size(); ++i) {
+        // query the physical device queue family properties.
+        uint32_t count;
+
+        get_queue_family_properties(physical_devices[i], &count, nullptr);
+
+        vector<VkQueueFamilyProperties> queue_family_properties(count);
+
+        if (count)
+            get_queue_family_properties(physical_devices[i], &count, &queue_family_properties[0]);
+
+        // skip a physical device which can't render.
+        if (UINT32_MAX == find_queue_family_index(queue_family_properties))
+            continue;
+
+        // query the physical device properties.
+        VkPhysicalDeviceProperties properties;
+
+        get_properties(physical_devices[i], &properties);
+
+        // query the size of the device local memory.
+        VkPhysicalDeviceMemoryProperties memory_properties;
+
+        get_memory_properties(physical_devices[i], &memory_properties);
+
+        uint64_t memory_size {0};
+
+        for (auto j = 0; j != memory_properties.memoryHeapCount; ++j) {
+            if (memory_properties.memoryHeaps[j].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+                memory_size += memory_properties.memoryHeaps[j].size;
+        }
+
+        adapters.push_back({static_cast<uint32_t>(i),
+                            properties.deviceName,
+                            to_Adapter_type(properties.deviceType),
+                            memory_size,
+                            count});
+    }
+
+    return adapters;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 } // of namespace
 
 namespace Gfx_lib {
@@ -59,27 +211,49 @@ APPLY_VLK_INSTANCE_OSX_SURFACE_SYMBOLS(DEFINE_VLK_SYMBOL)
 APPLY_VLK_INSTANCE_DEBUG_REPORT_SYMBOLS(DEFINE_VLK_SYMBOL)
 APPLY_VLK_DEVICE_CORE_SYMBOLS(DEFINE_VLK_SYMBOL)
 APPLY_VLK_DEVICE_SWAPCHAIN_SYMBOLS(DEFINE_VLK_SYMBOL)
+APPLY_VLK_DEVICE_TIMELINE_SEMAPHORE_SYMBOLS(DEFINE_VLK_SYMBOL)
+APPLY_VLK_DEVICE_DESC_UPDATE_TEMPLATE_SYMBOLS(DEFINE_VLK_SYMBOL)
+APPLY_VLK_DEVICE_PUSH_DESCRIPTOR_SYMBOLS(DEFINE_VLK_SYMBOL)
 
 //----------------------------------------------------------------------------------------------------------------------
 
-Vlk_device::Vlk_device() :
+Vlk_device::Vlk_device(const Device_desc& desc) :
     Device(),
     library_ {},
     instance_ { VK_NULL_HANDLE },
     physical_device_ { VK_NULL_HANDLE },
     queue_family_index_ { UINT32_MAX },
+    transfer_queue_family_index_ { UINT32_MAX },
     device_ { VK_NULL_HANDLE },
     queue_ { VK_NULL_HANDLE },
+    transfer_queue_ { VK_NULL_HANDLE },
     allocator_ { VK_NULL_HANDLE },
     command_pool_ { VK_NULL_HANDLE },
+    presentable_ { false },
+    timeline_semaphore_ { false },
+    desc_update_template_ { false },
+    push_descriptor_ { false },
+    multi_draw_indirect_ { false },
     render_pass_pool_ {},
-    framebuffer_pool_ {}
+    framebuffer_pool_ {},
+    set_layout_pool_ {},
+    pool_mutex_ {},
+    desc_pool_mutex_ {},
+    desc_pools_ {},
+    free_desc_pools_ {},
+    queue_mutex_ {},
+    pending_buffer_barriers_ {},
+    pending_image_barriers_ {},
+    pending_semaphores_ {},
+    free_semaphores_ {},
+    handoffs_ {},
+    free_handoffs_ {}
 {
     init_library_();
     init_bootstrap_symbols_();
     init_instance_();
     init_instance_symbols_();
-    init_physical_device_();
+    init_physical_device_(desc);
     init_queue_family_index_();
     init_device_();
     init_device_symbols_();
@@ -96,7 +270,10 @@ Vlk_device::~Vlk_device()
 {
     framebuffer_pool_.clear();
     render_pass_pool_.clear();
+    set_layout_pool_.clear();
 
+    fini_handoffs_();
+    fini_desc_pools_();
     fini_pipeline_cache_();
     fini_command_pool_();
     fini_allocator_();
@@ -106,6 +283,55 @@ Vlk_device::~Vlk_device()
 
 //----------------------------------------------------------------------------------------------------------------------
 
+std::vector<Adapter> Vlk_device::enumerate()
+{
+    // load the library without touching symbols of created devices.
+    Library library;
+
+    try {
+        library = Library { library_name };
+    }
+    catch (exception& e) {
+        return {};
+    }
+
+    auto create_instance = library.symbol<PFN_vkCreateInstance>("vkCreateInstance");
+    auto destroy_instance = library.symbol<PFN_vkDestroyInstance>("vkDestroyInstance");
+    auto enumerate_physical_devices = library.symbol<PFN_vkEnumeratePhysicalDevices>("vkEnumeratePhysicalDevices");
+    auto get_properties = library.symbol<PFN_vkGetPhysicalDeviceProperties>("vkGetPhysicalDeviceProperties");
+    auto get_memory_properties =
+        library.symbol<PFN_vkGetPhysicalDeviceMemoryProperties>("vkGetPhysicalDeviceMemoryProperties");
+    auto get_queue_family_properties =
+        library.symbol<PFN_vkGetPhysicalDeviceQueueFamilyProperties>("vkGetPhysicalDeviceQueueFamilyProperties");
+
+    // configure the application info.
+    VkApplicationInfo app_info {};
+
+    app_info.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+    app_info.apiVersion = VK_MAKE_VERSION(1, 0, 0);
+
+    // configure the instance create info.
+    VkInstanceCreateInfo create_info {};
+
+    create_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+    create_info.pApplicationInfo = &app_info;
+
+    // try to create an instance.
+    VkInstance instance;
+
+    if (create_instance(&create_info, nullptr, &instance))
+        return {};
+
+    auto adapters = query_adapters(query_physical_devices(instance, enumerate_physical_devices),
+                                   get_properties, get_memory_properties, get_queue_family_properties);
+
+    destroy_instance(instance, nullptr);
+
+    return adapters;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 std::unique_ptr<Buffer> Vlk_device::create(const Buffer_desc& desc)
 {
     return make_unique<Vlk_buffer>(desc, this);
@@ -141,8 +367,25 @@ std::unique_ptr<Pipeline> Vlk_device::create(const Pipeline_desc& desc)
 
 //----------------------------------------------------------------------------------------------------------------------
 
+std::unique_ptr<Pipeline> Vlk_device::create(const Compute_pipeline_desc& desc)
+{
+    return make_unique<Vlk_pipeline>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Bind_group> Vlk_device::create(const Bind_group_desc& desc)
+{
+    return make_unique<Vlk_bind_group>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 std::unique_ptr<Swap_chain> Vlk_device::create(const Swap_chain_desc& desc)
 {
+    if (!presentable_)
+        throw runtime_error("fail to create a swap chain");
+
     return make_unique<Vlk_swap_chain>(desc, this);
 }
 
@@ -150,7 +393,7 @@ std::unique_ptr<Swap_chain> Vlk_device::create(const Swap_chain_desc& desc)
 
 std::unique_ptr<Cmd_buffer> Vlk_device::create(const Cmd_buffer_desc& desc)
 {
-    return make_unique<Vlk_cmd_buffer>(this);
+    return make_unique<Vlk_cmd_buffer>(desc, this);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -162,21 +405,192 @@ std::unique_ptr<Fence> Vlk_device::create(const Fence_desc& desc)
 
 //----------------------------------------------------------------------------------------------------------------------
 
+std::unique_ptr<Semaphore> Vlk_device::create(const Semaphore_desc& desc)
+{
+    return make_unique<Vlk_semaphore>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Timeline> Vlk_device::create(const Timeline_desc& desc)
+{
+    return make_unique<Vlk_timeline>(desc, this);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 void Vlk_device::submit(Cmd_buffer* cmd_buffer, Fence* fence)
 {
-    // cast to the implementation.
-    auto cmd_buffer_impl = static_cast<Vlk_cmd_buffer*>(cmd_buffer);
+    Submit_desc desc;
+
+    desc.cmd_buffers.push_back(cmd_buffer);
+
+    submit(vector<Submit_desc> {desc}, fence);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_device::submit(const std::vector<Submit_desc>& descs, Fence* fence)
+{
     auto fence_impl = static_cast<Vlk_fence*>(fence);
 
-    // configure a submit info.
-    VkSubmitInfo submit_info {};
+    // count handles to keep pointers of submit infos valid.
+    size_t command_buffer_count {0};
+    size_t wait_semaphore_count {0};
+    size_t signal_semaphore_count {descs.size() + 1};
 
-    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submit_info.commandBufferCount = 1;
-    submit_info.pCommandBuffers = &cmd_buffer_impl->command_buffer();
+    // all command buffers of a batch must be submitted to the same queue.
+    auto queue_type = Queue_type::graphics;
+
+    for (auto& desc : descs) {
+        if (!command_buffer_count && !desc.cmd_buffers.empty())
+            queue_type = static_cast<Vlk_cmd_buffer*>(desc.cmd_buffers.front())->queue_type();
+
+        command_buffer_count += desc.cmd_buffers.size();
+        wait_semaphore_count += desc.wait_semaphores.size();
+        signal_semaphore_count += desc.signal_semaphores.size();
+    }
+
+    if (descs.empty())
+        return;
+
+    auto handoff = false;
+
+    vector<VkCommandBuffer> command_buffers;
+    vector<VkSemaphore> wait_semaphores;
+    vector<VkPipelineStageFlags> wait_stages;
+    vector<VkSemaphore> signal_semaphores;
+    vector<uint64_t> signal_values;
+    vector<VkTimelineSemaphoreSubmitInfoKHR> timeline_infos;
+    vector<VkSubmitInfo> submit_infos;
+
+    command_buffers.reserve(command_buffer_count);
+    wait_semaphores.reserve(wait_semaphore_count);
+    wait_stages.reserve(wait_semaphore_count);
+    signal_semaphores.reserve(signal_semaphore_count);
+    signal_values.reserve(signal_semaphore_count);
+    timeline_infos.reserve(descs.size());
+    submit_infos.reserve(descs.size());
+
+    for (auto& desc : descs) {
+        // configure a submit info.
+        VkSubmitInfo submit_info {};
+
+        submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submit_info.waitSemaphoreCount = desc.wait_semaphores.size();
+        submit_info.pWaitSemaphores = wait_semaphores.data() + wait_semaphores.size();
+        submit_info.pWaitDstStageMask = wait_stages.data() + wait_stages.size();
+        submit_info.commandBufferCount = desc.cmd_buffers.size();
+        submit_info.pCommandBuffers = command_buffers.data() + command_buffers.size();
+        submit_info.signalSemaphoreCount = desc.signal_semaphores.size();
+        submit_info.pSignalSemaphores = signal_semaphores.data() + signal_semaphores.size();
+
+        for (auto semaphore : desc.wait_semaphores) {
+            wait_semaphores.push_back(static_cast<Vlk_semaphore*>(semaphore)->semaphore());
+            wait_stages.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+        }
+
+        for (auto cmd_buffer : desc.cmd_buffers) {
+            auto cmd_buffer_impl = static_cast<Vlk_cmd_buffer*>(cmd_buffer);
 
-    // submit a command buffer.
-    vkQueueSubmit(queue_, 1, &submit_info, fence_impl ? fence_impl->fence() : VK_NULL_HANDLE);
+            if (queue_type != cmd_buffer_impl->queue_type())
+                throw runtime_error("fail to submit command buffers");
+
+            handoff |= cmd_buffer_impl->has_acquire_barriers();
+            command_buffers.push_back(cmd_buffer_impl->command_buffer());
+        }
+
+        for (auto semaphore : desc.signal_semaphores) {
+            signal_semaphores.push_back(static_cast<Vlk_semaphore*>(semaphore)->semaphore());
+            signal_values.push_back(0);
+        }
+
+        // values of binary semaphores are ignored, but they must be matched with semaphores.
+        if (desc.timeline) {
+            VkTimelineSemaphoreSubmitInfoKHR timeline_info {};
+
+            signal_semaphores.push_back(static_cast<Vlk_timeline*>(desc.timeline)->semaphore());
+            signal_values.push_back(desc.timeline_value);
+            ++submit_info.signalSemaphoreCount;
+
+            timeline_info.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+            timeline_info.signalSemaphoreValueCount = submit_info.signalSemaphoreCount;
+            timeline_info.pSignalSemaphoreValues = signal_values.data() + signal_values.size() -
+                                                   submit_info.signalSemaphoreCount;
+
+            timeline_infos.push_back(timeline_info);
+            submit_info.pNext = &timeline_infos.back();
+        }
+
+        submit_infos.push_back(submit_info);
+    }
+
+    if (Queue_type::transfer == queue_type) {
+        lock_guard<mutex> lock {queue_mutex_};
+
+        // hand off ownerships of written resources to the graphics queue.
+        if (handoff) {
+            auto semaphore = acquire_semaphore_();
+
+            // the last submit info signals a semaphore after all command buffers of a batch.
+            auto& submit_info = submit_infos.back();
+
+            signal_semaphores.push_back(semaphore);
+            signal_values.push_back(0);
+            ++submit_info.signalSemaphoreCount;
+
+            if (submit_info.pNext)
+                ++timeline_infos.back().signalSemaphoreValueCount;
+
+            for (auto& desc : descs) {
+                for (auto cmd_buffer : desc.cmd_buffers) {
+                    auto cmd_buffer_impl = static_cast<Vlk_cmd_buffer*>(cmd_buffer);
+                    auto& buffer_barriers = cmd_buffer_impl->acquire_buffer_barriers();
+                    auto& image_barriers = cmd_buffer_impl->acquire_image_barriers();
+
+                    pending_buffer_barriers_.insert(pending_buffer_barriers_.end(),
+                                                    buffer_barriers.begin(), buffer_barriers.end());
+                    pending_image_barriers_.insert(pending_image_barriers_.end(),
+                                                   image_barriers.begin(), image_barriers.end());
+                }
+            }
+
+            pending_semaphores_.push_back(semaphore);
+        }
+
+        // submit command buffers to the transfer queue.
+        vkQueueSubmit(transfer_queue_, submit_infos.size(), submit_infos.data(),
+                      fence_impl ? fence_impl->fence() : VK_NULL_HANDLE);
+    }
+    else {
+        // a transfer queue is a graphics queue without a dedicated family, so submits are serialized by a lock.
+        lock_guard<mutex> lock {queue_mutex_};
+
+        // acquire ownerships released by the transfer queue before any graphics work.
+        if (!pending_semaphores_.empty())
+            submit_handoff_();
+
+        // submit command buffers.
+        vkQueueSubmit(queue_, submit_infos.size(), submit_infos.data(),
+                      fence_impl ? fence_impl->fence() : VK_NULL_HANDLE);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+bool Vlk_device::wait(const std::vector<Fence*>& fences, bool wait_all, uint64_t timeout)
+{
+    if (fences.empty())
+        return true;
+
+    vector<VkFence> vk_fences;
+
+    vk_fences.reserve(fences.size());
+
+    for (auto fence : fences)
+        vk_fences.push_back(static_cast<Vlk_fence*>(fence)->fence());
+
+    return VK_SUCCESS == vkWaitForFences(device_, vk_fences.size(), vk_fences.data(), wait_all, timeout);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -197,6 +611,8 @@ Vlk_render_pass* Vlk_device::render_pass(const Vlk_render_pass_desc& desc)
                       reinterpret_cast<uint8_t*>(&key));
 
     // check a render pass exists and if not then create it.
+    lock_guard<mutex> lock {pool_mutex_};
+
     if (!render_pass_pool_.contains(key))
         render_pass_pool_.emplace(key, desc, this);
 
@@ -214,6 +630,8 @@ Vlk_framebuffer* Vlk_device::framebuffer(const Vlk_framebuffer_desc& desc)
                       reinterpret_cast<uint8_t*>(&key));
 
     // check a framebuffer exists and if not then create it.
+    lock_guard<mutex> lock {pool_mutex_};
+
     if (!framebuffer_pool_.contains(key))
         framebuffer_pool_.emplace(key, desc, this);
 
@@ -222,16 +640,87 @@ Vlk_framebuffer* Vlk_device::framebuffer(const Vlk_framebuffer_desc& desc)
 
 //----------------------------------------------------------------------------------------------------------------------
 
+Vlk_set_layout* Vlk_device::set_layout(const Vlk_set_layout_desc& desc)
+{
+    // calculate a hash value, pipelines with same bindings share a set layout.
+    uint64_t key { 0 };
+
+    MetroHash64::Hash(reinterpret_cast<const uint8_t*>(desc.bindings.data()),
+                      sizeof(VkDescriptorSetLayoutBinding) * desc.bindings.size(),
+                      reinterpret_cast<uint8_t*>(&key), desc.push_descriptor ? 1 : 0);
+
+    // check a set layout exists and if not then create it.
+    lock_guard<mutex> lock {pool_mutex_};
+
+    auto& set_layout = set_layout_pool_[key];
+
+    if (!set_layout)
+        set_layout = make_unique<Vlk_set_layout>(desc, this);
+
+    return set_layout.get();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+VkDescriptorPool Vlk_device::acquire_desc_pool()
+{
+    lock_guard<mutex> lock {desc_pool_mutex_};
+
+    if (!free_desc_pools_.empty()) {
+        auto desc_pool = free_desc_pools_.back();
+
+        free_desc_pools_.pop_back();
+
+        return desc_pool;
+    }
+
+    // a pool is shared by all set layouts, so it has room for every descriptor type.
+    constexpr auto max_set_count = 256;
+
+    constexpr array<VkDescriptorPoolSize, 4> pool_sizes {{
+        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, max_set_count * 4},
+        {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, max_set_count * 4},
+        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, max_set_count * 2},
+        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, max_set_count * 2}
+    }};
+
+    // configure a descriptor pool create info.
+    VkDescriptorPoolCreateInfo create_info {};
+
+    create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    create_info.maxSets = max_set_count;
+    create_info.poolSizeCount = static_cast<uint32_t>(pool_sizes.size());
+    create_info.pPoolSizes = pool_sizes.data();
+
+    // try to create a descriptor pool.
+    VkDescriptorPool desc_pool;
+
+    if (vkCreateDescriptorPool(device_, &create_info, nullptr, &desc_pool))
+        throw runtime_error("fail to create a descriptor pool");
+
+    desc_pools_.push_back(desc_pool);
+
+    return desc_pool;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_device::release_desc_pool(VkDescriptorPool desc_pool)
+{
+    // a pool is released when a gpu is done with its sets, so sets are freed at once.
+    vkResetDescriptorPool(device_, desc_pool, 0);
+
+    lock_guard<mutex> lock {desc_pool_mutex_};
+
+    free_desc_pools_.push_back(desc_pool);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 void Vlk_device::init_library_()
 {
     try {
-#if defined(__ANDROID__)
-        library_ = Library { "libvulkan.so" };
-#elif defined(_WIN32)
-        library_ = Library { "vulkan-1.dll" };
-#elif defined(VK_USE_PLATFORM_MACOS_MVK)
-        library_ = Library { "libvulkan.dylib" };
-#endif
+        library_ = Library { library_name };
     }
     catch (exception& e) {
         throw runtime_error("fail to create a device");
@@ -249,19 +738,46 @@ void Vlk_device::init_bootstrap_symbols_()
 
 void Vlk_device::init_instance_()
 {
-    vector<const char*> extensions {
+    // query the instance extension properties.
+    uint32_t count;
+
+    vkEnumerateInstanceExtensionProperties(nullptr, &count, nullptr);
+
+    vector<VkExtensionProperties> properties(count);
+
+    vkEnumerateInstanceExtensionProperties(nullptr, &count, properties.data());
+
+    // enable the surface extensions only when a window system is available.
+    vector<const char*> extensions;
+
 #if defined(_DEBUG) || !defined(NDEBUG)
-        VK_EXT_DEBUG_REPORT_EXTENSION_NAME,
+    if (has_extension(properties, VK_EXT_DEBUG_REPORT_EXTENSION_NAME))
+        extensions.push_back(VK_EXT_DEBUG_REPORT_EXTENSION_NAME);
 #endif
-        VK_KHR_SURFACE_EXTENSION_NAME,
+
 #if defined(VK_USE_PLATFORM_ANDROID_KHR)
-        VK_KHR_ANDROID_SURFACE_EXTENSION_NAME
+    constexpr auto surface_extension_name = VK_KHR_ANDROID_SURFACE_EXTENSION_NAME;
 #elif defined(VK_USE_PLATFORM_WIN32_KHR)
-        VK_KHR_WIN32_SURFACE_EXTENSION_NAME
+    constexpr auto surface_extension_name = VK_KHR_WIN32_SURFACE_EXTENSION_NAME;
 #elif defined(VK_USE_PLATFORM_MACOS_MVK)
-        VK_MVK_MACOS_SURFACE_EXTENSION_NAME
+    constexpr auto surface_extension_name = VK_MVK_MACOS_SURFACE_EXTENSION_NAME;
+#else
+    constexpr auto surface_extension_name = "";
 #endif
-    };
+
+    // timeline semaphores and push descriptors depend on the physical device properties2 extension.
+    if (has_extension(properties, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME)) {
+        extensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+        timeline_semaphore_ = true;
+        push_descriptor_ = true;
+    }
+
+    if (has_extension(properties, VK_KHR_SURFACE_EXTENSION_NAME) &&
+        has_extension(properties, surface_extension_name)) {
+        extensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
+        extensions.push_back(surface_extension_name);
+        presentable_ = true;
+    }
 
     // configure the application info.
     VkApplicationInfo app_info {};
@@ -275,7 +791,7 @@ void Vlk_device::init_instance_()
     create_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
     create_info.pApplicationInfo = &app_info;
     create_info.enabledExtensionCount = extensions.size();
-    create_info.ppEnabledExtensionNames = &extensions[0];
+    create_info.ppEnabledExtensionNames = extensions.data();
 
     // try to create an instance.
     if (vkCreateInstance(&create_info, nullptr, &instance_))
@@ -296,23 +812,19 @@ void Vlk_device::init_instance_symbols_()
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Vlk_device::init_physical_device_()
+void Vlk_device::init_physical_device_(const Device_desc& desc)
 {
-    // query the physical device count.
-    uint32_t count;
-
-    vkEnumeratePhysicalDevices(instance_, &count, nullptr);
-
-    if (!count)
-        throw runtime_error("fail to create a device");
-
-    // query physical devices
-    vector<VkPhysicalDevice> physical_devices(count);
-
-    vkEnumeratePhysicalDevices(instance_, &count, &physical_devices[0]);
-
-    // todo: find the best physical device.
-    physical_device_ = physical_devices[0];
+    // query physical devices which can render.
+    auto physical_devices = query_physical_devices(instance_, vkEnumeratePhysicalDevices);
+    auto adapters = query_adapters(physical_devices,
+                                   vkGetPhysicalDeviceProperties,
+                                   vkGetPhysicalDeviceMemoryProperties,
+                                   vkGetPhysicalDeviceQueueFamilyProperties);
+
+    // select the best physical device.
+    backend_ = Backend::vulkan;
+    adapter_ = select(adapters, desc);
+    physical_device_ = physical_devices[adapter_.index];
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -331,45 +843,105 @@ void Vlk_device::init_queue_family_index_()
     vkGetPhysicalDeviceQueueFamilyProperties(physical_device_, &count, &properties[0]);
 
     // query the queue family index supporting the graphics and the compute.
-    constexpr auto queue_flags = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT;
-
-    for (auto i = 0; i != properties.size(); ++i) {
-        if (all_flags(properties[i].queueFlags, queue_flags)) {
-            queue_family_index_ = i;
-            break;
-        }
-    }
+    queue_family_index_ = find_queue_family_index(properties);
 
     if (UINT32_MAX == queue_family_index_)
         throw runtime_error("fail to create a deivce");
+
+    // query the dedicated transfer queue family index, the graphics queue is used without it.
+    transfer_queue_family_index_ = find_transfer_queue_family_index(properties);
+
+    if (UINT32_MAX == transfer_queue_family_index_)
+        transfer_queue_family_index_ = queue_family_index_;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
 void Vlk_device::init_device_()
 {
+    // query the device extension properties.
+    uint32_t count;
+
+    vkEnumerateDeviceExtensionProperties(physical_device_, nullptr, &count, nullptr);
+
+    vector<VkExtensionProperties> properties(count);
+
+    vkEnumerateDeviceExtensionProperties(physical_device_, nullptr, &count, properties.data());
+
+    // a swapchain is only required when a device can present.
     vector<const char*> extensions {
-        "VK_KHR_swapchain",
-        "VK_KHR_maintenance1"
+        VK_KHR_MAINTENANCE1_EXTENSION_NAME
     };
 
-    // configure the device create info.
-    VkDeviceQueueCreateInfo queue_create_info {};
+    if (presentable_ && has_extension(properties, VK_KHR_SWAPCHAIN_EXTENSION_NAME))
+        extensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+    else
+        presentable_ = false;
+
+    // the feature is mandatory when a device supports the extension.
+    VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timeline_semaphore_features {};
+
+    timeline_semaphore_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+    timeline_semaphore_features.timelineSemaphore = VK_TRUE;
+
+    if (timeline_semaphore_ && has_extension(properties, VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME))
+        extensions.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+    else
+        timeline_semaphore_ = false;
+
+    // descriptor sets are written with plain updates when templates aren't supported.
+    desc_update_template_ = has_extension(properties, VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME);
+
+    if (desc_update_template_)
+        extensions.push_back(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME);
+
+    // textures are written with allocated descriptor sets when push descriptors aren't supported.
+    if (push_descriptor_ && has_extension(properties, VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME))
+        extensions.push_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+    else
+        push_descriptor_ = false;
+
+    // indirect draws are split into single draws when multi draw indirect isn't supported.
+    VkPhysicalDeviceFeatures supported_features {};
+
+    vkGetPhysicalDeviceFeatures(physical_device_, &supported_features);
+
+    VkPhysicalDeviceFeatures features {};
+
+    features.multiDrawIndirect = supported_features.multiDrawIndirect;
+    features.drawIndirectFirstInstance = supported_features.drawIndirectFirstInstance;
+    multi_draw_indirect_ = supported_features.multiDrawIndirect;
+
+    // configure the device queue create infos.
+    vector<VkDeviceQueueCreateInfo> queue_create_infos;
     constexpr auto queue_priority { 0.0f };
 
-    queue_create_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-    queue_create_info.queueFamilyIndex = queue_family_index_;
-    queue_create_info.queueCount = 1;
-    queue_create_info.pQueuePriorities = &queue_priority;
+    vector<uint32_t> queue_family_indices { queue_family_index_ };
+
+    if (has_transfer_queue())
+        queue_family_indices.push_back(transfer_queue_family_index_);
+
+    for (auto queue_family_index : queue_family_indices) {
+        VkDeviceQueueCreateInfo queue_create_info {};
+
+        queue_create_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        queue_create_info.queueFamilyIndex = queue_family_index;
+        queue_create_info.queueCount = 1;
+        queue_create_info.pQueuePriorities = &queue_priority;
+
+        queue_create_infos.push_back(queue_create_info);
+    }
 
     // configure the device create info.
     VkDeviceCreateInfo create_info {};
 
     create_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-    create_info.queueCreateInfoCount = 1;
-    create_info.pQueueCreateInfos = &queue_create_info;
+    create_info.pNext = timeline_semaphore_ ? &timeline_semaphore_features : nullptr;
+    create_info.queueCreateInfoCount = queue_create_infos.size();
+    create_info.pQueueCreateInfos = queue_create_infos.data();
     create_info.enabledExtensionCount = extensions.size();
-    create_info.ppEnabledExtensionNames = &extensions[0];
+    create_info.ppEnabledExtensionNames = extensions.data();
+    create_info.pEnabledFeatures = &features;
 
     // try to create a device
     if (vkCreateDevice(physical_device_, &create_info, nullptr, &device_))
@@ -381,7 +953,22 @@ void Vlk_device::init_device_()
 void Vlk_device::init_device_symbols_()
 {
     APPLY_VLK_DEVICE_CORE_SYMBOLS(LOAD_VLK_DEVICE_SYMBOL)
-    APPLY_VLK_DEVICE_SWAPCHAIN_SYMBOLS(LOAD_VLK_DEVICE_SYMBOL)
+
+    if (presentable_) {
+        APPLY_VLK_DEVICE_SWAPCHAIN_SYMBOLS(LOAD_VLK_DEVICE_SYMBOL)
+    }
+
+    if (timeline_semaphore_) {
+        APPLY_VLK_DEVICE_TIMELINE_SEMAPHORE_SYMBOLS(LOAD_VLK_DEVICE_SYMBOL)
+    }
+
+    if (desc_update_template_) {
+        APPLY_VLK_DEVICE_DESC_UPDATE_TEMPLATE_SYMBOLS(LOAD_VLK_DEVICE_SYMBOL)
+    }
+
+    if (push_descriptor_) {
+        APPLY_VLK_DEVICE_PUSH_DESCRIPTOR_SYMBOLS(LOAD_VLK_DEVICE_SYMBOL)
+    }
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -397,6 +984,7 @@ void Vlk_device::init_caps_()
 void Vlk_device::init_queue_()
 {
     vkGetDeviceQueue(device_, queue_family_index_, 0, &queue_);
+    vkGetDeviceQueue(device_, transfer_queue_family_index_, 0, &transfer_queue_);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -449,7 +1037,7 @@ void Vlk_device::init_command_pool_()
     create_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
     create_info.queueFamilyIndex = queue_family_index_;
 
-    // try to create a command pool.
+    // try to create a command pool, command buffers of users have their own pools.
     if (vkCreateCommandPool(device_, &create_info, nullptr, &command_pool_))
         throw runtime_error("fail to create a device");
 }
@@ -470,6 +1058,140 @@ void Vlk_device::init_pipeline_cache_()
 
 //----------------------------------------------------------------------------------------------------------------------
 
+void Vlk_device::submit_handoff_()
+{
+    auto handoff = acquire_handoff_();
+
+    // configure the command buffer begin info.
+    VkCommandBufferBeginInfo begin_info {};
+
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    // record acquire barriers matching release barriers of the transfer queue.
+    vkBeginCommandBuffer(handoff.command_buffer, &begin_info);
+    vkCmdPipelineBarrier(handoff.command_buffer,
+                         VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                         0,
+                         0, nullptr,
+                         pending_buffer_barriers_.size(), pending_buffer_barriers_.data(),
+                         pending_image_barriers_.size(), pending_image_barriers_.data());
+    vkEndCommandBuffer(handoff.command_buffer);
+
+    // configure a submit info waiting the transfer queue.
+    vector<VkPipelineStageFlags> wait_stages(pending_semaphores_.size(), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+    VkSubmitInfo submit_info {};
+
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.waitSemaphoreCount = pending_semaphores_.size();
+    submit_info.pWaitSemaphores = pending_semaphores_.data();
+    submit_info.pWaitDstStageMask = wait_stages.data();
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers = &handoff.command_buffer;
+
+    // submit a command buffer, it is recycled after the fence is signaled.
+    vkQueueSubmit(queue_, 1, &submit_info, handoff.fence);
+
+    handoff.semaphores.swap(pending_semaphores_);
+    handoffs_.push_back(move(handoff));
+
+    pending_buffer_barriers_.clear();
+    pending_image_barriers_.clear();
+    pending_semaphores_.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_device::recycle_handoffs_()
+{
+    // handoffs complete in the submission order.
+    while (!handoffs_.empty()) {
+        auto& handoff = handoffs_.front();
+
+        if (VK_SUCCESS != vkGetFenceStatus(device_, handoff.fence))
+            break;
+
+        free_semaphores_.insert(free_semaphores_.end(), handoff.semaphores.begin(), handoff.semaphores.end());
+        handoff.semaphores.clear();
+
+        vkResetFences(device_, 1, &handoff.fence);
+        vkResetCommandBuffer(handoff.command_buffer, 0);
+
+        free_handoffs_.push_back(move(handoff));
+        handoffs_.pop_front();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Vlk_handoff Vlk_device::acquire_handoff_()
+{
+    recycle_handoffs_();
+
+    if (!free_handoffs_.empty()) {
+        auto handoff = move(free_handoffs_.back());
+
+        free_handoffs_.pop_back();
+
+        return handoff;
+    }
+
+    Vlk_handoff handoff;
+
+    // configure a command buffer allocate info.
+    VkCommandBufferAllocateInfo allocate_info {};
+
+    allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocate_info.commandPool = command_pool_;
+    allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocate_info.commandBufferCount = 1;
+
+    // try to create a command buffer.
+    if (vkAllocateCommandBuffers(device_, &allocate_info, &handoff.command_buffer))
+        throw runtime_error("fail to create a cmd buffer");
+
+    // configure a fence create info.
+    VkFenceCreateInfo create_info {};
+
+    create_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+    // try to create a fence.
+    if (vkCreateFence(device_, &create_info, nullptr, &handoff.fence))
+        throw runtime_error("fail to create a fence");
+
+    return handoff;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+VkSemaphore Vlk_device::acquire_semaphore_()
+{
+    recycle_handoffs_();
+
+    if (!free_semaphores_.empty()) {
+        auto semaphore = free_semaphores_.back();
+
+        free_semaphores_.pop_back();
+
+        return semaphore;
+    }
+
+    // configure a semaphore create info.
+    VkSemaphoreCreateInfo create_info {};
+
+    create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    // try to create a semaphore.
+    VkSemaphore semaphore;
+
+    if (vkCreateSemaphore(device_, &create_info, nullptr, &semaphore))
+        throw runtime_error("fail to create a semaphore");
+
+    return semaphore;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 void Vlk_device::fini_instance_()
 {
     vkDestroyInstance(instance_, nullptr);
@@ -503,4 +1225,31 @@ void Vlk_device::fini_pipeline_cache_()
 
 //----------------------------------------------------------------------------------------------------------------------
 
+void Vlk_device::fini_handoffs_()
+{
+    vkDeviceWaitIdle(device_);
+    recycle_handoffs_();
+
+    // semaphores waiting a handoff are never waited.
+    free_semaphores_.insert(free_semaphores_.end(), pending_semaphores_.begin(), pending_semaphores_.end());
+
+    for (auto semaphore : free_semaphores_)
+        vkDestroySemaphore(device_, semaphore, nullptr);
+
+    for (auto& handoff : free_handoffs_) {
+        vkDestroyFence(device_, handoff.fence, nullptr);
+        vkFreeCommandBuffers(device_, command_pool_, 1, &handoff.command_buffer);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_device::fini_desc_pools_()
+{
+    for (auto desc_pool : desc_pools_)
+        vkDestroyDescriptorPool(device_, desc_pool, nullptr);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 } // of namespace Gfx_lib
@@ -7,6 +7,8 @@
 #define GFX_VLK_DEVICE_GUARD
 
 #include <unordered_map>
+#include <deque>
+#include <mutex>
 #include <vulkan/vulkan.h>
 #include <vk_mem_alloc.h>
 #include <platform/Library.h>
@@ -14,6 +16,7 @@
 #include "Lru_cache.h"
 #include "Vlk_render_pass.h"
 #include "Vlk_framebuffer.h"
+#include "Vlk_set_layout.h"
 
 namespace Gfx_lib {
 
@@ -24,12 +27,22 @@ class Vlk_cmd_buffer;
 
 //----------------------------------------------------------------------------------------------------------------------
 
+struct Vlk_handoff final {
+    VkCommandBuffer command_buffer {VK_NULL_HANDLE};
+    VkFence fence {VK_NULL_HANDLE};
+    std::vector<VkSemaphore> semaphores;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
 class Vlk_device final : public Device {
 public:
-    Vlk_device();
+    explicit Vlk_device(const Device_desc& desc = {});
 
     ~Vlk_device() override;
 
+    static std::vector<Adapter> enumerate();
+
     std::unique_ptr<Buffer> create(const Buffer_desc& desc) override;
 
     std::unique_ptr<Image> create(const Image_desc& desc) override;
@@ -40,20 +53,38 @@ public:
 
     std::unique_ptr<Pipeline> create(const Pipeline_desc& desc) override;
 
+    std::unique_ptr<Pipeline> create(const Compute_pipeline_desc& desc) override;
+
+    std::unique_ptr<Bind_group> create(const Bind_group_desc& desc) override;
+
     std::unique_ptr<Swap_chain> create(const Swap_chain_desc& desc) override;
 
     std::unique_ptr<Cmd_buffer> create(const Cmd_buffer_desc& desc) override;
 
     std::unique_ptr<Fence> create(const Fence_desc& desc) override;
 
+    std::unique_ptr<Semaphore> create(const Semaphore_desc& desc) override;
+
+    std::unique_ptr<Timeline> create(const Timeline_desc& desc) override;
+
     void submit(Cmd_buffer* cmd_buffer, Fence* fence = nullptr) override;
 
+    void submit(const std::vector<Submit_desc>& descs, Fence* fence = nullptr) override;
+
+    bool wait(const std::vector<Fence*>& fences, bool wait_all, uint64_t timeout = UINT64_MAX) override;
+
     void wait_idle() override;
 
     Vlk_render_pass* render_pass(const Vlk_render_pass_desc& desc);
 
     Vlk_framebuffer* framebuffer(const Vlk_framebuffer_desc& desc);
 
+    Vlk_set_layout* set_layout(const Vlk_set_layout_desc& desc);
+
+    VkDescriptorPool acquire_desc_pool();
+
+    void release_desc_pool(VkDescriptorPool desc_pool);
+
     inline auto instance() const noexcept
     { return instance_; }
 
@@ -63,12 +94,24 @@ public:
     inline auto queue_family_index() const noexcept
     { return queue_family_index_; }
 
+    inline auto transfer_queue_family_index() const noexcept
+    { return transfer_queue_family_index_; }
+
+    inline auto has_transfer_queue() const noexcept
+    { return queue_family_index_ != transfer_queue_family_index_; }
+
     inline auto device() const noexcept
     { return device_; }
 
     inline auto queue() const noexcept
     { return queue_; }
 
+    inline auto& queue_mutex() noexcept
+    { return queue_mutex_; }
+
+    inline auto transfer_queue() const noexcept
+    { return transfer_queue_; }
+
     inline auto allocator() const noexcept
     { return allocator_; }
 
@@ -78,6 +121,21 @@ public:
     inline auto pipeline_cache() const noexcept
     { return pipeline_cache_; }
 
+    inline auto presentable() const noexcept
+    { return presentable_; }
+
+    inline auto timeline_semaphore() const noexcept
+    { return timeline_semaphore_; }
+
+    inline auto desc_update_template() const noexcept
+    { return desc_update_template_; }
+
+    inline auto push_descriptor() const noexcept
+    { return push_descriptor_; }
+
+    inline auto multi_draw_indirect() const noexcept
+    { return multi_draw_indirect_; }
+
 private:
     void init_library_();
 
@@ -87,7 +145,7 @@ private:
 
     void init_instance_symbols_();
 
-    void init_physical_device_();
+    void init_physical_device_(const Device_desc& desc);
 
     void init_queue_family_index_();
 
@@ -105,6 +163,14 @@ private:
 
     void init_pipeline_cache_();
 
+    void submit_handoff_();
+
+    void recycle_handoffs_();
+
+    Vlk_handoff acquire_handoff_();
+
+    VkSemaphore acquire_semaphore_();
+
     void fini_instance_();
 
     void fini_device_();
@@ -115,18 +181,41 @@ private:
 
     void fini_pipeline_cache_();
 
+    void fini_handoffs_();
+
+    void fini_desc_pools_();
+
 private:
     Platform_lib::Library library_;
     VkInstance instance_;
     VkPhysicalDevice physical_device_;
     uint32_t queue_family_index_;
+    uint32_t transfer_queue_family_index_;
     VkDevice device_;
     VkQueue queue_;
+    VkQueue transfer_queue_;
     VmaAllocator allocator_;
     VkCommandPool command_pool_;
     VkPipelineCache pipeline_cache_;
+    bool presentable_;
+    bool timeline_semaphore_;
+    bool desc_update_template_;
+    bool push_descriptor_;
+    bool multi_draw_indirect_;
     Lru_cache<Vlk_render_pass> render_pass_pool_;
     Lru_cache<Vlk_framebuffer> framebuffer_pool_;
+    std::unordered_map<uint64_t, std::unique_ptr<Vlk_set_layout>> set_layout_pool_;
+    std::mutex pool_mutex_;
+    std::mutex desc_pool_mutex_;
+    std::vector<VkDescriptorPool> desc_pools_;
+    std::vector<VkDescriptorPool> free_desc_pools_;
+    std::mutex queue_mutex_;
+    std::vector<VkBufferMemoryBarrier> pending_buffer_barriers_;
+    std::vector<VkImageMemoryBarrier> pending_image_barriers_;
+    std::vector<VkSemaphore> pending_semaphores_;
+    std::vector<VkSemaphore> free_semaphores_;
+    std::deque<Vlk_handoff> handoffs_;
+    std::vector<Vlk_handoff> free_handoffs_;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
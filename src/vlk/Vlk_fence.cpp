@@ -24,9 +24,9 @@ Vlk_fence::Vlk_fence(const Fence_desc& desc, Vlk_device* device) :
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Vlk_fence::wait_signal()
+bool Vlk_fence::wait_signal(uint64_t timeout)
 {
-    vkWaitForFences(device_->device(), 1, &fence_, VK_FALSE, UINT64_MAX);
+    return VK_SUCCESS == vkWaitForFences(device_->device(), 1, &fence_, VK_FALSE, timeout);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -21,7 +21,7 @@ class Vlk_fence final : public Fence {
 public:
     Vlk_fence(const Fence_desc& desc, Vlk_device* device);
 
-    void wait_signal() override;
+    bool wait_signal(uint64_t timeout = UINT64_MAX) override;
 
     void reset() override;
 
@@ -29,6 +29,21 @@ inline bool is_color_format(Format format)
 
 //----------------------------------------------------------------------------------------------------------------------
 
+inline auto is_storage_format(Format format)
+{
+    switch (format) {
+        case Format::rgba8_unorm:
+        case Format::r32_float:
+        case Format::rg32_float:
+        case Format::rgba32_float:
+            return true;
+        default:
+            return false;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 inline auto is_depth_stencil_format(Format format)
 {
     switch (format) {
@@ -107,6 +122,15 @@ void Vlk_image::init_image_and_alloc_()
         usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
     }
 
+    // a storage usage disables a framebuffer compression on some gpus, so it is only added on request.
+    if (storage_) {
+        if (!is_storage_format(format_) || Image_type::two_dim != type_ || 1 != samples_)
+            throw runtime_error("fail to create an image");
+
+        usage |= VK_IMAGE_USAGE_SAMPLED_BIT;
+        usage |= VK_IMAGE_USAGE_STORAGE_BIT;
+    }
+
     if (is_depth_stencil_format(format_))
         usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
 
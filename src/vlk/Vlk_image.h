@@ -66,6 +66,8 @@ private:
     friend class Vlk_swap_chain;
     friend class Vlk_render_encoder;
     friend class Vlk_blit_encoder;
+    friend class Vlk_compute_encoder;
+    friend class Vlk_cmd_list;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
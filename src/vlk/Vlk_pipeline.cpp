@@ -24,16 +24,45 @@ inline auto to_VkShaderStageFlags(uint32_t stages)
     VkShaderStageFlags flags {0};
 
     if (stages & etoi(Pipeline_stage::vertex_shader))
-        flags |= VK_PIPELINE_STAGE_VERTEX_SHADER_BIT;
+        flags |= VK_SHADER_STAGE_VERTEX_BIT;
 
     if (stages & etoi(Pipeline_stage::fragment_shader))
-        flags |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        flags |= VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    if (stages & etoi(Pipeline_stage::compute_shader))
+        flags |= VK_SHADER_STAGE_COMPUTE_BIT;
 
     return flags;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
+inline auto to_Vlk_set_layout_desc(const unordered_map<uint32_t, uint32_t>& args, VkDescriptorType type,
+                                   bool push_descriptor)
+{
+    Vlk_set_layout_desc desc;
+
+    desc.push_descriptor = push_descriptor;
+
+    for (auto& [index, stages] : args) {
+        VkDescriptorSetLayoutBinding binding {};
+
+        binding.binding = index;
+        binding.descriptorType = type;
+        binding.descriptorCount = 1;
+        binding.stageFlags = to_VkShaderStageFlags(stages);
+
+        desc.bindings.push_back(binding);
+    }
+
+    // set layouts are shared by bindings, so the order of bindings must be stable.
+    sort(desc.bindings.begin(), desc.bindings.end(), [](auto& lhs, auto& rhs) { return lhs.binding < rhs.binding; });
+
+    return desc;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 inline auto to_VkPipelineShaderStageCreateInfo(Shader* shader)
 {
     VkPipelineShaderStageCreateInfo create_info {};
@@ -92,16 +121,37 @@ namespace Gfx_lib {
 Vlk_pipeline::Vlk_pipeline(const Pipeline_desc& desc, Vlk_device* device) :
     Pipeline {desc},
     device_ {device},
+    buffer_ranges_ {},
+    set_layouts_ {},
+    push_constant_range_ {},
     pipeline_layout_ {VK_NULL_HANDLE},
     pipeline_ {VK_NULL_HANDLE}
 {
-    init_set_layouts_(desc.vertex_shader, desc.fragment_shader);
+    init_buffer_ranges_({desc.vertex_shader, desc.fragment_shader});
+    init_set_layouts_(VK_PIPELINE_BIND_POINT_GRAPHICS);
     init_pipeline_layout_();
     init_pipeline_(desc.vertex_shader, desc.fragment_shader);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
+Vlk_pipeline::Vlk_pipeline(const Compute_pipeline_desc& desc, Vlk_device* device) :
+    Pipeline {desc},
+    device_ {device},
+    buffer_ranges_ {},
+    set_layouts_ {},
+    push_constant_range_ {},
+    pipeline_layout_ {VK_NULL_HANDLE},
+    pipeline_ {VK_NULL_HANDLE}
+{
+    init_buffer_ranges_({desc.compute_shader});
+    init_set_layouts_(VK_PIPELINE_BIND_POINT_COMPUTE);
+    init_pipeline_layout_();
+    init_pipeline_(desc.compute_shader);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 Vlk_pipeline::~Vlk_pipeline()
 {
     fini_pipeline_();
@@ -117,58 +167,86 @@ Device* Vlk_pipeline::device() const
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Vlk_pipeline::init_set_layouts_(Shader* vertex_shader, Shader* fragment_shader)
+void Vlk_pipeline::init_buffer_ranges_(const std::vector<Shader*>& shaders)
 {
-    Vlk_set_layout_desc buffer_set_layout_desc;
-    auto& buffer_bindings = buffer_set_layout_desc.bindings;
+    // storage buffers aren't limited by a uniform buffer range, they keep a whole size.
+    buffer_ranges_.fill(VK_WHOLE_SIZE);
 
-    for (auto& [index, stages] : reflection_.buffers) {
-        VkDescriptorSetLayoutBinding binding {};
+    for (auto& [binding, stages] : reflection_.buffers) {
+        VkDeviceSize range {0};
 
-        binding.binding = index;
-        binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
-        binding.descriptorCount = 1;
-        binding.stageFlags = to_VkShaderStageFlags(stages);
+        // stages can declare a same binding with different blocks, a range covers the larger one.
+        for (auto shader : shaders) {
+            auto& block_sizes = static_cast<Vlk_shader*>(shader)->block_sizes();
+            auto iter = block_sizes.find(binding);
+
+            if (block_sizes.end() != iter)
+                range = max<VkDeviceSize>(range, iter->second);
+        }
 
-        buffer_bindings.emplace_back(binding);
+        if (buffer_ranges_.size() <= binding || !range)
+            throw runtime_error("fail to create a pipeline");
+
+        buffer_ranges_[binding] = range;
     }
+}
 
-    if (!buffer_bindings.empty())
-        set_layouts_[0] = make_unique<Vlk_set_layout>(buffer_set_layout_desc, device_);
+//----------------------------------------------------------------------------------------------------------------------
 
-    Vlk_set_layout_desc texture_set_layout_desc;
-    auto& texture_bindings = texture_set_layout_desc.bindings;
+void Vlk_pipeline::init_set_layouts_(VkPipelineBindPoint bind_point)
+{
+    // uniform buffers, textures, storage buffers and storage images are bound to the set 0, 1, 2 and 3.
+    const array<pair<const unordered_map<uint32_t, uint32_t>*, VkDescriptorType>, 4> sets {
+        make_pair(&reflection_.buffers, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC),
+        make_pair(&reflection_.textures, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER),
+        make_pair(&reflection_.storage_buffers, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC),
+        make_pair(&reflection_.storage_images, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE)
+    };
 
-    for (auto& [index, stages] : reflection_.textures) {
-        VkDescriptorSetLayoutBinding binding {};
+    // textures of a graphics pipeline change per draw, they are pushed instead of allocating a set.
+    auto push_descriptor = VK_PIPELINE_BIND_POINT_GRAPHICS == bind_point && device_->push_descriptor();
 
-        binding.binding = index;
-        binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        binding.descriptorCount = 1;
-        binding.stageFlags = to_VkShaderStageFlags(stages);
+    for (auto i = 0; i != sets.size(); ++i) {
+        auto& [args, type] = sets[i];
 
-        texture_bindings.push_back(binding);
+        if (!args->empty())
+            set_layouts_[i] = device_->set_layout(to_Vlk_set_layout_desc(*args, type, push_descriptor && 1 == i));
     }
-
-    if (!texture_bindings.empty())
-        set_layouts_[1] = make_unique<Vlk_set_layout>(texture_set_layout_desc, device_);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
 void Vlk_pipeline::init_pipeline_layout_()
 {
+    // find the number of sets, a pipeline layout can't have a hole.
+    auto set_count = 0;
+
+    for (auto i = 0; i != set_layouts_.size(); ++i) {
+        if (set_layouts_[i])
+            set_count = i + 1;
+    }
+
     std::vector<VkDescriptorSetLayout> desc_set_layouts;
 
-    for (auto& set_layout : set_layouts_) {
-        desc_set_layouts.push_back(set_layout->desc_set_layout());
+    for (auto i = 0; i != set_count; ++i) {
+        if (!set_layouts_[i])
+            set_layouts_[i] = device_->set_layout(Vlk_set_layout_desc {});
+
+        desc_set_layouts.push_back(set_layouts_[i]->desc_set_layout());
     }
 
+    // a push constant block is shared by stages, so there is only one range.
+    push_constant_range_.stageFlags = to_VkShaderStageFlags(reflection_.push_constants.stages);
+    push_constant_range_.offset = 0;
+    push_constant_range_.size = reflection_.push_constants.size;
+
     VkPipelineLayoutCreateInfo create_info {};
 
     create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
     create_info.setLayoutCount = static_cast<uint32_t>(desc_set_layouts.size());
-    create_info.pSetLayouts = &desc_set_layouts[0];
+    create_info.pSetLayouts = desc_set_layouts.data();
+    create_info.pushConstantRangeCount = push_constant_range_.size ? 1 : 0;
+    create_info.pPushConstantRanges = &push_constant_range_;
 
     if (vkCreatePipelineLayout(device_->device(), &create_info, nullptr, &pipeline_layout_))
         throw runtime_error("fail to create a pipeline.");
@@ -344,6 +422,22 @@ void Vlk_pipeline::init_pipeline_(Shader* vertex_shader, Shader* fragment_shader
 
 //----------------------------------------------------------------------------------------------------------------------
 
+void Vlk_pipeline::init_pipeline_(Shader* compute_shader)
+{
+    // configure a compute pipeline create info.
+    VkComputePipelineCreateInfo create_info {};
+
+    create_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    create_info.stage = to_VkPipelineShaderStageCreateInfo(compute_shader);
+    create_info.layout = pipeline_layout_;
+
+    // try to create a compute pipeline.
+    if (vkCreateComputePipelines(device_->device(), device_->pipeline_cache(), 1, &create_info, nullptr, &pipeline_))
+        throw runtime_error("fail to create a pipeline.");
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 void Vlk_pipeline::fini_pipeline_layout_()
 {
     vkDestroyPipelineLayout(device_->device(), pipeline_layout_, nullptr);
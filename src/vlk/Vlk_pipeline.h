@@ -21,7 +21,7 @@ class Vlk_set_layout;
 
 //----------------------------------------------------------------------------------------------------------------------
 
-using Vlk_set_layout_array = std::array<std::unique_ptr<Vlk_set_layout>, 2>;
+using Vlk_set_layout_array = std::array<Vlk_set_layout*, 4>;
 
 //----------------------------------------------------------------------------------------------------------------------
 
@@ -29,33 +29,47 @@ class Vlk_pipeline final : public Pipeline {
 public:
     Vlk_pipeline(const Pipeline_desc& desc, Vlk_device* device);
 
+    Vlk_pipeline(const Compute_pipeline_desc& desc, Vlk_device* device);
+
     ~Vlk_pipeline() override;
 
     Device* device() const override;
 
     inline auto set_layout(uint32_t index) const noexcept
-    { return set_layouts_[index].get(); }
+    { return set_layouts_[index]; }
 
     inline auto& pipeline_layout() const noexcept
     { return pipeline_layout_; }
 
+    inline auto buffer_range(uint32_t index) const noexcept
+    { return buffer_ranges_[index]; }
+
+    inline auto& push_constant_range() const noexcept
+    { return push_constant_range_; }
+
     inline auto& pipeline() const noexcept
     { return pipeline_; }
 
 private:
-    void init_set_layouts_(Shader* vertex_shader, Shader* fragment_shader);
+    void init_buffer_ranges_(const std::vector<Shader*>& shaders);
+
+    void init_set_layouts_(VkPipelineBindPoint bind_point);
 
     void init_pipeline_layout_();
 
     void init_pipeline_(Shader* vertex_shader, Shader* fragment_shader);
 
+    void init_pipeline_(Shader* compute_shader);
+
     void fini_pipeline_layout_();
 
     void fini_pipeline_();
 
 private:
     Vlk_device* device_;
+    std::array<VkDeviceSize, 16> buffer_ranges_;
     Vlk_set_layout_array set_layouts_;
+    VkPushConstantRange push_constant_range_;
     VkPipelineLayout pipeline_layout_;
     VkPipeline pipeline_;
 };
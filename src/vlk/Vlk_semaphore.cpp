@@ -0,0 +1,62 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "std_lib.h"
+#include "vlk_lib.h"
+#include "Vlk_semaphore.h"
+#include "Vlk_device.h"
+
+using namespace std;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Vlk_semaphore::Vlk_semaphore(const Semaphore_desc& desc, Vlk_device* device) :
+    Semaphore {},
+    device_ {device},
+    semaphore_ {VK_NULL_HANDLE}
+{
+    init_semaphore_();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Vlk_semaphore::~Vlk_semaphore()
+{
+    fini_semaphore_();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Device* Vlk_semaphore::device() const
+{
+    return device_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_semaphore::init_semaphore_()
+{
+    // configure a semaphore create info.
+    VkSemaphoreCreateInfo create_info {};
+
+    create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    // try to create a semaphore.
+    if (vkCreateSemaphore(device_->device(), &create_info, nullptr, &semaphore_))
+        throw runtime_error("fail to create a semaphore");
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_semaphore::fini_semaphore_()
+{
+    vkDestroySemaphore(device_->device(), semaphore_, nullptr);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
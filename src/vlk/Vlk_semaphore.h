@@ -0,0 +1,45 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_VLK_SEMAPHORE_GUARD
+#define GFX_VLK_SEMAPHORE_GUARD
+
+#include <vulkan/vulkan.h>
+#include "gfx/Semaphore.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Vlk_device;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Vlk_semaphore final : public Semaphore {
+public:
+    Vlk_semaphore(const Semaphore_desc& desc, Vlk_device* device);
+
+    ~Vlk_semaphore() override;
+
+    Device* device() const override;
+
+    inline auto& semaphore() const noexcept
+    { return semaphore_; }
+
+private:
+    void init_semaphore_();
+
+    void fini_semaphore_();
+
+private:
+    Vlk_device* device_;
+    VkSemaphore semaphore_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_VLK_SEMAPHORE_GUARD
@@ -15,23 +15,56 @@ namespace {
 
 //----------------------------------------------------------------------------------------------------------------------
 
-constexpr auto max_set_count = 1024;
+inline auto is_buffer(VkDescriptorType type) noexcept
+{
+    return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC == type || VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC == type;
+}
 
 //----------------------------------------------------------------------------------------------------------------------
 
-inline vector<VkDescriptorPoolSize> to_pool_sizes(const Vlk_set_layout_desc& desc)
+inline auto is_bound(const VkDescriptorSetLayoutBinding& binding, const Vlk_desc_info& info) noexcept
 {
-    unordered_map<VkDescriptorType, uint32_t> counts;
+    if (is_buffer(binding.descriptorType))
+        return VK_NULL_HANDLE != info.buffer.buffer;
+
+    if (VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER == binding.descriptorType)
+        return VK_NULL_HANDLE != info.image.imageView && VK_NULL_HANDLE != info.image.sampler;
+
+    return VK_NULL_HANDLE != info.image.imageView;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
 
-    for (auto& binding : desc.bindings)
-        ++counts[binding.descriptorType];
+using Write_desc_set_array = array<VkWriteDescriptorSet, tuple_size_v<Vlk_desc_info_array>>;
 
-    vector<VkDescriptorPoolSize> pool_sizes;
+//----------------------------------------------------------------------------------------------------------------------
 
-    for (auto& [type, count] : counts)
-        pool_sizes.push_back({type, count * max_set_count});
+inline uint32_t to_write_desc_sets(const vector<VkDescriptorSetLayoutBinding>& bindings, VkDescriptorSet desc_set,
+                                   const Vlk_desc_info_array& infos, Write_desc_set_array& write_desc_sets)
+{
+    uint32_t write_desc_set_count = 0;
+
+    for (auto& binding : bindings) {
+        // a null descriptor is invalid without the null descriptor feature, so an unbound slot is skipped.
+        if (!is_bound(binding, infos[binding.binding]))
+            continue;
+
+        auto& write_desc_set = write_desc_sets[write_desc_set_count++];
+
+        write_desc_set = {};
+        write_desc_set.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write_desc_set.dstSet = desc_set;
+        write_desc_set.dstBinding = binding.binding;
+        write_desc_set.descriptorCount = 1;
+        write_desc_set.descriptorType = binding.descriptorType;
+
+        if (is_buffer(binding.descriptorType))
+            write_desc_set.pBufferInfo = &infos[binding.binding].buffer;
+        else
+            write_desc_set.pImageInfo = &infos[binding.binding].image;
+    }
 
-    return pool_sizes;
+    return write_desc_set_count;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -44,54 +77,72 @@ namespace Gfx_lib {
 
 Vlk_set_layout::Vlk_set_layout(const Vlk_set_layout_desc& desc, Vlk_device* device) :
     device_ {device},
+    bindings_ {desc.bindings},
+    push_descriptor_ {desc.push_descriptor},
     desc_set_layout_ {VK_NULL_HANDLE},
-    desc_pool_ {VK_NULL_HANDLE},
-    desc_sets_ {max_set_count},
-    desc_set_index_ {0}
+    update_template_ {VK_NULL_HANDLE}
 {
-    init_desc_set_layout_(desc);
-    init_desc_pool_(desc);
+    init_desc_set_layout_();
+    init_update_template_();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
 Vlk_set_layout::~Vlk_set_layout()
 {
+    fini_update_template_();
     fini_desc_set_layout_();
-    fini_desc_pool_();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-VkDescriptorSet Vlk_set_layout::desc_set()
+void Vlk_set_layout::update(VkDescriptorSet desc_set, const Vlk_desc_info_array& infos) const
 {
-    auto& desc_set = desc_sets_[desc_set_index_];
+    auto bound = [&infos](auto& binding) {
+        return is_bound(binding, infos[binding.binding]);
+    };
+
+    // a template reads infos at the offset of each binding, so it is only used when every binding is bound.
+    if (update_template_ && all_of(bindings_.begin(), bindings_.end(), bound)) {
+        vkUpdateDescriptorSetWithTemplateKHR(device_->device(), desc_set, update_template_, infos.data());
+        return;
+    }
 
-    if (!desc_set) {
-        VkDescriptorSetAllocateInfo alloc_info {};
+    Write_desc_set_array write_desc_sets;
+    auto write_desc_set_count = to_write_desc_sets(bindings_, desc_set, infos, write_desc_sets);
 
-        alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        alloc_info.descriptorPool = desc_pool_;
-        alloc_info.descriptorSetCount = 1;
-        alloc_info.pSetLayouts = &desc_set_layout_;
+    vkUpdateDescriptorSets(device_->device(), write_desc_set_count, write_desc_sets.data(), 0, nullptr);
+}
 
-        vkAllocateDescriptorSets(device_->device(), &alloc_info, &desc_set);
-    }
+//----------------------------------------------------------------------------------------------------------------------
 
-    desc_set_index_ = ++desc_set_index_ % max_set_count;
+void Vlk_set_layout::push(VkCommandBuffer command_buffer, VkPipelineBindPoint bind_point,
+                          VkPipelineLayout pipeline_layout, uint32_t set, const Vlk_desc_info_array& infos) const
+{
+    // descriptors are written into a command buffer, there is no set to allocate.
+    Write_desc_set_array write_desc_sets;
+    auto write_desc_set_count = to_write_desc_sets(bindings_, VK_NULL_HANDLE, infos, write_desc_sets);
 
-    return desc_set;
+    vkCmdPushDescriptorSetKHR(command_buffer, bind_point, pipeline_layout, set,
+                              write_desc_set_count, write_desc_sets.data());
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Vlk_set_layout::init_desc_set_layout_(const Vlk_set_layout_desc& desc)
+void Vlk_set_layout::init_desc_set_layout_()
 {
+    // infos of a set are indexed by bindings.
+    for (auto& binding : bindings_) {
+        if (binding.binding >= tuple_size_v<Vlk_desc_info_array>)
+            throw runtime_error("fail to create a set layout");
+    }
+
     VkDescriptorSetLayoutCreateInfo create_info {};
 
     create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-    create_info.bindingCount = static_cast<uint32_t>(desc.bindings.size());
-    create_info.pBindings = &desc.bindings[0];
+    create_info.flags = push_descriptor_ ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR : 0;
+    create_info.bindingCount = static_cast<uint32_t>(bindings_.size());
+    create_info.pBindings = bindings_.data();
 
     if (vkCreateDescriptorSetLayout(device_->device(), &create_info, nullptr, &desc_set_layout_))
         throw runtime_error("");
@@ -99,19 +150,38 @@ void Vlk_set_layout::init_desc_set_layout_(const Vlk_set_layout_desc& desc)
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Vlk_set_layout::init_desc_pool_(const Vlk_set_layout_desc& desc)
+void Vlk_set_layout::init_update_template_()
 {
-    auto pool_sizes = to_pool_sizes(desc);
+    // a push layout is never used to update a set.
+    if (bindings_.empty() || push_descriptor_ || !device_->desc_update_template())
+        return;
 
-    VkDescriptorPoolCreateInfo create_info {};
+    // configure template entries, an info of a binding is placed at the binding index.
+    vector<VkDescriptorUpdateTemplateEntryKHR> entries;
 
-    create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-    create_info.maxSets = max_set_count;
-    create_info.poolSizeCount = static_cast<uint32_t>(pool_sizes.size());
-    create_info.pPoolSizes = &pool_sizes[0];
+    for (auto& binding : bindings_) {
+        VkDescriptorUpdateTemplateEntryKHR entry {};
 
-    if (vkCreateDescriptorPool(device_->device(), &create_info, nullptr, &desc_pool_))
-        throw runtime_error("");
+        entry.dstBinding = binding.binding;
+        entry.dstArrayElement = 0;
+        entry.descriptorCount = 1;
+        entry.descriptorType = binding.descriptorType;
+        entry.offset = binding.binding * sizeof(Vlk_desc_info);
+        entry.stride = sizeof(Vlk_desc_info);
+
+        entries.push_back(entry);
+    }
+
+    VkDescriptorUpdateTemplateCreateInfoKHR create_info {};
+
+    create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO_KHR;
+    create_info.descriptorUpdateEntryCount = static_cast<uint32_t>(entries.size());
+    create_info.pDescriptorUpdateEntries = entries.data();
+    create_info.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET_KHR;
+    create_info.descriptorSetLayout = desc_set_layout_;
+
+    if (vkCreateDescriptorUpdateTemplateKHR(device_->device(), &create_info, nullptr, &update_template_))
+        throw runtime_error("fail to create a set layout");
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -123,9 +193,10 @@ void Vlk_set_layout::fini_desc_set_layout_()
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void Vlk_set_layout::fini_desc_pool_()
+void Vlk_set_layout::fini_update_template_()
 {
-    vkDestroyDescriptorPool(device_->device(), desc_pool_, nullptr);
+    if (update_template_)
+        vkDestroyDescriptorUpdateTemplateKHR(device_->device(), update_template_, nullptr);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -6,6 +6,7 @@
 #ifndef GFX_VLK_SET_LAYOUT_GUARD
 #define GFX_VLK_SET_LAYOUT_GUARD
 
+#include <array>
 #include <vector>
 #include <vulkan/vulkan.h>
 #include "enums.h"
@@ -20,10 +21,22 @@ class Vlk_device;
 
 struct Vlk_set_layout_desc {
     std::vector<VkDescriptorSetLayoutBinding> bindings;
+    bool push_descriptor {false};
 };
 
 //----------------------------------------------------------------------------------------------------------------------
 
+union Vlk_desc_info {
+    VkDescriptorBufferInfo buffer;
+    VkDescriptorImageInfo image;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+using Vlk_desc_info_array = std::array<Vlk_desc_info, 16>;
+
+//----------------------------------------------------------------------------------------------------------------------
+
 class Vlk_set_layout final {
 public:
     Vlk_set_layout(const Vlk_set_layout_desc& desc, Vlk_device* device);
@@ -33,23 +46,35 @@ public:
     inline auto& desc_set_layout() const noexcept
     { return desc_set_layout_; }
 
-    VkDescriptorSet desc_set();
+    inline auto& bindings() const noexcept
+    { return bindings_; }
+
+    inline auto empty() const noexcept
+    { return bindings_.empty(); }
+
+    inline auto push_descriptor() const noexcept
+    { return push_descriptor_; }
+
+    void update(VkDescriptorSet desc_set, const Vlk_desc_info_array& infos) const;
+
+    void push(VkCommandBuffer command_buffer, VkPipelineBindPoint bind_point, VkPipelineLayout pipeline_layout,
+              uint32_t set, const Vlk_desc_info_array& infos) const;
 
 private:
-    void init_desc_set_layout_(const Vlk_set_layout_desc& desc);
+    void init_desc_set_layout_();
 
-    void init_desc_pool_(const Vlk_set_layout_desc& desc);
+    void init_update_template_();
 
     void fini_desc_set_layout_();
 
-    void fini_desc_pool_();
+    void fini_update_template_();
 
 private:
     Vlk_device* device_;
+    std::vector<VkDescriptorSetLayoutBinding> bindings_;
+    bool push_descriptor_;
     VkDescriptorSetLayout desc_set_layout_;
-    VkDescriptorPool desc_pool_;
-    std::vector<VkDescriptorSet> desc_sets_;
-    uint64_t desc_set_index_;
+    VkDescriptorUpdateTemplateKHR update_template_;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
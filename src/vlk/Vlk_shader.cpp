@@ -5,6 +5,7 @@
 
 #include "std_lib.h"
 #include "vlk_lib.h"
+#include "spirv_lib.h"
 #include "Vlk_shader.h"
 #include "Vlk_device.h"
 
@@ -19,6 +20,7 @@ Vlk_shader::Vlk_shader(const Shader_desc& desc, Vlk_device* device) :
     Shader {desc},
     device_ {device},
     signature_ {},
+    block_sizes_ {},
     shader_module_ {VK_NULL_HANDLE}
 {
     init_signature_(desc.src);
@@ -51,6 +53,9 @@ Sc_lib::Signature Vlk_shader::reflect() const noexcept
 void Vlk_shader::init_signature_(const std::vector<uint32_t>& src)
 {
     signature_ = Spirv_reflector().reflect(src);
+
+    // a descriptor of a dynamic uniform buffer covers a block only, a whole buffer exceeds a range at an offset.
+    block_sizes_ = reflect_uniform_block_sizes(src);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
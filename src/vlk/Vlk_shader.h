@@ -6,6 +6,7 @@
 #ifndef GFX_VLK_SHADER_GUARD
 #define GFX_VLK_SHADER_GUARD
 
+#include <unordered_map>
 #include <vulkan/vulkan.h>
 #include "Shader.h"
 
@@ -30,6 +31,9 @@ public:
     inline auto shader_module() const noexcept
     { return shader_module_; }
 
+    inline auto& block_sizes() const noexcept
+    { return block_sizes_; }
+
 private:
     void init_signature_(const std::vector<uint32_t>& src);
 
@@ -40,6 +44,7 @@ private:
 private:
     Vlk_device* device_;
     Sc_lib::Signature signature_;
+    std::unordered_map<uint32_t, uint32_t> block_sizes_;
     VkShaderModule shader_module_;
 };
 
@@ -116,6 +116,9 @@ void Vlk_swap_chain::present()
     submit_info.signalSemaphoreCount = 1;
     submit_info.pSignalSemaphores = &cur_submit_semaphore_();
 
+    // a queue is shared with submits of other threads, so they are serialized by a lock of a device.
+    lock_guard<mutex> lock {device_->queue_mutex()};
+
     // submit a command buffer.
     vkQueueSubmit(device_->queue(), 1, &submit_info, cur_submit_fence_()->fence());
 
@@ -290,7 +293,7 @@ void Vlk_swap_chain::init_cmd_buffers_()
 {
     // try to create command buffers.
     for (auto& cmd_buffer : cmd_buffers_)
-        cmd_buffer = make_unique<Vlk_cmd_buffer>(device_);
+        cmd_buffer = make_unique<Vlk_cmd_buffer>(Cmd_buffer_desc {}, device_);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,113 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#include "std_lib.h"
+#include "vlk_lib.h"
+#include "Vlk_timeline.h"
+#include "Vlk_device.h"
+
+using namespace std;
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Vlk_timeline::Vlk_timeline(const Timeline_desc& desc, Vlk_device* device) :
+    Timeline {},
+    device_ {device},
+    semaphore_ {VK_NULL_HANDLE}
+{
+    init_semaphore_(desc.value);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Vlk_timeline::~Vlk_timeline()
+{
+    fini_semaphore_();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+bool Vlk_timeline::wait(uint64_t value, uint64_t timeout)
+{
+    // configure a semaphore wait info.
+    VkSemaphoreWaitInfoKHR wait_info {};
+
+    wait_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+    wait_info.semaphoreCount = 1;
+    wait_info.pSemaphores = &semaphore_;
+    wait_info.pValues = &value;
+
+    return VK_SUCCESS == vkWaitSemaphoresKHR(device_->device(), &wait_info, timeout);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_timeline::signal(uint64_t value)
+{
+    // configure a semaphore signal info.
+    VkSemaphoreSignalInfoKHR signal_info {};
+
+    signal_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO_KHR;
+    signal_info.semaphore = semaphore_;
+    signal_info.value = value;
+
+    vkSignalSemaphoreKHR(device_->device(), &signal_info);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Device* Vlk_timeline::device() const
+{
+    return device_;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+uint64_t Vlk_timeline::value() const
+{
+    uint64_t value {0};
+
+    vkGetSemaphoreCounterValueKHR(device_->device(), semaphore_, &value);
+
+    return value;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_timeline::init_semaphore_(uint64_t value)
+{
+    if (!device_->timeline_semaphore())
+        throw runtime_error("fail to create a timeline");
+
+    // configure a semaphore type create info.
+    VkSemaphoreTypeCreateInfoKHR type_create_info {};
+
+    type_create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+    type_create_info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+    type_create_info.initialValue = value;
+
+    // configure a semaphore create info.
+    VkSemaphoreCreateInfo create_info {};
+
+    create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    create_info.pNext = &type_create_info;
+
+    // try to create a semaphore.
+    if (vkCreateSemaphore(device_->device(), &create_info, nullptr, &semaphore_))
+        throw runtime_error("fail to create a timeline");
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Vlk_timeline::fini_semaphore_()
+{
+    vkDestroySemaphore(device_->device(), semaphore_, nullptr);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
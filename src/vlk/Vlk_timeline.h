@@ -0,0 +1,51 @@
+//
+// This file is part of the "gfx" project
+// See "LICENSE" for license information.
+//
+
+#ifndef GFX_VLK_TIMELINE_GUARD
+#define GFX_VLK_TIMELINE_GUARD
+
+#include <vulkan/vulkan.h>
+#include "gfx/Timeline.h"
+
+namespace Gfx_lib {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Vlk_device;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class Vlk_timeline final : public Timeline {
+public:
+    Vlk_timeline(const Timeline_desc& desc, Vlk_device* device);
+
+    ~Vlk_timeline() override;
+
+    bool wait(uint64_t value, uint64_t timeout = UINT64_MAX) override;
+
+    void signal(uint64_t value) override;
+
+    Device* device() const override;
+
+    uint64_t value() const override;
+
+    inline auto semaphore() const noexcept
+    { return semaphore_; }
+
+private:
+    void init_semaphore_(uint64_t value);
+
+    void fini_semaphore_();
+
+private:
+    Vlk_device* device_;
+    VkSemaphore semaphore_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+} // of namespace Gfx_lib
+
+#endif // GFX_VLK_TIMELINE_GUARD
@@ -210,6 +210,19 @@
     macro(vkAcquireNextImageKHR) \
     macro(vkQueuePresentKHR)
 
+#define APPLY_VLK_DEVICE_TIMELINE_SEMAPHORE_SYMBOLS(macro) \
+    macro(vkGetSemaphoreCounterValueKHR) \
+    macro(vkWaitSemaphoresKHR) \
+    macro(vkSignalSemaphoreKHR)
+
+#define APPLY_VLK_DEVICE_DESC_UPDATE_TEMPLATE_SYMBOLS(macro) \
+    macro(vkCreateDescriptorUpdateTemplateKHR) \
+    macro(vkDestroyDescriptorUpdateTemplateKHR) \
+    macro(vkUpdateDescriptorSetWithTemplateKHR)
+
+#define APPLY_VLK_DEVICE_PUSH_DESCRIPTOR_SYMBOLS(macro) \
+    macro(vkCmdPushDescriptorSetKHR)
+
 #define DECLARE_VLK_SYMBOL(name) extern PFN_##name name;
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -227,6 +240,9 @@ APPLY_VLK_INSTANCE_OSX_SURFACE_SYMBOLS(DECLARE_VLK_SYMBOL)
 APPLY_VLK_INSTANCE_DEBUG_REPORT_SYMBOLS(DECLARE_VLK_SYMBOL)
 APPLY_VLK_DEVICE_CORE_SYMBOLS(DECLARE_VLK_SYMBOL)
 APPLY_VLK_DEVICE_SWAPCHAIN_SYMBOLS(DECLARE_VLK_SYMBOL)
+APPLY_VLK_DEVICE_TIMELINE_SEMAPHORE_SYMBOLS(DECLARE_VLK_SYMBOL)
+APPLY_VLK_DEVICE_DESC_UPDATE_TEMPLATE_SYMBOLS(DECLARE_VLK_SYMBOL)
+APPLY_VLK_DEVICE_PUSH_DESCRIPTOR_SYMBOLS(DECLARE_VLK_SYMBOL)
 
 //----------------------------------------------------------------------------------------------------------------------
 
@@ -392,6 +408,8 @@ inline VkShaderStageFlagBits to_VkShaderStageFlagBits(Sc_lib::Shader_type type)
             return VK_SHADER_STAGE_VERTEX_BIT;
         case Sc_lib::Shader_type ::fragment:
             return VK_SHADER_STAGE_FRAGMENT_BIT;
+        case Sc_lib::Shader_type::compute:
+            return VK_SHADER_STAGE_COMPUTE_BIT;
         default:
             throw std::runtime_error("invalid the shader type");
     }